@@ -127,3 +127,72 @@ static void BM_Analyzer_SpectrumAnalyzerGetMagnitudes(benchmark::State& state) {
 	}
 }
 BENCHMARK(BM_Analyzer_SpectrumAnalyzerGetMagnitudes);
+
+static void BM_Analyzer_SpectrumAnalyzerStep32768Overlap8(benchmark::State& state) {
+	SpectrumAnalyzer sa(
+		SpectrumAnalyzer::SIZE_32768,
+		SpectrumAnalyzer::OVERLAP_8,
+		SpectrumAnalyzer::WINDOW_KAISER,
+		192000.0,
+		false
+	);
+	float in[8] = { 0.0, 0.7, 1.0, 0.7, 0.0, -0.7, -1.0, -0.7 };
+	int i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(sa.step(in[i]));
+		++i;
+		i %= 8;
+	}
+}
+BENCHMARK(BM_Analyzer_SpectrumAnalyzerStep32768Overlap8);
+
+static void BM_Analyzer_SpectrumAnalyzerGetMagnitudes32768(benchmark::State& state) {
+	SpectrumAnalyzer sa(
+		SpectrumAnalyzer::SIZE_32768,
+		SpectrumAnalyzer::OVERLAP_1,
+		SpectrumAnalyzer::WINDOW_KAISER,
+		192000.0
+	);
+	const int nBins = 16384;
+	float* bins = new float[nBins];
+	float in[8] = { 0.0, 0.7, 1.0, 0.7, 0.0, -0.7, -1.0, -0.7 };
+	for (int i = 0; i < 32768; ++i) {
+		sa.step(in[i % 8]);
+	}
+
+	for (auto _ : state) {
+		sa.getMagnitudes(bins, nBins);
+		benchmark::DoNotOptimize(bins[0]);
+	}
+	delete[] bins;
+}
+BENCHMARK(BM_Analyzer_SpectrumAnalyzerGetMagnitudes32768);
+
+static void BM_Analyzer_AveragingBufferCommit(benchmark::State& state) {
+	const int n = 16384;
+	AveragingBuffer<float> averages(n, 3);
+	float x = 0.0f;
+	for (auto _ : state) {
+		float* frame = averages.getInputFrame();
+		std::fill_n(frame, n, x += 0.1f);
+		averages.commitInputFrame();
+		benchmark::DoNotOptimize(averages.getAverages()[0]);
+	}
+}
+BENCHMARK(BM_Analyzer_AveragingBufferCommit);
+
+static void BM_Analyzer_SweepDeconvolver16384(benchmark::State& state) {
+	const int n = 16384;
+	SweepDeconvolver d;
+	d.setParams(48000.0f, 20.0f, 20000.0f, n, 5.0f);
+	float* response = new float[d.responseSamples()];
+	for (int i = 0; i < d.responseSamples(); ++i) {
+		response[i] = i < n ? 5.0f * sinf(0.01f * i) : 0.0f;
+	}
+	for (auto _ : state) {
+		d.analyze(response);
+		benchmark::DoNotOptimize(d._magnitudes[100]);
+	}
+	delete[] response;
+}
+BENCHMARK(BM_Analyzer_SweepDeconvolver16384);
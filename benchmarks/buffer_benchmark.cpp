@@ -2,6 +2,7 @@
 #include <benchmark/benchmark.h>
 
 #include "dsp/buffer.hpp"
+#include "dsp/signal.hpp"
 
 using namespace bogaudio::dsp;
 
@@ -46,3 +47,184 @@ static void BM_Buffer_AveragingBufferLargeN(benchmark::State& state) {
 	_averagingBuffer(state, 1024, 100);
 }
 BENCHMARK(BM_Buffer_AveragingBufferLargeN);
+
+
+// The modulo-indexed circular buffers DelayLine, RunningAverage and
+// HistoryBuffer used before they were rebuilt on RingBuffer, for comparison.
+struct ModuloDelayLine {
+	int _bufferN;
+	float* _buffer;
+	int _leadI = 0;
+	int _trailI;
+
+	ModuloDelayLine(int bufferN, int delaySamples)
+	: _bufferN(bufferN)
+	, _buffer(new float[bufferN] {})
+	, _trailI(bufferN - delaySamples)
+	{
+	}
+	~ModuloDelayLine() {
+		delete[] _buffer;
+	}
+
+	float next(float sample) {
+		float delayed = _buffer[_trailI];
+		++_trailI;
+		_trailI %= _bufferN;
+		_buffer[_leadI] = sample;
+		++_leadI;
+		_leadI %= _bufferN;
+		return delayed;
+	}
+};
+
+struct ModuloRunningAverage {
+	int _bufferN;
+	float* _buffer;
+	int _sumN;
+	float _invSumN;
+	int _leadI = 0;
+	int _trailI;
+	double _sum = 0.0;
+
+	ModuloRunningAverage(int bufferN, int sumN)
+	: _bufferN(bufferN)
+	, _buffer(new float[bufferN] {})
+	, _sumN(sumN)
+	, _invSumN(1.0f / (float)sumN)
+	, _trailI(bufferN - sumN)
+	{
+	}
+	~ModuloRunningAverage() {
+		delete[] _buffer;
+	}
+
+	float next(float sample) {
+		_sum -= _buffer[_trailI];
+		++_trailI;
+		_trailI %= _bufferN;
+		_sum += _buffer[_leadI] = sample;
+		++_leadI;
+		_leadI %= _bufferN;
+		return (float)_sum * _invSumN;
+	}
+};
+
+struct ModuloHistoryBuffer {
+	int _size;
+	int _i = 0;
+	float* _buf;
+
+	ModuloHistoryBuffer(int size) : _size(size), _buf(new float[size] {}) {}
+	~ModuloHistoryBuffer() {
+		delete[] _buf;
+	}
+
+	void push(float s) {
+		++_i;
+		_i %= _size;
+		_buf[_i] = s;
+	}
+
+	float value(int i) {
+		int j = _i - i;
+		if (j < 0) {
+			j += _size;
+		}
+		return _buf[j];
+	}
+};
+
+static void BM_Buffer_DelayLineModulo(benchmark::State& state) {
+	ModuloDelayLine d(44100, 22050);
+	float s = 0.0f;
+	for (auto _ : state) {
+		s = d.next(s + 1.0f);
+	}
+	benchmark::DoNotOptimize(s);
+}
+BENCHMARK(BM_Buffer_DelayLineModulo);
+
+static void BM_Buffer_DelayLine(benchmark::State& state) {
+	DelayLine d(44100.0f, 1000.0f, 0.5f);
+	float s = 0.0f;
+	for (auto _ : state) {
+		s = d.next(s + 1.0f);
+	}
+	benchmark::DoNotOptimize(s);
+}
+BENCHMARK(BM_Buffer_DelayLine);
+
+static void BM_Buffer_RunningAverageModulo(benchmark::State& state) {
+	ModuloRunningAverage a(13230, 6615);
+	float s = 0.0f;
+	for (auto _ : state) {
+		s = a.next(s + 1.0f);
+	}
+	benchmark::DoNotOptimize(s);
+}
+BENCHMARK(BM_Buffer_RunningAverageModulo);
+
+static void BM_Buffer_RunningAverage(benchmark::State& state) {
+	RunningAverage a(44100.0f, 0.5f, 300.0f);
+	float s = 0.0f;
+	for (auto _ : state) {
+		s = a.next(s + 1.0f);
+	}
+	benchmark::DoNotOptimize(s);
+}
+BENCHMARK(BM_Buffer_RunningAverage);
+
+static void BM_Buffer_HistoryBufferModulo(benchmark::State& state) {
+	ModuloHistoryBuffer b(1000);
+	float s = 0.0f;
+	int i = 0;
+	for (auto _ : state) {
+		b.push(s);
+		s += b.value(i = (i + 7) % 1000);
+	}
+	benchmark::DoNotOptimize(s);
+}
+BENCHMARK(BM_Buffer_HistoryBufferModulo);
+
+static void BM_Buffer_HistoryBuffer(benchmark::State& state) {
+	HistoryBuffer<float> b(1000, 0.0f);
+	float s = 0.0f;
+	int i = 0;
+	for (auto _ : state) {
+		b.push(s);
+		s += b.value(i = (i + 7) % 1000);
+	}
+	benchmark::DoNotOptimize(s);
+}
+BENCHMARK(BM_Buffer_HistoryBuffer);
+
+static void BM_Buffer_RingBufferBlock(benchmark::State& state) {
+	const int n = 64;
+	RingBuffer<float> b(44100);
+	float in[n] {};
+	float out[n];
+	for (auto _ : state) {
+		b.write(in, n);
+		b.read(out, n, 22050);
+		in[0] = out[n - 1] + 1.0f;
+	}
+	benchmark::DoNotOptimize(out);
+}
+BENCHMARK(BM_Buffer_RingBufferBlock);
+
+static void BM_Buffer_RingBufferInterpolated(benchmark::State& state) {
+	RingBuffer<float> b(44100);
+	float s = 0.0f;
+	float delay = 100.0f;
+	for (auto _ : state) {
+		b.push(s);
+		delay += 0.37f;
+		if (delay > 40000.0f) {
+			delay = 100.0f;
+		}
+		s = b.value(delay) + 1.0f;
+	}
+	benchmark::DoNotOptimize(s);
+}
+BENCHMARK(BM_Buffer_RingBufferInterpolated);
@@ -0,0 +1,69 @@
+
+#include <benchmark/benchmark.h>
+
+#include "dsp/dynamics.hpp"
+#include "dsp/filters/utility.hpp"
+#include "dsp/noise.hpp"
+#include "dsp/signal.hpp"
+
+using namespace bogaudio::dsp;
+
+static void BM_Dynamics_ScalarChain16(benchmark::State& state) {
+	const int channels = 16;
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 5.0f * r.next();
+	}
+	RootMeanSquare rms[channels];
+	SlewLimiter attack[channels];
+	SlewLimiter release[channels];
+	float last[channels] {};
+	Compressor compressor;
+	Amplifier amplifier[channels];
+	Saturator saturator;
+	for (int c = 0; c < channels; ++c) {
+		rms[c].setSampleRate(44100.0f);
+		attack[c].setParams(44100.0f, 150.0f);
+		release[c].setParams(44100.0f, 600.0f);
+	}
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		for (int c = 0; c < channels; ++c) {
+			float env = rms[c].next(buf[i]);
+			env = env > last[c] ? attack[c].next(env, last[c]) : release[c].next(env, last[c]);
+			last[c] = env;
+			amplifier[c].setLevel(-compressor.compressionDb(amplitudeToDecibels(env / 5.0f), -12.0f, 4.0f, true));
+			benchmark::DoNotOptimize(saturator.next(amplifier[c].next(buf[i])));
+		}
+	}
+}
+BENCHMARK(BM_Dynamics_ScalarChain16);
+
+static void BM_Dynamics_DynamicsProcessor16(benchmark::State& state) {
+	const int channels = 16;
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 5.0f * r.next();
+	}
+	DynamicsProcessor dynamics(300.0f, 44100.0f);
+	Saturator saturator;
+	for (int c = 0; c < channels; ++c) {
+		dynamics.setThreshold(c, -12.0f);
+		dynamics.setRatio(c, 4.0f);
+		dynamics.setAttackRelease(c, 150.0f, 600.0f);
+	}
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		lanes_t in = buf[i];
+		for (int g = 0; g < laneGroups(channels); ++g) {
+			benchmark::DoNotOptimize(saturator.next(dynamics.next(g, in) * in));
+		}
+	}
+}
+BENCHMARK(BM_Dynamics_DynamicsProcessor16);
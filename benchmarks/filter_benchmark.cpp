@@ -70,6 +70,43 @@ static void BM_Filter_Biquad(benchmark::State& state) {
 }
 BENCHMARK(BM_Filter_Biquad);
 
+static void BM_Filter_StateVariableFilter(benchmark::State& state) {
+	WhiteNoiseGenerator r;
+	const int n = 8;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = r.next();
+	}
+
+	StateVariableFilter f(44100.0f, 100.0f);
+	int i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(f.next(buf[i]));
+		i = (i + 1) % n;
+	}
+}
+BENCHMARK(BM_Filter_StateVariableFilter);
+
+static void BM_Filter_LowPassFilterLanes(benchmark::State& state) {
+	WhiteNoiseGenerator r;
+	const int n = 8;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = r.next();
+	}
+
+	LowPassFilterLanes f;
+	for (int l = 0; l < laneWidth; ++l) {
+		f.setParams(l, 44100.0f, 100.0f * (l + 1));
+	}
+	int i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(f.next(buf[i]));
+		i = (i + 1) % n;
+	}
+}
+BENCHMARK(BM_Filter_LowPassFilterLanes);
+
 static void BM_Filter_AnalogFrequency(benchmark::State& state) {
 	WhiteNoiseGenerator r;
 	const int n = 128;
@@ -279,3 +316,78 @@ static void BM_Filter_PucketteEnvelopeFollower(benchmark::State& state) {
 	}
 }
 BENCHMARK(BM_Filter_PucketteEnvelopeFollower);
+
+static void BM_Filter_VocoderBandsScalar16(benchmark::State& state) {
+	const int channels = 16;
+	const int bands = 14;
+	WhiteNoiseGenerator r;
+	const int n = 128;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 5.0f * r.next();
+	}
+
+	MultimodeFilter4* filters = new MultimodeFilter4[channels * bands];
+	EnvelopeFollower* efs = new EnvelopeFollower[channels * bands];
+	for (int c = 0; c < channels; ++c) {
+		for (int b = 0; b < bands; ++b) {
+			filters[c * bands + b].setParams(44100.0f, MultimodeFilter::BUTTERWORTH_TYPE, 4, MultimodeFilter::BANDPASS_MODE, 100.0f * (b + 1), 0.3f);
+			efs[c * bands + b].setParams(44100.0f, 0.3f);
+		}
+	}
+	int i = 0;
+	for (auto _ : state) {
+		for (int c = 0; c < channels; ++c) {
+			float out = 0.0f;
+			for (int b = 0; b < bands; ++b) {
+				out += efs[c * bands + b].next(buf[i]) * filters[c * bands + b].next(buf[i]);
+			}
+			benchmark::DoNotOptimize(out);
+		}
+		i = (i + 1) % n;
+	}
+	delete[] filters;
+	delete[] efs;
+}
+BENCHMARK(BM_Filter_VocoderBandsScalar16);
+
+static void BM_Filter_VocoderBandsLanes16(benchmark::State& state) {
+	const int channels = 16;
+	const int bands = 14;
+	const int groups = laneGroups(channels);
+	WhiteNoiseGenerator r;
+	const int n = 128;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 5.0f * r.next();
+	}
+
+	MultimodeBankLanes* banks[groups];
+	EnvelopeFollowerLanes* efs = new EnvelopeFollowerLanes[groups * bands];
+	for (int g = 0; g < groups; ++g) {
+		banks[g] = new MultimodeBankLanes(bands);
+		for (int l = 0; l < laneWidth; ++l) {
+			for (int b = 0; b < bands; ++b) {
+				banks[g]->setParams(b, l, 44100.0f, MultimodeFilter::BUTTERWORTH_TYPE, 4, MultimodeFilter::BANDPASS_MODE, 100.0f * (b + 1), 0.3f);
+				efs[g * bands + b].setParams(l, 44100.0f, 0.3f);
+			}
+		}
+	}
+	int i = 0;
+	for (auto _ : state) {
+		for (int g = 0; g < groups; ++g) {
+			lanes_t in = buf[i];
+			lanes_t out = 0.0f;
+			for (int b = 0; b < bands; ++b) {
+				out = out + efs[g * bands + b].next(in) * banks[g]->next(b, in);
+			}
+			benchmark::DoNotOptimize(out);
+		}
+		i = (i + 1) % n;
+	}
+	for (int g = 0; g < groups; ++g) {
+		delete banks[g];
+	}
+	delete[] efs;
+}
+BENCHMARK(BM_Filter_VocoderBandsLanes16);
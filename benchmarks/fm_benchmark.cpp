@@ -0,0 +1,54 @@
+
+#include <benchmark/benchmark.h>
+
+#include "dsp/filters/resample.hpp"
+#include "dsp/fm.hpp"
+#include "dsp/oscillator.hpp"
+
+using namespace bogaudio::dsp;
+
+static void BM_FM_ScalarOperator16(benchmark::State& state) {
+	const int channels = 16;
+	const int oversample = 8;
+	Phasor phasors[channels];
+	SineTableOscillator sine;
+	CICDecimator decimators[channels];
+	float buffer[oversample];
+	float feedback[channels] {};
+	for (int c = 0; c < channels; ++c) {
+		phasors[c].setSampleRate(44100.0f);
+		phasors[c].setFrequency((100.0f + 50.0f * c) / (float)oversample);
+		decimators[c].setParams(44100.0f, oversample);
+	}
+	for (auto _ : state) {
+		for (int c = 0; c < channels; ++c) {
+			Phasor::phase_delta_t o = Phasor::radiansToPhase(0.5f * feedback[c]);
+			for (int i = 0; i < oversample; ++i) {
+				phasors[c].advancePhase();
+				buffer[i] = sine.nextFromPhasor(phasors[c], o);
+			}
+			feedback[c] = decimators[c].next(buffer);
+		}
+		benchmark::DoNotOptimize(feedback);
+	}
+}
+BENCHMARK(BM_FM_ScalarOperator16);
+
+static void BM_FM_FMOperatorVoices16(benchmark::State& state) {
+	const int channels = 16;
+	FMOperatorVoices voices(44100.0f);
+	lanes_t feedback[FMOperatorVoices::maxGroups];
+	for (int c = 0; c < channels; ++c) {
+		voices.setFrequency(c, 100.0f + 50.0f * c);
+	}
+	for (int g = 0; g < laneGroups(channels); ++g) {
+		feedback[g] = 0.0f;
+	}
+	for (auto _ : state) {
+		for (int g = 0; g < laneGroups(channels); ++g) {
+			feedback[g] = voices.next(g, 0.5f * feedback[g], 1.0f);
+		}
+		benchmark::DoNotOptimize(feedback);
+	}
+}
+BENCHMARK(BM_FM_FMOperatorVoices16);
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include "dsp/filters/multimode.hpp"
+#include "dsp/lpg.hpp"
+#include "dsp/noise.hpp"
+#include "dsp/signal.hpp"
+
+using namespace bogaudio::dsp;
+
+// 16 voices of a low-pass gate as LPG ran them before LowPassGateVoices, a
+// voice at a time: a rise/fall slew of the gate, a 4-pole lowpass redesigned
+// every sample, the 80Hz final highpass, and a slewed decibel VCA.
+static void BM_LPG_ScalarVoices16(benchmark::State& state) {
+	const int channels = 16;
+	const float sr = 44100.0f;
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 5.0f * r.next();
+	}
+	ShapedSlewLimiter rise[channels];
+	ShapedSlewLimiter fall[channels];
+	float last[channels] {};
+	MultimodeFilter4 lowpass[channels];
+	MultimodeFilter4 finalHighpass[channels];
+	SlewLimiter levelSlew[channels];
+	Amplifier vca[channels];
+	for (int c = 0; c < channels; ++c) {
+		rise[c].setParams(sr, 5.0f + c, 0.5f);
+		fall[c].setParams(sr, 500.0f + c, 2.0f);
+		finalHighpass[c].setParams(sr, MultimodeFilter::BUTTERWORTH_TYPE, 2, MultimodeFilter::HIGHPASS_MODE, 80.0f, MultimodeFilter::minQbw, MultimodeFilter::LINEAR_BANDWIDTH_MODE, MultimodeFilter::MINIMUM_DELAY_MODE);
+		levelSlew[c].setParams(sr, 5.0f, 1.0f);
+	}
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		float gate = i < n / 4 ? 10.0f : 0.0f;
+		for (int c = 0; c < channels; ++c) {
+			float env = last[c] = (gate > last[c] ? rise[c] : fall[c]).next(gate);
+			env *= 0.1f;
+			lowpass[c].setParams(sr, MultimodeFilter::BUTTERWORTH_TYPE, 4, MultimodeFilter::LOWPASS_MODE, std::max(20000.0f * env, MultimodeFilter4::minFrequency), 0.0f);
+			vca[c].setLevel(Amplifier::minDecibels * (1.0f - levelSlew[c].next(env)));
+			benchmark::DoNotOptimize(vca[c].next(finalHighpass[c].next(lowpass[c].next(buf[(i + c) % n]))));
+		}
+	}
+}
+BENCHMARK(BM_LPG_ScalarVoices16);
+
+// The same 16 voices, laneWidth at a time.
+static void BM_LPG_Voices16(benchmark::State& state) {
+	const int channels = 16;
+	const float sr = 44100.0f;
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n + channels];
+	for (int i = 0; i < n + channels; ++i) {
+		buf[i] = 5.0f * r.next();
+	}
+	RiseFallShapedSlewLimiterLanes slews[LowPassGateVoices::maxGroups];
+	LowPassGateVoices voices(sr);
+	voices.setFilters(4);
+	for (int c = 0; c < channels; ++c) {
+		slews[c / laneWidth].setParams(c % laneWidth, sr, 5.0f + c, 0.5f, 500.0f + c, 2.0f);
+		voices.setLowpass(c, 0.0f, 1.0f);
+		voices.setLevel(c, 0.0f, 1.0f);
+	}
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		lanes_t gate = i < n / 4 ? 10.0f : 0.0f;
+		for (int g = 0; g < laneGroups(channels); ++g) {
+			lanes_t env = 0.1f * slews[g].next(gate);
+			benchmark::DoNotOptimize(voices.next(g, lanes::load(buf + i + g * laneWidth), env));
+		}
+	}
+}
+BENCHMARK(BM_LPG_Voices16);
@@ -36,3 +36,27 @@ static void BM_Noise_GaussianNoise(benchmark::State& state) {
 	}
 }
 BENCHMARK(BM_Noise_GaussianNoise);
+
+static void BM_Noise_WhiteNoiseLanes(benchmark::State& state) {
+	WhiteNoiseLanes g;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(g.next());
+	}
+}
+BENCHMARK(BM_Noise_WhiteNoiseLanes);
+
+static void BM_Noise_RandomWalk(benchmark::State& state) {
+	RandomWalk w;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(w.next());
+	}
+}
+BENCHMARK(BM_Noise_RandomWalk);
+
+static void BM_Noise_RandomWalkLanes(benchmark::State& state) {
+	RandomWalkLanes w;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(w.next());
+	}
+}
+BENCHMARK(BM_Noise_RandomWalkLanes);
@@ -110,6 +110,79 @@ static void BM_Oscillator_SampledTriangleOscillator(benchmark::State& state) {
 }
 BENCHMARK(BM_Oscillator_SampledTriangleOscillator);
 
+static void BM_Oscillator_TriangleEightOffsets(benchmark::State& state) {
+	Phasor p(44100.0, 440.0);
+	TriangleOscillator o;
+	Phasor::phase_delta_t offsets[8];
+	for (int t = 0; t < 8; ++t) {
+		offsets[t] = Phasor::radiansToPhase(0.25f * t * M_PI);
+	}
+	for (auto _ : state) {
+		p.advancePhase();
+		for (int t = 0; t < 8; ++t) {
+			benchmark::DoNotOptimize(o.nextFromPhasor(p, offsets[t]));
+		}
+	}
+}
+BENCHMARK(BM_Oscillator_TriangleEightOffsets);
+
+static void BM_Oscillator_PhaseTapsTriangle(benchmark::State& state) {
+	Phasor p(44100.0, 440.0);
+	PhaseTaps taps;
+	for (int t = 0; t < 8; ++t) {
+		taps.setOffset(t, Phasor::radiansToPhase(0.25f * t * M_PI));
+	}
+	float out[PhaseTaps::maxTaps];
+	for (auto _ : state) {
+		p.advancePhase();
+		taps.next(PhaseTaps::TRIANGLE_WAVE, p._phase, out);
+		benchmark::DoNotOptimize(out[0]);
+	}
+}
+BENCHMARK(BM_Oscillator_PhaseTapsTriangle);
+
+static void BM_Oscillator_PhaseTapsSine(benchmark::State& state) {
+	Phasor p(44100.0, 440.0);
+	PhaseTaps taps;
+	for (int t = 0; t < 8; ++t) {
+		taps.setOffset(t, Phasor::radiansToPhase(0.25f * t * M_PI));
+	}
+	float out[PhaseTaps::maxTaps];
+	for (auto _ : state) {
+		p.advancePhase();
+		taps.next(PhaseTaps::SINE_WAVE, p._phase, out);
+		benchmark::DoNotOptimize(out[0]);
+	}
+}
+BENCHMARK(BM_Oscillator_PhaseTapsSine);
+
+static void BM_Oscillator_WavetableOscillatorLinear(benchmark::State& state) {
+	WavetableOscillator o(StaticSawWavetable::wavetable(), 44100.0, 440.0, Wavetable::LINEAR_INTERPOLATION);
+	for (auto _ : state) {
+		o.next();
+	}
+}
+BENCHMARK(BM_Oscillator_WavetableOscillatorLinear);
+
+static void BM_Oscillator_WavetableOscillatorCubic(benchmark::State& state) {
+	WavetableOscillator o(StaticSawWavetable::wavetable(), 44100.0, 440.0, Wavetable::CUBIC_INTERPOLATION);
+	for (auto _ : state) {
+		o.next();
+	}
+}
+BENCHMARK(BM_Oscillator_WavetableOscillatorCubic);
+
+static void BM_Oscillator_WavetableVoicesCubic(benchmark::State& state) {
+	WavetableVoices v(StaticSawWavetable::wavetable(), 44100.0, Wavetable::CUBIC_INTERPOLATION);
+	for (int l = 0; l < laneWidth; ++l) {
+		v.setFrequency(l, 440.0f * (l + 1));
+	}
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(v.next());
+	}
+}
+BENCHMARK(BM_Oscillator_WavetableVoicesCubic);
+
 static void BM_Oscillator_SineBankOscillator100(benchmark::State& state) {
 	SineBankOscillator o(44100.0, 100.0, 100);
 	for (int i = 1, n = o.partialCount(); i <= n; ++i) {
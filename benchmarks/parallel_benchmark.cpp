@@ -0,0 +1,54 @@
+
+#include <benchmark/benchmark.h>
+
+#include "dsp/filters/multimode.hpp"
+#include "dsp/noise.hpp"
+#include "dsp/parallel.hpp"
+
+using namespace bogaudio::dsp;
+
+namespace {
+	// 16 channels of 12-pole filter, as a heavy polyphonic VCF.
+	struct Channels {
+		static constexpr int n = 16;
+		MultimodeFilter16 filters[n];
+		float in = 0.0f;
+		float out[n] {};
+
+		Channels() {
+			for (int c = 0; c < n; ++c) {
+				filters[c].setParams(44100.0f, MultimodeFilter::BUTTERWORTH_TYPE, 12, MultimodeFilter::LOWPASS_MODE, 500.0f + 200.0f * c, 0.0f);
+			}
+		}
+
+		static void process(void* context, int c) {
+			Channels* channels = (Channels*)context;
+			channels->out[c] = channels->filters[c].next(channels->in);
+		}
+	};
+}
+
+static void BM_Parallel_Inline16(benchmark::State& state) {
+	WhiteNoiseGenerator r;
+	Channels channels;
+	for (auto _ : state) {
+		channels.in = r.next();
+		for (int c = 0; c < Channels::n; ++c) {
+			Channels::process(&channels, c);
+		}
+		benchmark::DoNotOptimize(channels.out[Channels::n - 1]);
+	}
+}
+BENCHMARK(BM_Parallel_Inline16);
+
+static void BM_Parallel_Workers16(benchmark::State& state) {
+	WhiteNoiseGenerator r;
+	Channels channels;
+	ChannelWorkers workers(state.range(0));
+	for (auto _ : state) {
+		channels.in = r.next();
+		workers.run(Channels::process, &channels, Channels::n, 1.0f / 44100.0f);
+		benchmark::DoNotOptimize(channels.out[Channels::n - 1]);
+	}
+}
+BENCHMARK(BM_Parallel_Workers16)->Arg(1)->Arg(2)->Arg(3)->UseRealTime();
@@ -81,6 +81,43 @@ static void BM_Signal_ShapedSlewLimiter(benchmark::State& state) {
 }
 BENCHMARK(BM_Signal_ShapedSlewLimiter);
 
+// as an envelope's gate: the input holds still while the output slews.
+static void BM_Signal_ShapedSlewLimiterHeld(benchmark::State& state) {
+	ShapedSlewLimiter sl(44100.0, 100.0f, 0.5f);
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % 8192;
+		benchmark::DoNotOptimize(sl.next(i < 4096 ? 10.0f : 0.0f));
+	}
+}
+BENCHMARK(BM_Signal_ShapedSlewLimiterHeld);
+
+static void BM_Signal_ShapedSlewLimiterLanes(benchmark::State& state) {
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = r.next();
+	}
+	ShapedSlewLimiterLanes sl(44100.0, 1.0f, 0.5f);
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		benchmark::DoNotOptimize(sl.next(lanes_t(buf[i])));
+	}
+}
+BENCHMARK(BM_Signal_ShapedSlewLimiterLanes);
+
+static void BM_Signal_ShapedSlewLimiterLanesHeld(benchmark::State& state) {
+	ShapedSlewLimiterLanes sl(44100.0, 100.0f, 0.5f);
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % 8192;
+		benchmark::DoNotOptimize(sl.next(lanes_t(i < 4096 ? 10.0f : 0.0f)));
+	}
+}
+BENCHMARK(BM_Signal_ShapedSlewLimiterLanesHeld);
+
 static void BM_Signal_Panner(benchmark::State& state) {
 	SineOscillator o(500.0, 100.0);
 	const int n = 256;
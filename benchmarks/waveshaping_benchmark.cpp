@@ -0,0 +1,174 @@
+
+#include <benchmark/benchmark.h>
+
+#include "dsp/filters/resample.hpp"
+#include "dsp/noise.hpp"
+#include "dsp/waveshaping.hpp"
+
+using namespace bogaudio::dsp;
+
+static void BM_Waveshaping_Saturator(benchmark::State& state) {
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 30.0f * r.next();
+	}
+	Saturator s;
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		benchmark::DoNotOptimize(s.next(buf[i]));
+	}
+}
+BENCHMARK(BM_Waveshaping_Saturator);
+
+static void BM_Waveshaping_SaturatorOversampled4x(benchmark::State& state) {
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 30.0f * r.next();
+	}
+	const int factor = 4;
+	Saturator s;
+	CICInterpolator interpolator(4, factor);
+	CICDecimator decimator(4, factor);
+	float oversampled[factor];
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		interpolator.next(buf[i], oversampled);
+		for (int j = 0; j < factor; ++j) {
+			oversampled[j] = s.next(oversampled[j]);
+		}
+		benchmark::DoNotOptimize(decimator.next(oversampled));
+	}
+}
+BENCHMARK(BM_Waveshaping_SaturatorOversampled4x);
+
+static void BM_Waveshaping_SaturatorFirstOrder(benchmark::State& state) {
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 30.0f * r.next();
+	}
+	AntialiasedSaturator s;
+	s.setOrder(1);
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		benchmark::DoNotOptimize(s.next(buf[i]));
+	}
+}
+BENCHMARK(BM_Waveshaping_SaturatorFirstOrder);
+
+static void BM_Waveshaping_SaturatorSecondOrder(benchmark::State& state) {
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 30.0f * r.next();
+	}
+	AntialiasedSaturator s;
+	s.setOrder(2);
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		benchmark::DoNotOptimize(s.next(buf[i]));
+	}
+}
+BENCHMARK(BM_Waveshaping_SaturatorSecondOrder);
+
+static void BM_Waveshaping_Saturator16(benchmark::State& state) {
+	const int channels = 16;
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 30.0f * r.next();
+	}
+	Saturator s;
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		lanes_t in = buf[i];
+		for (int g = 0; g < laneGroups(channels); ++g) {
+			benchmark::DoNotOptimize(s.next(in));
+		}
+	}
+}
+BENCHMARK(BM_Waveshaping_Saturator16);
+
+static void BM_Waveshaping_SaturatorFirstOrder16(benchmark::State& state) {
+	const int channels = 16;
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 30.0f * r.next();
+	}
+	FirstOrderADAA<SaturatorCurve, lanes_t> s[laneGroups(channels)];
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		lanes_t in = buf[i] * (1.0f / Saturator::limit);
+		for (int g = 0; g < laneGroups(channels); ++g) {
+			benchmark::DoNotOptimize(s[g].next(in));
+		}
+	}
+}
+BENCHMARK(BM_Waveshaping_SaturatorFirstOrder16);
+
+static void BM_Waveshaping_HardClipFirstOrder16(benchmark::State& state) {
+	const int channels = 16;
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 3.0f * r.next();
+	}
+	FirstOrderADAA<HardClipCurve, lanes_t> s[laneGroups(channels)];
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		lanes_t in = buf[i];
+		for (int g = 0; g < laneGroups(channels); ++g) {
+			benchmark::DoNotOptimize(s[g].next(in));
+		}
+	}
+}
+BENCHMARK(BM_Waveshaping_HardClipFirstOrder16);
+
+static void BM_Waveshaping_TanhSecondOrder(benchmark::State& state) {
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 3.0f * r.next();
+	}
+	SecondOrderADAA<TanhCurve> s;
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		benchmark::DoNotOptimize(s.next(buf[i]));
+	}
+}
+BENCHMARK(BM_Waveshaping_TanhSecondOrder);
+
+static void BM_Waveshaping_FoldSecondOrder(benchmark::State& state) {
+	WhiteNoiseGenerator r;
+	const int n = 256;
+	float buf[n];
+	for (int i = 0; i < n; ++i) {
+		buf[i] = 3.0f * r.next();
+	}
+	SecondOrderADAA<FoldCurve> s;
+	int i = 0;
+	for (auto _ : state) {
+		i = ++i % n;
+		benchmark::DoNotOptimize(s.next(buf[i]));
+	}
+}
+BENCHMARK(BM_Waveshaping_FoldSecondOrder);
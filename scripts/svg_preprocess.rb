@@ -376,10 +376,12 @@ def process(name)
 
   doc = read_xml(fn)
   noskin = false
+  panel = false
   globals = {}
 
   root = doc.at_css(':root')
   if root.node_name == 'module'
+    panel = true
     hp = 3
     if root['hp'] && !root['hp'].to_s.empty?
       hp = root['hp'].to_s.to_i
@@ -474,7 +476,8 @@ def process(name)
 
   name = widget_from_filename(fn)
   write_output(name, doc, $main_styles)
-  unless noskin
+  # panels are recolored for the other skins at load time (see Skins::panelSvg).
+  unless noskin || panel
     $skins.each do |skin_name, skin|
       write_output("#{name}-#{skin_name}", doc, "#{$main_styles}\n\n#{skin[1]}")
     end
@@ -36,18 +36,47 @@ def colors_for_styles(styles)
   out
 end
 
+# Panels are rendered in the light skin only, and recolored for the others at
+# load time (see Skins::panelSvg): the fill and stroke each CSS rule sets, keyed
+# as "<class>.<property>", or just "<property>" for rules on bare elements.
+def panel_colors_for_styles(styles)
+  out = {}
+  parser = CssParser::Parser.new
+  parser.load_string!(styles)
+  parser.each_selector do |selector, declarations, _specificity|
+    klass = selector.strip.split('.', 2)[1]
+    declarations.scan(/(fill|stroke):\s*(#\w+)/) do |property, color|
+      out[klass ? "#{klass}.#{property}" : property] = color
+    end
+  end
+  out
+end
+
 js = {}
+panel_colors = {}
 rsdir = File.absolute_path(File.join(File.dirname($0), '..', 'res-src'))
 if File.readable?(File.join(rsdir, 'styles.css'))
   base_styles = File.read(File.join(rsdir, 'styles.css'))
   js['light'] = colors_for_styles(base_styles)
+  panel_colors['light'] = panel_colors_for_styles(base_styles)
 
   Dir.glob(File.join(rsdir, 'skin-*.css')) do |fn|
     if File.basename(fn) =~ /^skin-(\w+).css$/
       skin = $1
       skin_styles = File.read(fn)
       js[skin] = colors_for_styles(base_styles + "\n" + skin_styles)
+      panel_colors[skin] = panel_colors_for_styles(base_styles + "\n" + skin_styles)
+    end
+  end
+
+  # a class with no rule of its own for a property takes the bare element's.
+  keys = panel_colors.values.map(&:keys).flatten.uniq.sort
+  panel_colors.each do |skin, colors|
+    keys.each do |key|
+      property = key.split('.').last
+      colors[key] ||= colors[property] if colors[property]
     end
+    js[skin].merge!(keys.select { |key| colors[key] }.map { |key| [key, colors[key]] }.to_h)
   end
 end
 
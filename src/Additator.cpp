@@ -193,13 +193,16 @@ void Additator::processAlways(const ProcessArgs& args) {
 	lights[COSINE_LIGHT].value = phase == PHASE_COSINE;
 }
 
+void Additator::processAll(const ProcessArgs& args) {
+	outputs[AUDIO_OUTPUT].setChannels(_channels);
+}
+
 void Additator::processChannel(const ProcessArgs& args, int c) {
 	Engine& e = *_engines[c];
 
 	if (e.syncTrigger.next(inputs[SYNC_INPUT].getPolyVoltage(c))) {
 		e.oscillator.syncToPhase(e.phase == PHASE_SINE ? 0.0f : M_PI / 2.0f);
 	}
-	outputs[AUDIO_OUTPUT].setChannels(_channels);
 	outputs[AUDIO_OUTPUT].setVoltage(e.oscillator.next() * 5.0, c);
 }
 
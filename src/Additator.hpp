@@ -126,6 +126,8 @@ struct Additator : BGModule {
 		configInput(FILTER_INPUT, "Filter CV");
 
 		configOutput(AUDIO_OUTPUT, "Signal");
+
+		_parallelizable = true;
 	}
 
 	void reset() override;
@@ -143,6 +145,7 @@ struct Additator : BGModule {
 	float filterParam(int c);
 	void modulateChannel(int c) override;
 	void processAlways(const ProcessArgs& args) override;
+	void processAll(const ProcessArgs& args) override;
 	void processChannel(const ProcessArgs& args, int c) override;
 	float cvValue(int c, Input& cv, bool dc = false);
 };
@@ -2,6 +2,8 @@
 #include "AddrSeq.hpp"
 
 void AddrSeq::processAlways(const ProcessArgs& args) {
+	_steps = &elements();
+
 	if (expanderConnected()) {
 		AddrSeqExpanderMessage* te = toExpander();
 		te->baseID = _id;
@@ -12,8 +14,7 @@ void AddrSeq::processAlways(const ProcessArgs& args) {
 }
 
 void AddrSeq::processChannel(const ProcessArgs& args, int c) {
-	std::lock_guard<SpinLock> lock(_elementsLock);
-	std::vector<AddrSeqStep*>& steps = _elements;
+	const std::vector<AddrSeqStep*>& steps = *_steps;
 	int stepsN = steps.size();
 
 	if (c == 0) {
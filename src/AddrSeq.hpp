@@ -46,6 +46,8 @@ struct AddrSeq : AddrSeqBase {
 		NUM_LIGHTS
 	};
 
+	const std::vector<AddrSeqStep*>* _steps = NULL; // the chain's steps, taken once per sample.
+
 	struct StepsParamQuantity : ParamQuantity {
 		float getDisplayValue() override {
 			float v = getValue();
@@ -54,8 +56,7 @@ struct AddrSeq : AddrSeqBase {
 			}
 
 			auto m = dynamic_cast<AddrSeq*>(module);
-			std::lock_guard<SpinLock> lock(m->_elementsLock);
-			int n = m->_elements.size();
+			int n = m->elementsN();
 			v = clamp(v, 1.0f, 8.0f);
 			v -= 1.0f;
 			v /= 7.0f;
@@ -70,8 +71,7 @@ struct AddrSeq : AddrSeqBase {
 			}
 
 			auto m = dynamic_cast<AddrSeq*>(module);
-			std::lock_guard<SpinLock> lock(m->_elementsLock);
-			int n = m->_elements.size();
+			int n = m->elementsN();
 			dv = clamp(dv, 1.0f, (float)n);
 			dv -= 1.0f;
 			dv /= (float)(n - 1);
@@ -89,8 +89,7 @@ struct AddrSeq : AddrSeqBase {
 			}
 
 			auto m = dynamic_cast<AddrSeq*>(module);
-			std::lock_guard<SpinLock> lock(m->_elementsLock);
-			int n = m->_elements.size();
+			int n = m->elementsN();
 			v = clamp(v, 0.0f, 7.0f);
 			v /= 7.0f;
 			v *= n - 1;
@@ -104,8 +103,7 @@ struct AddrSeq : AddrSeqBase {
 			}
 
 			auto m = dynamic_cast<AddrSeq*>(module);
-			std::lock_guard<SpinLock> lock(m->_elementsLock);
-			int n = m->_elements.size();
+			int n = m->elementsN();
 			dv = clamp(dv, 1.0f, (float)n);
 			dv -= 1.0f;
 			dv /= (float)(n - 1);
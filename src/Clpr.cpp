@@ -2,6 +2,7 @@
 #include "Clpr.hpp"
 
 #define THRESHOLD_RANGE "threshold_range"
+#define ANTIALIASING "antialiasing"
 
 float Clpr::ThresholdParamQuantity::getDisplayValue() {
 	float v = getValue();
@@ -29,6 +30,7 @@ void Clpr::ThresholdParamQuantity::setDisplayValue(float v) {
 
 json_t* Clpr::saveToJson(json_t* root) {
 	json_object_set_new(root, THRESHOLD_RANGE, json_real(_thresholdRange));
+	json_object_set_new(root, ANTIALIASING, json_integer(_antialiasing));
 	return root;
 }
 
@@ -37,6 +39,11 @@ void Clpr::loadFromJson(json_t* root) {
 	if (tr) {
 		_thresholdRange = std::max(0.0f, (float)json_real_value(tr));
 	}
+
+	json_t* aa = json_object_get(root, ANTIALIASING);
+	if (aa) {
+		_antialiasing = clamp((int)json_integer_value(aa), 0, 2);
+	}
 }
 
 bool Clpr::active() {
@@ -63,6 +70,9 @@ void Clpr::modulate() {
 void Clpr::modulateChannel(int c) {
 	Engine& e = *_engines[c];
 
+	e.leftSaturator.setOrder(_antialiasing);
+	e.rightSaturator.setOrder(_antialiasing);
+
 	e.thresholdDb = params[THRESHOLD_PARAM].getValue();
 	if (inputs[THRESHOLD_INPUT].isConnected()) {
 		e.thresholdDb *= clamp(inputs[THRESHOLD_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
@@ -93,11 +103,11 @@ void Clpr::processChannel(const ProcessArgs& args, int c) {
 	e.amplifier.setLevel(-compressionDb);
 	if (outputs[LEFT_OUTPUT].isConnected()) {
 		outputs[LEFT_OUTPUT].setChannels(_channels);
-		outputs[LEFT_OUTPUT].setVoltage(e.saturator.next(e.amplifier.next(leftInput) * e.outLevel), c);
+		outputs[LEFT_OUTPUT].setVoltage(e.leftSaturator.next(e.amplifier.next(leftInput) * e.outLevel), c);
 	}
 	if (outputs[RIGHT_OUTPUT].isConnected()) {
 		outputs[RIGHT_OUTPUT].setChannels(_channels);
-		outputs[RIGHT_OUTPUT].setVoltage(e.saturator.next(e.amplifier.next(rightInput) * e.outLevel), c);
+		outputs[RIGHT_OUTPUT].setVoltage(e.rightSaturator.next(e.amplifier.next(rightInput) * e.outLevel), c);
 	}
 }
 
@@ -145,6 +155,12 @@ struct ClprWidget : BGModuleWidget {
 		tr->addItem(OptionMenuItem("1x (-24dB to 6dB)", [m]() { return m->_thresholdRange == 1.0f; }, [m]() { m->_thresholdRange = 1.0f; }));
 		tr->addItem(OptionMenuItem("2x (-48dB to 12dB)", [m]() { return m->_thresholdRange == 2.0f; }, [m]() { m->_thresholdRange = 2.0f; }));
 		OptionsMenuItem::addToMenu(tr, menu);
+
+		OptionsMenuItem* aa = new OptionsMenuItem("Antialiasing");
+		aa->addItem(OptionMenuItem("None", [m]() { return m->_antialiasing == 0; }, [m]() { m->_antialiasing = 0; }));
+		aa->addItem(OptionMenuItem("1st order", [m]() { return m->_antialiasing == 1; }, [m]() { m->_antialiasing = 1; }));
+		aa->addItem(OptionMenuItem("2nd order", [m]() { return m->_antialiasing == 2; }, [m]() { m->_antialiasing = 2; }));
+		OptionsMenuItem::addToMenu(aa, menu);
 	}
 };
 
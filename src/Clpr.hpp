@@ -2,6 +2,7 @@
 
 #include "bogaudio.hpp"
 #include "dsp/signal.hpp"
+#include "dsp/waveshaping.hpp"
 
 using namespace bogaudio::dsp;
 
@@ -38,12 +39,14 @@ struct Clpr : BGModule {
 
 		Compressor compressor;
 		Amplifier amplifier;
-		Saturator saturator;
+		AntialiasedSaturator leftSaturator;
+		AntialiasedSaturator rightSaturator;
 	};
 
 	Engine* _engines[maxChannels] {};
 	bool _softKnee = true;
 	float _thresholdRange = 1.0f;
+	int _antialiasing = 0;
 
 	struct ThresholdParamQuantity : ParamQuantity {
 		float getDisplayValue() override;
@@ -77,20 +77,7 @@ struct EightFO : LFOBase {
 		PositiveZeroCrossing resetTrigger;
 
 		Phasor phasor;
-		SineTableOscillator sine;
-		TriangleOscillator triangle;
-		SawOscillator ramp;
-		SquareOscillator square;
-		SteppedRandomOscillator stepped;
-
-		Phasor::phase_delta_t phase7Offset = 0.0f;
-		Phasor::phase_delta_t phase6Offset = 0.0f;
-		Phasor::phase_delta_t phase5Offset = 0.0f;
-		Phasor::phase_delta_t phase4Offset = 0.0f;
-		Phasor::phase_delta_t phase3Offset = 0.0f;
-		Phasor::phase_delta_t phase2Offset = 0.0f;
-		Phasor::phase_delta_t phase1Offset = 0.0f;
-		Phasor::phase_delta_t phase0Offset = 0.0f;
+		PhaseTaps taps { 8 };
 
 		float phase7Sample = 0.0f;
 		float phase6Sample = 0.0f;
@@ -119,12 +106,16 @@ struct EightFO : LFOBase {
 		Smoother phase1Smoother;
 		Smoother phase0Smoother;
 
+		ControlRateBlock controlRate;
+		ControlRateTaps controlRateTaps;
+
 		void reset();
 		void sampleRateChange();
 	};
 
 	const float amplitude = 5.0f;
 	Wave _wave = NO_WAVE;
+	PhaseTaps::Wave _tapsWave = PhaseTaps::SINE_WAVE;
 	Engine* _engines[maxChannels] {};
 
 	EightFO() : LFOBase(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS) {
@@ -180,7 +171,7 @@ struct EightFO : LFOBase {
 	void modulateChannel(int c) override;
 	void processChannel(const ProcessArgs& args, int c) override;
 	Phasor::phase_delta_t phaseOffset(int c, Param& p, Input& i, Phasor::phase_delta_t baseOffset);
-	void updateOutput(int c, bool useSample, Output& output, Phasor::phase_delta_t& offset, float& sample, bool& active, Smoother& smoother);
+	void updateOutput(int c, bool useSample, Output& output, float tap, float& sample, bool& active, Smoother& smoother);
 };
 
 } // namespace bogaudio
@@ -47,8 +47,6 @@ void FMOp::Engine::reset() {
 void FMOp::Engine::sampleRateChange() {
 	float sampleRate = APP->engine->getSampleRate();
 	envelope.setSampleRate(sampleRate);
-	phasor.setSampleRate(sampleRate);
-	decimator.setParams(sampleRate, oversample);
 	maxFrequency = 0.475f * sampleRate;
 	feedbackSL.setParams(sampleRate, 5.0f, 1.0f);
 	depthSL.setParams(sampleRate, 5.0f, 1.0f);
@@ -87,6 +85,7 @@ void FMOp::reset() {
 }
 
 void FMOp::sampleRateChange() {
+	_voices.setSampleRate(APP->engine->getSampleRate());
 	for (int c = 0; c < _channels; ++c) {
 		_engines[c]->sampleRateChange();
 	}
@@ -105,13 +104,17 @@ void FMOp::addChannel(int c) {
 	_engines[c]->reset();
 	_engines[c]->sampleRateChange();
 	if (c > 0) {
-		_engines[c]->phasor.syncPhase(_engines[0]->phasor);
+		_voices.syncPhase(c, 0);
+	}
+	else {
+		_voices.resetPhase(c);
 	}
 }
 
 void FMOp::removeChannel(int c) {
 	delete _engines[c];
 	_engines[c] = NULL;
+	_offsets[c] = _oversampleMixes[c] = _levels[c] = 0.0f;
 }
 
 void FMOp::modulate() {
@@ -141,7 +144,7 @@ void FMOp::modulateChannel(int c) {
 	frequency = cvToFrequency(frequency);
 	frequency *= ratio;
 	frequency = clamp(frequency, -e.maxFrequency, e.maxFrequency);
-	e.phasor.setFrequency(frequency / (float)oversample);
+	_voices.setFrequency(c, frequency);
 
 	bool envelopeOn = _levelEnvelopeOn || _feedbackEnvelopeOn || _depthEnvelopeOn;
 	if (envelopeOn && !e.envelopeOn) {
@@ -220,9 +223,9 @@ void FMOp::processChannel(const ProcessArgs& args, int c) {
 		depthOn = depth > 0.001f;
 	}
 
-	float sample = 0.0f;
+	_offsets[c] = offset;
+	_levels[c] = 0.0f;
 	if (out > 0.0001f) {
-		Phasor::phase_delta_t o = Phasor::radiansToPhase(offset);
 		if ((feedbackOn && _antiAliasFeedback) || (depthOn && _antiAliasDepth)) {
 			if (e.oversampleMix < 1.0f) {
 				e.oversampleMix += oversampleMixIncrement;
@@ -232,35 +235,16 @@ void FMOp::processChannel(const ProcessArgs& args, int c) {
 			e.oversampleMix -= oversampleMixIncrement;
 		}
 
-		if (e.oversampleMix > 0.0f) {
-			for (int i = 0; i < oversample; ++i) {
-				e.phasor.advancePhase();
-				e.buffer[i] = e.sineTable.nextFromPhasor(e.phasor, o);
-			}
-			sample = e.oversampleMix * e.decimator.next(e.buffer);
-		}
-		else {
-			e.phasor.advancePhase(oversample);
-		}
-		if (e.oversampleMix < 1.0f) {
-			sample += (1.0f - e.oversampleMix) * e.sineTable.nextFromPhasor(e.phasor, o);
-		}
+		_oversampleMixes[c] = e.oversampleMix;
 
 		if (_linearLevel) {
-			sample *= out;
+			_levels[c] = out;
 		}
 		else {
-			out = (1.0f - out) * Amplifier::minDecibels;
-			e.amplifier.setLevel(out);
-			sample = e.amplifier.next(sample);
+			e.amplifier.setLevel((1.0f - out) * Amplifier::minDecibels);
+			_levels[c] = e.amplifier._level;
 		}
 	}
-	else {
-		e.phasor.advancePhase(oversample);
-	}
-
-	outputs[AUDIO_OUTPUT].setChannels(_channels);
-	outputs[AUDIO_OUTPUT].setVoltage(e.feedbackDelayedSample = amplitude * sample, c);
 
 	_attackLightSum += e.envelope.isStage(dsp::ADSR::ATTACK_STAGE);
 	_decayLightSum += e.envelope.isStage(dsp::ADSR::DECAY_STAGE);
@@ -268,6 +252,32 @@ void FMOp::processChannel(const ProcessArgs& args, int c) {
 	_releaseLightSum += e.envelope.isStage(dsp::ADSR::RELEASE_STAGE);
 }
 
+// The oscillators run after the channel loop, a lane group at a time; the
+// levels are zero for silent channels, and a group with no sounding channel
+// only advances its phases.
+void FMOp::postProcess(const ProcessArgs& args) {
+	outputs[AUDIO_OUTPUT].setChannels(_channels);
+	for (int c = 0; c < _channels; c += laneWidth) {
+		int g = c / laneWidth;
+		lanes_t levels = lanes::load(_levels + c);
+		if (!lanes::any(levels > 0.0f)) {
+			_voices.advance(g);
+			setLanes(outputs[AUDIO_OUTPUT], 0.0f, c);
+			for (int i = c; i < std::min(c + laneWidth, _channels); ++i) {
+				_engines[i]->feedbackDelayedSample = 0.0f;
+			}
+			continue;
+		}
+
+		lanes_t sample = _voices.next(g, lanes::load(_offsets + c), lanes::load(_oversampleMixes + c));
+		sample = amplitude * levels * sample;
+		setLanes(outputs[AUDIO_OUTPUT], sample, c);
+		for (int i = c; i < std::min(c + laneWidth, _channels); ++i) {
+			_engines[i]->feedbackDelayedSample = lanes::get(sample, i - c);
+		}
+	}
+}
+
 void FMOp::postProcessAlways(const ProcessArgs& args) {
 	lights[ATTACK_LIGHT].value = _attackLightSum * _inverseChannels;
 	lights[DECAY_LIGHT].value = _decayLightSum * _inverseChannels;
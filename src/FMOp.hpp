@@ -2,8 +2,7 @@
 
 #include "bogaudio.hpp"
 #include "dsp/envelope.hpp"
-#include "dsp/filters/resample.hpp"
-#include "dsp/oscillator.hpp"
+#include "dsp/fm.hpp"
 #include "dsp/signal.hpp"
 
 using namespace bogaudio::dsp;
@@ -54,7 +53,7 @@ struct FMOp : BGModule {
 	};
 
 	static constexpr float amplitude = 5.0f;
-	static constexpr int oversample = 8;
+	static constexpr int oversample = FMOperatorVoices::oversample;
 	static constexpr float oversampleMixIncrement = 0.01f;
 
 	struct Engine {
@@ -64,12 +63,8 @@ struct FMOp : BGModule {
 		float level = 0.0f;
 		bool envelopeOn = false;
 		float maxFrequency = 0.0f;
-		float buffer[oversample];
 		float oversampleMix = 0.0f;
 		dsp::ADSR envelope;
-		Phasor phasor;
-		SineTableOscillator sineTable;
-		CICDecimator decimator;
 		Trigger gateTrigger;
 		bogaudio::dsp::SlewLimiter feedbackSL;
 		bogaudio::dsp::SlewLimiter depthSL;
@@ -94,6 +89,10 @@ struct FMOp : BGModule {
 	int _sustainLightSum;
 	int _releaseLightSum;
 	Engine* _engines[maxChannels] {};
+	FMOperatorVoices _voices;
+	float _offsets[maxChannels] {};
+	float _oversampleMixes[maxChannels] {};
+	float _levels[maxChannels] {};
 
 	struct RatioParamQuantity : ParamQuantity {
 		float getDisplayValue() override;
@@ -142,6 +141,7 @@ struct FMOp : BGModule {
 	void modulateChannel(int c) override;
 	void processAlways(const ProcessArgs& args) override;
 	void processChannel(const ProcessArgs& args, int c) override;
+	void postProcess(const ProcessArgs& args) override;
 	void postProcessAlways(const ProcessArgs& args) override;
 };
 
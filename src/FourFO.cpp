@@ -57,6 +57,31 @@ void FourFO::removeChannel(int c) {
 
 void FourFO::modulate() {
 	_wave = (Wave)roundf(params[WAVE_PARAM].getValue());
+	switch (_wave) {
+		case RAMP_UP_WAVE: {
+			_tapsWave = PhaseTaps::RAMP_UP_WAVE;
+			break;
+		}
+		case RAMP_DOWN_WAVE: {
+			_tapsWave = PhaseTaps::RAMP_DOWN_WAVE;
+			break;
+		}
+		case TRIANGLE_WAVE: {
+			_tapsWave = PhaseTaps::TRIANGLE_WAVE;
+			break;
+		}
+		case SQUARE_WAVE: {
+			_tapsWave = PhaseTaps::SQUARE_WAVE;
+			break;
+		}
+		case STEPPED_WAVE: {
+			_tapsWave = PhaseTaps::STEPPED_WAVE;
+			break;
+		}
+		default: {
+			_tapsWave = PhaseTaps::SINE_WAVE;
+		}
+	}
 	_slowMode = params[SLOW_PARAM].getValue() > 0.5f;
 }
 
@@ -71,10 +96,10 @@ void FourFO::modulateChannel(int c) {
 			if (inputs[SAMPLE_PWM_INPUT].isConnected()) {
 				pw *= clamp(inputs[SAMPLE_PWM_INPUT].getPolyVoltage(c) / 5.0f, -1.0f, 1.0f);
 			}
-			pw *= 1.0f - 2.0f * e.square.minPulseWidth;
+			pw *= 1.0f - 2.0f * SquareOscillator::minPulseWidth;
 			pw *= 0.5f;
 			pw += 0.5f;
-			e.square.setPulseWidth(pw);
+			e.taps.setPulseWidth(pw);
 			e.sampleSteps = 1;
 			break;
 		}
@@ -113,16 +138,17 @@ void FourFO::modulateChannel(int c) {
 		e.scale *= clamp(inputs[SCALE_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
 	}
 
-	e.phase3Offset = phaseOffset(c, params[PHASE3_PARAM], inputs[PHASE3_INPUT], basePhase3Offset);
-	e.phase2Offset = phaseOffset(c, params[PHASE2_PARAM], inputs[PHASE2_INPUT], basePhase2Offset);
-	e.phase1Offset = phaseOffset(c, params[PHASE1_PARAM], inputs[PHASE1_INPUT], basePhase1Offset);
-	e.phase0Offset = phaseOffset(c, params[PHASE0_PARAM], inputs[PHASE0_INPUT], basePhase0Offset);
+	e.taps.setOffset(3, phaseOffset(c, params[PHASE3_PARAM], inputs[PHASE3_INPUT], basePhase3Offset));
+	e.taps.setOffset(2, phaseOffset(c, params[PHASE2_PARAM], inputs[PHASE2_INPUT], basePhase2Offset));
+	e.taps.setOffset(1, phaseOffset(c, params[PHASE1_PARAM], inputs[PHASE1_INPUT], basePhase1Offset));
+	e.taps.setOffset(0, phaseOffset(c, params[PHASE0_PARAM], inputs[PHASE0_INPUT], basePhase0Offset));
 }
 
 void FourFO::processChannel(const ProcessArgs& args, int c) {
 	Engine& e = *_engines[c];
 
-	if (e.resetTrigger.next(inputs[RESET_INPUT].getPolyVoltage(c))) {
+	bool reset = e.resetTrigger.next(inputs[RESET_INPUT].getPolyVoltage(c));
+	if (reset) {
 		e.phasor.resetPhase();
 	}
 
@@ -137,10 +163,13 @@ void FourFO::processChannel(const ProcessArgs& args, int c) {
 			useSample = true;
 		}
 	}
-	updateOutput(c, useSample, outputs[PHASE3_OUTPUT], e.phase3Offset, e.phase3Sample, e.phase3Active, e.phase3Smoother);
-	updateOutput(c, useSample, outputs[PHASE2_OUTPUT], e.phase2Offset, e.phase2Sample, e.phase2Active, e.phase2Smoother);
-	updateOutput(c, useSample, outputs[PHASE1_OUTPUT], e.phase1Offset, e.phase1Sample, e.phase1Active, e.phase1Smoother);
-	updateOutput(c, useSample, outputs[PHASE0_OUTPUT], e.phase0Offset, e.phase0Sample, e.phase0Active, e.phase0Smoother);
+	e.controlRate.next(_controlRate && e.sampleSteps <= 1, e.phasor, reset);
+	float taps[PhaseTaps::maxTaps];
+	e.controlRateTaps.next(e.taps, _tapsWave, e.phasor, e.controlRate, taps);
+	updateOutput(c, useSample, outputs[PHASE3_OUTPUT], taps[3], e.phase3Sample, e.phase3Active, e.phase3Smoother);
+	updateOutput(c, useSample, outputs[PHASE2_OUTPUT], taps[2], e.phase2Sample, e.phase2Active, e.phase2Smoother);
+	updateOutput(c, useSample, outputs[PHASE1_OUTPUT], taps[1], e.phase1Sample, e.phase1Active, e.phase1Smoother);
+	updateOutput(c, useSample, outputs[PHASE0_OUTPUT], taps[0], e.phase0Sample, e.phase0Active, e.phase0Smoother);
 }
 
 Phasor::phase_delta_t FourFO::phaseOffset(int c, Param& p, Input& i, Phasor::phase_delta_t baseOffset) {
@@ -151,41 +180,11 @@ Phasor::phase_delta_t FourFO::phaseOffset(int c, Param& p, Input& i, Phasor::pha
 	return baseOffset - o;
 }
 
-void FourFO::updateOutput(int c, bool useSample, Output& output, Phasor::phase_delta_t& offset, float& sample, bool& active, Smoother& smoother) {
+void FourFO::updateOutput(int c, bool useSample, Output& output, float tap, float& sample, bool& active, Smoother& smoother) {
 	if (output.isConnected()) {
 		output.setChannels(_channels);
 		if (!useSample || !active) {
-			float v = 0.0f;
-			switch (_wave) {
-				case NO_WAVE: {
-					assert(false);
-				}
-				case SINE_WAVE: {
-					v = _engines[c]->sine.nextFromPhasor(_engines[c]->phasor, offset);
-					break;
-				}
-				case TRIANGLE_WAVE: {
-					v = _engines[c]->triangle.nextFromPhasor(_engines[c]->phasor, offset);
-					break;
-				}
-				case RAMP_UP_WAVE: {
-					v = _engines[c]->ramp.nextFromPhasor(_engines[c]->phasor, offset);
-					break;
-				}
-				case RAMP_DOWN_WAVE: {
-					v = -_engines[c]->ramp.nextFromPhasor(_engines[c]->phasor, offset);
-					break;
-				}
-				case SQUARE_WAVE: {
-					v = _engines[c]->square.nextFromPhasor(_engines[c]->phasor, offset);
-					break;
-				}
-				case STEPPED_WAVE: {
-					v = _engines[c]->stepped.nextFromPhasor(_engines[c]->phasor, offset);
-					break;
-				}
-			}
-			sample = amplitude * _engines[c]->scale * v + _engines[c]->offset;
+			sample = amplitude * _engines[c]->scale * tap + _engines[c]->offset;
 		}
 		output.setVoltage(clamp(smoother.next(sample), -12.0f, 12.0f), c);
 		active = true;
@@ -121,7 +121,8 @@ void LFO::modulateChannel(int c) {
 void LFO::processChannel(const ProcessArgs& args, int c) {
 	Engine& e = *_engines[c];
 
-	if (e.resetTrigger.next(inputs[RESET_INPUT].getPolyVoltage(c))) {
+	bool reset = e.resetTrigger.next(inputs[RESET_INPUT].getPolyVoltage(c));
+	if (reset) {
 		e.phasor.resetPhase();
 	}
 
@@ -136,23 +137,31 @@ void LFO::processChannel(const ProcessArgs& args, int c) {
 			useSample = true;
 		}
 	}
-	updateOutput(c, e.sine, useSample, false, outputs[SINE_OUTPUT], e.sineSample, e.sineActive, e.sineSmoother);
-	updateOutput(c, e.triangle, useSample, false, outputs[TRIANGLE_OUTPUT], e.triangleSample, e.triangleActive, e.triangleSmoother);
-	updateOutput(c, e.ramp, useSample, false, outputs[RAMP_UP_OUTPUT], e.rampUpSample, e.rampUpActive, e.rampUpSmoother);
-	updateOutput(c, e.ramp, useSample, true, outputs[RAMP_DOWN_OUTPUT], e.rampDownSample, e.rampDownActive, e.rampDownSmoother);
-	updateOutput(c, e.square, false, false, outputs[SQUARE_OUTPUT], e.squareSample, e.squareActive, e.squareSmoother);
-	updateOutput(c, e.stepped, false, false, outputs[STEPPED_OUTPUT], e.steppedSample, e.steppedActive, e.steppedSmoother);
+	e.controlRate.next(_controlRate && e.sampleSteps <= 1, e.phasor, reset);
+	updateOutput(c, e.sine, &e.sineControl, 0, useSample, false, outputs[SINE_OUTPUT], e.sineSample, e.sineActive, e.sineSmoother);
+	updateOutput(c, e.triangle, &e.triangleControl, triangleSegmentBits, useSample, false, outputs[TRIANGLE_OUTPUT], e.triangleSample, e.triangleActive, e.triangleSmoother);
+	updateOutput(c, e.ramp, &e.rampControl, rampSegmentBits, useSample, false, outputs[RAMP_UP_OUTPUT], e.rampUpSample, e.rampUpActive, e.rampUpSmoother);
+	updateOutput(c, e.ramp, &e.rampControl, rampSegmentBits, useSample, true, outputs[RAMP_DOWN_OUTPUT], e.rampDownSample, e.rampDownActive, e.rampDownSmoother);
+	updateOutput(c, e.square, NULL, 0, false, false, outputs[SQUARE_OUTPUT], e.squareSample, e.squareActive, e.squareSmoother);
+	updateOutput(c, e.stepped, NULL, 0, false, false, outputs[STEPPED_OUTPUT], e.steppedSample, e.steppedActive, e.steppedSmoother);
 }
 
-void LFO::updateOutput(int c, Phasor& wave, bool useSample, bool invert, Output& output, float& sample, bool& active, Smoother& smoother) {
+void LFO::updateOutput(int c, Phasor& wave, ControlRateWave* control, int segmentBits, bool useSample, bool invert, Output& output, float& sample, bool& active, Smoother& smoother) {
 	if (output.isConnected()) {
 		output.setChannels(_channels);
 		if (!useSample || !active) {
-			sample = wave.nextFromPhasor(_engines[c]->phasor) * amplitude * _engines[c]->scale;
+			Engine& e = *_engines[c];
+			if (control) {
+				sample = control->next(wave, e.phasor, 0, e.controlRate, segmentBits);
+			}
+			else {
+				sample = wave.nextFromPhasor(e.phasor);
+			}
+			sample = sample * amplitude * e.scale;
 			if (invert) {
 				sample = -sample;
 			}
-			sample += _engines[c]->offset;
+			sample += e.offset;
 		}
 		output.setVoltage(clamp(smoother.next(sample), -12.0f, 12.0f), c);
 		active = true;
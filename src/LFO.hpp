@@ -76,6 +76,11 @@ struct LFO : LFOBase {
 		Smoother squareSmoother;
 		Smoother steppedSmoother;
 
+		ControlRateBlock controlRate;
+		ControlRateWave sineControl;
+		ControlRateWave triangleControl;
+		ControlRateWave rampControl;
+
 		void reset();
 		void sampleRateChange();
 	};
@@ -119,7 +124,7 @@ struct LFO : LFOBase {
 	void modulate() override;
 	void modulateChannel(int c) override;
 	void processChannel(const ProcessArgs& args, int c) override;
-	void updateOutput(int c, Phasor& wave, bool useSample, bool invert, Output& output, float& sample, bool& active, Smoother& smoother);
+	void updateOutput(int c, Phasor& wave, ControlRateWave* control, int segmentBits, bool useSample, bool invert, Output& output, float& sample, bool& active, Smoother& smoother);
 };
 
 } // namespace bogaudio
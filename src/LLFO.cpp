@@ -81,6 +81,7 @@ void LLFO::modulate() {
 	_slowMode = params[SLOW_PARAM].getValue() > 0.5f;
 
 	_invert = false;
+	_segmentBits = 0;
 	switch (_wave) {
 		case UNINITIALIZED_WAVE:
 		case SINE_WAVE: {
@@ -90,16 +91,19 @@ void LLFO::modulate() {
 		}
 		case TRIANGLE_WAVE: {
 			_oscillator = &_triangle;
+			_segmentBits = triangleSegmentBits;
 			_samplingEnabled = true;
 			break;
 		}
 		case RAMP_UP_WAVE: {
 			_oscillator = &_ramp;
+			_segmentBits = rampSegmentBits;
 			_samplingEnabled = true;
 			break;
 		}
 		case RAMP_DOWN_WAVE: {
 			_oscillator = &_ramp;
+			_segmentBits = rampSegmentBits;
 			_invert = true;
 			_samplingEnabled = true;
 			break;
@@ -157,7 +161,8 @@ void LLFO::processAlways(const ProcessArgs& args) {
 }
 
 void LLFO::processChannel(const ProcessArgs& args, int c) {
-	if (_resetTrigger[c].next(inputs[RESET_INPUT].getPolyVoltage(c))) {
+	bool reset = _resetTrigger[c].next(inputs[RESET_INPUT].getPolyVoltage(c));
+	if (reset) {
 		_phasor[c].resetPhase();
 	}
 	_phasor[c].advancePhase();
@@ -172,8 +177,10 @@ void LLFO::processChannel(const ProcessArgs& args, int c) {
 			useSample = true;
 		}
 	}
+	// the waves that may be sampled are the smooth ones.
+	_controlRateBlock[c].next(_controlRate && _samplingEnabled && _sampleSteps[c] <= 1, _phasor[c], reset);
 	if (!useSample) {
-		_currentSample[c] = _oscillator->nextFromPhasor(_phasor[c]) * amplitude * _scale;
+		_currentSample[c] = _controlRateWave[c].next(*_oscillator, _phasor[c], 0, _controlRateBlock[c], _segmentBits) * amplitude * _scale;
 		if (_invert) {
 			_currentSample[c] = -_currentSample[c];
 		}
@@ -71,6 +71,8 @@ struct LLFO : LFOBase {
 	int _sampleStep[maxChannels] {};
 	float _currentSample[maxChannels] {};
 	Smoother _smoother[maxChannels];
+	ControlRateBlock _controlRateBlock[maxChannels];
+	ControlRateWave _controlRateWave[maxChannels];
 
 	SineTableOscillator _sine;
 	TriangleOscillator _triangle;
@@ -79,6 +81,7 @@ struct LLFO : LFOBase {
 	SteppedRandomOscillator _stepped;
 	bool _invert;
 	Phasor* _oscillator;
+	int _segmentBits = 0;
 	bool _samplingEnabled = false;
 
 	LLFO()
@@ -1,26 +1,16 @@
 
 #include "LLPG.hpp"
 
-void LLPG::Engine::reset() {
-	trigger.reset();
-}
-
-void LLPG::Engine::setSampleRate(float sr) {
-	finalHP.setParams(sr, MultimodeFilter::BUTTERWORTH_TYPE, 2, MultimodeFilter::HIGHPASS_MODE, 80.0f, MultimodeFilter::minQbw, MultimodeFilter::LINEAR_BANDWIDTH_MODE, MultimodeFilter::MINIMUM_DELAY_MODE);
-}
-
 void LLPG::reset() {
 	for (int c = 0; c < _channels; ++c) {
-		_engines[c]->reset();
+		_triggers[c].reset();
 	}
 }
 
 void LLPG::sampleRateChange() {
 	_sampleRate = APP->engine->getSampleRate();
 	_sampleTime = APP->engine->getSampleTime();
-	for (int i = 0; i < _channels; ++i) {
-		_engines[i]->setSampleRate(_sampleRate);
-	}
+	_voices.setSampleRate(_sampleRate);
 }
 
 bool LLPG::active() {
@@ -32,18 +22,15 @@ int LLPG::channels() {
 }
 
 void LLPG::addChannel(int c) {
-	_engines[c] = new Engine();
-	_engines[c]->reset();
-	_engines[c]->setSampleRate(_sampleRate);
-}
-
-void LLPG::removeChannel(int c) {
-	delete _engines[c];
-	_engines[c] = NULL;
+	_triggers[c].reset();
+	_gateSeconds[c] = _gateElapsedSeconds[c] = 0.0f;
+	_slews[c / laneWidth].reset(c % laneWidth);
+	_voices.reset(c);
 }
 
 void LLPG::modulateChannel(int c) {
-	_engines[c]->slew.modulate(
+	RiseFallShapedSlewLimiter::modulate(
+		_slews[c / laneWidth],
 		_sampleRate,
 		params[RESPONSE_PARAM],
 		NULL,
@@ -56,55 +43,38 @@ void LLPG::modulateChannel(int c) {
 		c,
 		true
 	);
-}
-
-void LLPG::processChannel(const ProcessArgs& args, int c) {
-	Engine& e = *_engines[c];
-
-	if (e.trigger.process(inputs[GATE_INPUT].getPolyVoltage(c))) {
-		float time = clamp(params[RESPONSE_PARAM].getValue(), 0.0f, 1.0f);
-		time *= time;
-		time *= 0.1f;
-		time += 0.01f;
-		e.gateSeconds = time;
-
-		e.gateElapsedSeconds = 0.0f;
-		e.gateSeconds = time;
-	}
-	else {
-		e.gateElapsedSeconds += _sampleTime;
-	}
-
-	float gate = 0.0f;
-	if (e.gateElapsedSeconds < e.gateSeconds) {
-		gate = 10.0f;
-	}
-	float env = e.slew.next(gate);
-	env /= 10.0f;
 
 	float lpfBias = clamp(params[LPF_PARAM].getValue(), -1.0f, 1.0f);
-	lpfBias *= lpfBias;
-	float f = clamp(lpfBias + env, 0.0f, 1.0f);
-	f *= maxFilterCutoff;
-	f = std::max(f, MultimodeFilter4::minFrequency);
-	e.lpf.setParams(
-		_sampleRate,
-		MultimodeFilter::BUTTERWORTH_TYPE,
-		2,
-		MultimodeFilter::LOWPASS_MODE,
-		f,
-		0.0f
-	);
+	_voices.setLowpass(c, lpfBias * lpfBias, 1.0f);
+	_voices.setLevel(c, clamp(params[VCA_PARAM].getValue(), 0.0f, 1.0f), 1.0f);
+}
 
-	float vcaBias = clamp(params[VCA_PARAM].getValue(), 0.0f, 1.0f);
-	float level = clamp(vcaBias + env, 0.0f, 1.0f);
+void LLPG::processAll(const ProcessArgs& args) {
+	for (int c = 0; c < _channels; ++c) {
+		if (_triggers[c].process(inputs[GATE_INPUT].getPolyVoltage(c))) {
+			float time = clamp(params[RESPONSE_PARAM].getValue(), 0.0f, 1.0f);
+			time *= time;
+			time *= 0.1f;
+			time += 0.01f;
+			_gateSeconds[c] = time;
+			_gateElapsedSeconds[c] = 0.0f;
+		}
+		else {
+			_gateElapsedSeconds[c] += _sampleTime;
+		}
+		_gates[c] = _gateElapsedSeconds[c] < _gateSeconds[c] ? 10.0f : 0.0f;
+		_in[c] = inputs[IN_INPUT].getPolyVoltage(c);
+	}
 
-	float out = inputs[IN_INPUT].getPolyVoltage(c);
-	out = e.finalHP.next(e.lpf.next(out));
-	e.vca.setLevel(Amplifier::minDecibels * (1.0f - level));
-	out = e.vca.next(out);
 	outputs[OUT_OUTPUT].setChannels(_channels);
-	outputs[OUT_OUTPUT].setVoltage(out, c);
+	for (int g = 0, groups = laneGroups(_channels); g < groups; ++g) {
+		int c0 = g * laneWidth;
+		lanes_t env = 0.1f * _slews[g].next(lanes::load(_gates + c0));
+		lanes_t out = _voices.next(g, lanes::load(_in + c0), env);
+		for (int l = 0, c = c0; l < laneWidth && c < _channels; ++l, ++c) {
+			outputs[OUT_OUTPUT].setVoltage(lanes::get(out, l), c);
+		}
+	}
 }
 
 struct LLPGWidget : BGModuleWidget {
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "lpg_common.hpp"
-#include "dsp/filters/multimode.hpp"
+#include "dsp/lpg.hpp"
 
 extern Model* modelLLPG;
 
@@ -27,27 +27,22 @@ struct LLPG : BGModule {
 		NUM_OUTPUTS
 	};
 
-	static constexpr float maxFilterCutoff = 20000.0f;
+	static constexpr float maxFilterCutoff = LowPassGateVoices::maxCutoff;
 
-	struct Engine {
-		Trigger trigger;
-		float gateSeconds = 0.0f;
-		float gateElapsedSeconds = 0.0f;
-		RiseFallShapedSlewLimiter slew;
-		MultimodeFilter4 lpf;
-		MultimodeFilter4 finalHP;
-		Amplifier vca;
-
-		void reset();
-		void setSampleRate(float sr);
-	};
-
-	Engine* _engines[maxChannels] {};
+	Trigger _triggers[maxChannels];
+	float _gateSeconds[maxChannels] {};
+	float _gateElapsedSeconds[maxChannels] {};
+	float _gates[maxChannels] {};
+	float _in[maxChannels] {};
+	RiseFallShapedSlewLimiterLanes _slews[maxChannels / laneWidth];
+	LowPassGateVoices _voices;
 	float _sampleRate = 0.0f;
 	float _sampleTime = 0.0f;
 
 	LLPG() {
 		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS);
+		_voices.setFilters(2);
+		_voices.setVCA(false, false);
 		configParam(RESPONSE_PARAM, 0.0f, 1.0f, 0.5f, "Response", "%", 0.0f, 100.0f);
 		configParam(SHAPE_PARAM, -1.0f, 1.0f, -0.25f, "Shape");
 		configParam<ScaledSquaringParamQuantity<(int)maxFilterCutoff>>(LPF_PARAM, 0.0f, 1.0f, 0.0f, "LPF cutoff", " HZ");
@@ -64,9 +59,8 @@ struct LLPG : BGModule {
 	bool active() override;
 	int channels() override;
 	void addChannel(int c) override;
-	void removeChannel(int c) override;
 	void modulateChannel(int c) override;
-	void processChannel(const ProcessArgs& args, int c) override;
+	void processAll(const ProcessArgs& args) override;
 };
 
 } // namespace bogaudio
@@ -3,27 +3,16 @@
 
 #define LPF_POLES "lpf_poles"
 
-void LPG::Engine::reset() {
-	trigger.reset();
-}
-
-void LPG::Engine::setSampleRate(float sr) {
-	vcaSL.setParams(sr, 5.0f, 1.0f);
-	finalHP.setParams(sr, MultimodeFilter::BUTTERWORTH_TYPE, 2, MultimodeFilter::HIGHPASS_MODE, 80.0f, MultimodeFilter::minQbw, MultimodeFilter::LINEAR_BANDWIDTH_MODE, MultimodeFilter::MINIMUM_DELAY_MODE);
-}
-
 void LPG::reset() {
 	for (int c = 0; c < _channels; ++c) {
-		_engines[c]->reset();
+		_triggers[c].reset();
 	}
 }
 
 void LPG::sampleRateChange() {
 	_sampleRate = APP->engine->getSampleRate();
 	_sampleTime = APP->engine->getSampleTime();
-	for (int i = 0; i < _channels; ++i) {
-		_engines[i]->setSampleRate(_sampleRate);
-	}
+	_voices.setSampleRate(_sampleRate);
 }
 
 json_t* LPG::saveToJson(json_t* root) {
@@ -47,18 +36,21 @@ int LPG::channels() {
 }
 
 void LPG::addChannel(int c) {
-	_engines[c] = new Engine();
-	_engines[c]->reset();
-	_engines[c]->setSampleRate(_sampleRate);
+	_triggers[c].reset();
+	_gateSeconds[c] = _gateElapsedSeconds[c] = 0.0f;
+	_slews[c / laneWidth].reset(c % laneWidth);
+	_voices.reset(c);
 }
 
-void LPG::removeChannel(int c) {
-	delete _engines[c];
-	_engines[c] = NULL;
+void LPG::modulate() {
+	LPGEnvBaseModule::modulate();
+	_voices.setFilters(_lpfPoles);
+	_voices.setVCA(params[LINEAR_VCA_PARAM].getValue() > 0.5f);
 }
 
 void LPG::modulateChannel(int c) {
-	_engines[c]->slew.modulate(
+	RiseFallShapedSlewLimiter::modulate(
+		_slews[c / laneWidth],
 		_sampleRate,
 		params[RESPONSE_PARAM],
 		&inputs[RESPONSE_INPUT],
@@ -70,34 +62,6 @@ void LPG::modulateChannel(int c) {
 		params[FALL_SHAPE_PARAM],
 		c
 	);
-}
-
-void LPG::processChannel(const ProcessArgs& args, int c) {
-	Engine& e = *_engines[c];
-
-	if (e.trigger.process(inputs[GATE_INPUT].getPolyVoltage(c))) {
-		float time = clamp(params[RESPONSE_PARAM].getValue(), 0.0f, 1.0f);
-		if (inputs[RESPONSE_INPUT].isConnected()) {
-			time *= clamp(inputs[RESPONSE_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
-		}
-		time *= time;
-		time *= _timeScale * 0.1f;
-		time += 0.01f;
-		e.gateSeconds = time;
-
-		e.gateElapsedSeconds = 0.0f;
-		e.gateSeconds = time;
-	}
-	else {
-		e.gateElapsedSeconds += _sampleTime;
-	}
-
-	float gate = 0.0f;
-	if (e.gateElapsedSeconds < e.gateSeconds) {
-		gate = 10.0f;
-	}
-	float env = e.slew.next(gate);
-	env /= 10.0f;
 
 	float lpfEnv = clamp(params[LPF_ENV_PARAM].getValue(), -1.0f, 1.0f);
 	float lpfBias = clamp(params[LPF_BIAS_PARAM].getValue(), -1.0f, 1.0f);
@@ -105,40 +69,48 @@ void LPG::processChannel(const ProcessArgs& args, int c) {
 		float cv = clamp(inputs[LPF_INPUT].getPolyVoltage(c) / 5.0f, -1.0f, 1.0f);
 		lpfBias = clamp(lpfBias + cv, -1.0f, 1.0f);
 	}
-	lpfBias *= lpfBias;
-	float f = clamp(lpfBias + env * lpfEnv, 0.0f, 1.0f);
-	f *= maxFilterCutoff;
-	f = std::max(f, MultimodeFilter4::minFrequency);
-	e.lpf.setParams(
-		_sampleRate,
-		MultimodeFilter::BUTTERWORTH_TYPE,
-		_lpfPoles,
-		MultimodeFilter::LOWPASS_MODE,
-		f,
-		0.0f
-	);
+	_voices.setLowpass(c, lpfBias * lpfBias, lpfEnv);
 
-	bool linear = params[LINEAR_VCA_PARAM].getValue() > 0.5f;
 	float vcaEnv = clamp(params[VCA_ENV_PARAM].getValue(), -1.0f, 1.0f);
 	float vcaBias = clamp(params[VCA_BIAS_PARAM].getValue(), 0.0f, 1.0f);
 	if (inputs[VCA_INPUT].isConnected()) {
 		float cv = clamp(inputs[VCA_INPUT].getPolyVoltage(c) / 5.0f, -1.0f, 1.0f);
 		vcaBias = clamp(vcaBias + cv, 0.0f, 1.0f);
 	}
-	float level = clamp(vcaBias + env * vcaEnv, 0.0f, 1.0f);
-	level = e.vcaSL.next(level);
+	_voices.setLevel(c, vcaBias, vcaEnv);
+}
 
-	float out = inputs[IN_INPUT].getPolyVoltage(c);
-	out = e.finalHP.next(e.lpf.next(out));
-	if (linear) {
-		out *= level;
-	}
-	else {
-		e.vca.setLevel(Amplifier::minDecibels * (1.0f - level));
-		out = e.vca.next(out);
+// Gates are timed per channel; the envelopes, filters and VCAs then run a
+// group of channels at a time.
+void LPG::processAll(const ProcessArgs& args) {
+	for (int c = 0; c < _channels; ++c) {
+		if (_triggers[c].process(inputs[GATE_INPUT].getPolyVoltage(c))) {
+			float time = clamp(params[RESPONSE_PARAM].getValue(), 0.0f, 1.0f);
+			if (inputs[RESPONSE_INPUT].isConnected()) {
+				time *= clamp(inputs[RESPONSE_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
+			}
+			time *= time;
+			time *= _timeScale * 0.1f;
+			time += 0.01f;
+			_gateSeconds[c] = time;
+			_gateElapsedSeconds[c] = 0.0f;
+		}
+		else {
+			_gateElapsedSeconds[c] += _sampleTime;
+		}
+		_gates[c] = _gateElapsedSeconds[c] < _gateSeconds[c] ? 10.0f : 0.0f;
+		_in[c] = inputs[IN_INPUT].getPolyVoltage(c);
 	}
+
 	outputs[OUT_OUTPUT].setChannels(_channels);
-	outputs[OUT_OUTPUT].setVoltage(out, c);
+	for (int g = 0, groups = laneGroups(_channels); g < groups; ++g) {
+		int c0 = g * laneWidth;
+		lanes_t env = 0.1f * _slews[g].next(lanes::load(_gates + c0));
+		lanes_t out = _voices.next(g, lanes::load(_in + c0), env);
+		for (int l = 0, c = c0; l < laneWidth && c < _channels; ++l, ++c) {
+			outputs[OUT_OUTPUT].setVoltage(lanes::get(out, l), c);
+		}
+	}
 }
 
 struct LPGWidget : BGModuleWidget {
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "lpg_common.hpp"
-#include "dsp/filters/multimode.hpp"
+#include "dsp/lpg.hpp"
 
 extern Model* modelLPG;
 
@@ -35,23 +35,15 @@ struct LPG : LPGEnvBaseModule {
 		NUM_OUTPUTS
 	};
 
-	static constexpr float maxFilterCutoff = 20000.0f;
+	static constexpr float maxFilterCutoff = LowPassGateVoices::maxCutoff;
 
-	struct Engine {
-		Trigger trigger;
-		float gateSeconds = 0.0f;
-		float gateElapsedSeconds = 0.0f;
-		RiseFallShapedSlewLimiter slew;
-		MultimodeFilter4 lpf;
-		MultimodeFilter4 finalHP;
-		Amplifier vca;
-		bogaudio::dsp::SlewLimiter vcaSL;
-
-		void reset();
-		void setSampleRate(float sr);
-	};
-
-	Engine* _engines[maxChannels] {};
+	Trigger _triggers[maxChannels];
+	float _gateSeconds[maxChannels] {};
+	float _gateElapsedSeconds[maxChannels] {};
+	float _gates[maxChannels] {};
+	float _in[maxChannels] {};
+	RiseFallShapedSlewLimiterLanes _slews[maxChannels / laneWidth];
+	LowPassGateVoices _voices;
 	float _sampleRate = 0.0f;
 	float _sampleTime = 0.0f;
 	int _lpfPoles = 2;
@@ -86,9 +78,9 @@ struct LPG : LPGEnvBaseModule {
 	bool active() override;
 	int channels() override;
 	void addChannel(int c) override;
-	void removeChannel(int c) override;
+	void modulate() override;
 	void modulateChannel(int c) override;
-	void processChannel(const ProcessArgs& args, int c) override;
+	void processAll(const ProcessArgs& args) override;
 };
 
 } // namespace bogaudio
@@ -5,10 +5,6 @@
 #define RELEASE_MS "release_ms"
 #define THRESHOLD_RANGE "threshold_range"
 
-void Lmtr::Engine::sampleRateChange() {
-	detector.setSampleRate(APP->engine->getSampleRate());
-}
-
 float Lmtr::ThresholdParamQuantity::getDisplayValue() {
 	float v = getValue();
 	if (!module) {
@@ -34,9 +30,7 @@ void Lmtr::ThresholdParamQuantity::setDisplayValue(float v) {
 }
 
 void Lmtr::sampleRateChange() {
-	for (int c = 0; c < _channels; ++c) {
-		_engines[c]->sampleRateChange();
-	}
+	_dynamics.setSampleRate(APP->engine->getSampleRate());
 }
 
 json_t* Lmtr::saveToJson(json_t* root) {
@@ -73,7 +67,8 @@ int Lmtr::channels() {
 
 void Lmtr::addChannel(int c) {
 	_engines[c] = new Engine();
-	_engines[c]->sampleRateChange();
+	_dynamics.reset(c);
+	_dynamics.setRatio(c, Compressor::maxEffectiveRatio);
 }
 
 void Lmtr::removeChannel(int c) {
@@ -82,19 +77,20 @@ void Lmtr::removeChannel(int c) {
 }
 
 void Lmtr::modulate() {
-	_softKnee = params[KNEE_PARAM].getValue() > 0.5f;
+	_dynamics.setSoftKnee(params[KNEE_PARAM].getValue() > 0.5f);
 }
 
 void Lmtr::modulateChannel(int c) {
 	Engine& e = *_engines[c];
 
-	e.thresholdDb = params[THRESHOLD_PARAM].getValue();
+	float thresholdDb = params[THRESHOLD_PARAM].getValue();
 	if (inputs[THRESHOLD_INPUT].isConnected()) {
-		e.thresholdDb *= clamp(inputs[THRESHOLD_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
+		thresholdDb *= clamp(inputs[THRESHOLD_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
 	}
-	e.thresholdDb *= 30.0f;
-	e.thresholdDb -= 24.0f;
-	e.thresholdDb *= _thresholdRange;
+	thresholdDb *= 30.0f;
+	thresholdDb -= 24.0f;
+	thresholdDb *= _thresholdRange;
+	_dynamics.setThreshold(c, thresholdDb);
 
 	float outGain = params[OUTPUT_GAIN_PARAM].getValue();
 	if (inputs[OUTPUT_GAIN_INPUT].isConnected()) {
@@ -104,37 +100,25 @@ void Lmtr::modulateChannel(int c) {
 	if (e.outGain != outGain) {
 		e.outGain = outGain;
 		e.outLevel = decibelsToAmplitude(e.outGain);
+		_dynamics.setOutputLevel(c, e.outLevel);
 	}
 
-	float sr = APP->engine->getSampleRate();
-	e.attackSL.setParams(sr, _attackMs);
-	e.releaseSL.setParams(sr, _releaseMs);
+	_dynamics.setAttackRelease(c, _attackMs, _releaseMs);
 }
 
-void Lmtr::processChannel(const ProcessArgs& args, int c) {
-	Engine& e = *_engines[c];
-
-	float leftInput = inputs[LEFT_INPUT].getPolyVoltage(c);
-	float rightInput = inputs[RIGHT_INPUT].getPolyVoltage(c);
-	float env = e.detector.next(leftInput + rightInput);
-	if (env > e.lastEnv) {
-		env = e.attackSL.next(env, e.lastEnv);
-	}
-	else {
-		env = e.releaseSL.next(env, e.lastEnv);
-	}
-	e.lastEnv = env;
-
-	float detectorDb = amplitudeToDecibels(env / 5.0f);
-	float compressionDb = e.compressor.compressionDb(detectorDb, e.thresholdDb, Compressor::maxEffectiveRatio, _softKnee);
-	e.amplifier.setLevel(-compressionDb);
-	if (outputs[LEFT_OUTPUT].isConnected()) {
-		outputs[LEFT_OUTPUT].setChannels(_channels);
-		outputs[LEFT_OUTPUT].setVoltage(e.saturator.next(e.amplifier.next(leftInput) * e.outLevel), c);
-	}
-	if (outputs[RIGHT_OUTPUT].isConnected()) {
-		outputs[RIGHT_OUTPUT].setChannels(_channels);
-		outputs[RIGHT_OUTPUT].setVoltage(e.saturator.next(e.amplifier.next(rightInput) * e.outLevel), c);
+void Lmtr::processAll(const ProcessArgs& args) {
+	for (int c = 0, g = 0; c < _channels; c += laneWidth, ++g) {
+		lanes_t leftInput = getPolyLanes(inputs[LEFT_INPUT], c);
+		lanes_t rightInput = getPolyLanes(inputs[RIGHT_INPUT], c);
+		lanes_t level = _dynamics.next(g, leftInput + rightInput);
+		if (outputs[LEFT_OUTPUT].isConnected()) {
+			outputs[LEFT_OUTPUT].setChannels(_channels);
+			setLanes(outputs[LEFT_OUTPUT], _saturator.next(level * leftInput), c);
+		}
+		if (outputs[RIGHT_OUTPUT].isConnected()) {
+			outputs[RIGHT_OUTPUT].setChannels(_channels);
+			setLanes(outputs[RIGHT_OUTPUT], _saturator.next(level * rightInput), c);
+		}
 	}
 }
 
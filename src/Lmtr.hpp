@@ -2,6 +2,7 @@
 
 #include "bogaudio.hpp"
 #include "dsp/filters/utility.hpp"
+#include "dsp/dynamics.hpp"
 #include "dsp/signal.hpp"
 
 using namespace bogaudio::dsp;
@@ -33,19 +34,8 @@ struct Lmtr : BGModule {
 	};
 
 	struct Engine {
-		float thresholdDb = 0.0f;
 		float outGain = -1.0f;
 		float outLevel = 0.0f;
-		float lastEnv = 0.0f;
-
-		bogaudio::dsp::SlewLimiter attackSL;
-		bogaudio::dsp::SlewLimiter releaseSL;
-		RootMeanSquare detector;
-		Compressor compressor;
-		Amplifier amplifier;
-		Saturator saturator;
-
-		void sampleRateChange();
 	};
 
 	static constexpr float defaultAttackMs = 150.0f;
@@ -54,7 +44,8 @@ struct Lmtr : BGModule {
 	static constexpr float maxReleaseMs = 20000.0f;
 
 	Engine* _engines[maxChannels] {};
-	bool _softKnee = true;
+	DynamicsProcessor _dynamics;
+	Saturator _saturator;
 	float _attackMs = defaultAttackMs;
 	float _releaseMs = defaultReleaseMs;
 	float _thresholdRange = 1.0f;
@@ -65,6 +56,7 @@ struct Lmtr : BGModule {
 	};
 
 	Lmtr() {
+		_dynamics.setMode(DynamicsProcessor::COMPRESSOR_MODE);
 		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS);
 		configParam<ThresholdParamQuantity>(THRESHOLD_PARAM, 0.0f, 1.0f, 0.8f, "Threshold", " dB");
 		configParam(OUTPUT_GAIN_PARAM, 0.0f, 1.0f, 0.0f, "Output gain", " dB", 0.0f, 24.0f);
@@ -90,7 +82,7 @@ struct Lmtr : BGModule {
 	void removeChannel(int c) override;
 	void modulate() override;
 	void modulateChannel(int c) override;
-	void processChannel(const ProcessArgs& args, int c) override;
+	void processAll(const ProcessArgs& args) override;
 };
 
 } // namespace bogaudio
@@ -1,13 +1,12 @@
 
 #include "Matrix44.hpp"
 
-void Matrix44::elementsChanged() {
-	// base-class caller holds lock on _elements.
+void Matrix44::elementsChanged(const std::vector<Matrix44Element*>& elements) {
 	Input** cvs = NULL;
 	Param** mutes = NULL;
 	bool* soloByColumns = NULL;
-	if (_elements.size() > 1) {
-		auto e = _elements[1];
+	if (elements.size() > 1) {
+		auto e = elements[1];
 		assert(e);
 		if (e->cvs) {
 			cvs = e->cvs;
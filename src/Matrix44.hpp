@@ -79,7 +79,7 @@ struct Matrix44 : Matrix44Base {
 		setExpanderModelPredicate([](Model* m) { return m == modelMatrix44Cvm; });
 	}
 
-	void elementsChanged() override;
+	void elementsChanged(const std::vector<Matrix44Element*>& elements) override;
 	void processAlways(const ProcessArgs& args) override;
 };
 
@@ -1,13 +1,12 @@
 
 #include "Matrix88.hpp"
 
-void Matrix88::elementsChanged() {
-	// base-class caller holds lock on _elements.
+void Matrix88::elementsChanged(const std::vector<Matrix88Element*>& elements) {
 	Input** cvs = NULL;
 	Param** mutes = NULL;
 	bool* soloByColumns = NULL;
-	for (int i = 1, n = std::min(3, (int)_elements.size()); i < n; ++i) {
-		auto e = _elements[i];
+	for (int i = 1, n = std::min(3, (int)elements.size()); i < n; ++i) {
+		auto e = elements[i];
 		assert(e);
 		if (e->cvs) {
 			cvs = e->cvs;
@@ -190,7 +190,7 @@ struct Matrix88 : Matrix88Base {
 		setExpanderModelPredicate([](Model* m) { return m == modelMatrix88Cv || m == modelMatrix88M; });
 	}
 
-	void elementsChanged() override;
+	void elementsChanged(const std::vector<Matrix88Element*>& elements) override;
 	void processAlways(const ProcessArgs& args) override;
 };
 
@@ -4,32 +4,22 @@
 
 #define VELOCITY_MINIMUM_DECIBELS "velocity_minimum_decibels"
 
-void MegaGate::Engine::reset() {
-	trigger.reset();
-	gatePulseGen.process(10.0);
-}
-
-void MegaGate::Engine::setSampleRate(float sr) {
-	velocitySL.setParams(sr, 5.0f, 1.0f);
-	tiltSL.setParams(sr, 10.0f, 2.0f);
-	leftVcaSL.setParams(sr, 5.0f, 1.0f);
-	rightVcaSL.setParams(sr, 5.0f, 1.0f);
-	leftFinalHP.setParams(sr, MultimodeFilter::BUTTERWORTH_TYPE, 2, MultimodeFilter::HIGHPASS_MODE, 80.0f, MultimodeFilter::minQbw, MultimodeFilter::LINEAR_BANDWIDTH_MODE, MultimodeFilter::MINIMUM_DELAY_MODE);
-	rightFinalHP.setParams(sr, MultimodeFilter::BUTTERWORTH_TYPE, 2, MultimodeFilter::HIGHPASS_MODE, 80.0f, MultimodeFilter::minQbw, MultimodeFilter::LINEAR_BANDWIDTH_MODE, MultimodeFilter::MINIMUM_DELAY_MODE);
-}
+constexpr float MegaGate::velocitySlewMS;
+constexpr float MegaGate::tiltSlewMS;
 
 void MegaGate::reset() {
 	for (int c = 0; c < _channels; ++c) {
-		_engines[c]->reset();
+		_triggers[c].reset();
 	}
 }
 
 void MegaGate::sampleRateChange() {
 	_sampleRate = APP->engine->getSampleRate();
 	_sampleTime = APP->engine->getSampleTime();
-	for (int i = 0; i < _channels; ++i) {
-		_engines[i]->setSampleRate(_sampleRate);
-	}
+	_velocityDelta = 1.0f / ((velocitySlewMS / 1000.0f) * _sampleRate);
+	_tiltDelta = 2.0f / ((tiltSlewMS / 1000.0f) * _sampleRate);
+	_leftVoices.setSampleRate(_sampleRate);
+	_rightVoices.setSampleRate(_sampleRate);
 }
 
 json_t* MegaGate::saveToJson(json_t* root) {
@@ -55,18 +45,31 @@ int MegaGate::channels() {
 }
 
 void MegaGate::addChannel(int c) {
-	_engines[c] = new Engine();
-	_engines[c]->reset();
-	_engines[c]->setSampleRate(_sampleRate);
+	_triggers[c].reset();
+	_gateSeconds[c] = _gateElapsedSeconds[c] = 0.0f;
+	_slews[c / laneWidth].reset(c % laneWidth);
+	lanes::set(_velocity[c / laneWidth], c % laneWidth, 0.0f);
+	lanes::set(_tilt[c / laneWidth], c % laneWidth, 0.0f);
+	_leftVoices.reset(c);
+	_rightVoices.reset(c);
 }
 
-void MegaGate::removeChannel(int c) {
-	delete _engines[c];
-	_engines[c] = NULL;
+void MegaGate::modulate() {
+	LPGEnvBaseModule::modulate();
+
+	int lpfPoles = 1 + roundf(clamp(params[LPF_POLES_PARAM].getValue(), 0.0f, 3.0f));
+	int hpfPoles = 1 + roundf(clamp(params[HPF_POLES_PARAM].getValue(), 0.0f, 3.0f));
+	bool serial = params[FILTERS_SERIAL_PARAM].getValue() > 0.5f;
+	bool linear = params[LINEAR_VCA_PARAM].getValue() > 0.5f;
+	_leftVoices.setFilters(lpfPoles, hpfPoles, serial);
+	_leftVoices.setVCA(linear);
+	_rightVoices.setFilters(lpfPoles, hpfPoles, serial);
+	_rightVoices.setVCA(linear);
 }
 
 void MegaGate::modulateChannel(int c) {
-	_engines[c]->slew.modulate(
+	RiseFallShapedSlewLimiter::modulate(
+		_slews[c / laneWidth],
 		_sampleRate,
 		params[RISE_PARAM],
 		&inputs[RISE_INPUT],
@@ -82,64 +85,6 @@ void MegaGate::modulateChannel(int c) {
 		_riseShapeMode,
 		_fallShapeMode
 	);
-}
-
-void MegaGate::processChannel(const ProcessArgs& args, int c) {
-	Engine& e = *_engines[c];
-
-	float in = inputs[GATE_INPUT].getPolyVoltage(c);
-	if (e.trigger.process(in)) {
-		float time = clamp(params[MINIMUM_GATE_PARAM].getValue(), 0.0f, 1.0f);
-		if (inputs[MINIMUM_GATE_INPUT].isConnected()) {
-			time *= clamp(inputs[MINIMUM_GATE_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
-		}
-		time *= time;
-		time *= _timeScale;
-		e.gateSeconds = time;
-
-		e.gateElapsedSeconds = 0.0f;
-		if (_gateToTrigger) {
-			e.gateSeconds = std::max(0.01f, time);
-		}
-		else {
-			e.gateSeconds = time;
-		}
-	}
-	else {
-		e.gateElapsedSeconds += _sampleTime;
-	}
-
-	float gate = 0.0f;
-	if (e.gateElapsedSeconds < e.gateSeconds) {
-		gate = 10.0f;
-	}
-	else if (!_gateToTrigger) {
-		gate = in;
-	}
-
-	float velocity = 1.0f;
-	if (inputs[VELOCITY_INPUT].isConnected()) {
-		velocity = clamp(inputs[VELOCITY_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
-	}
-	velocity = e.velocitySL.next(velocity);
-	e.velocityAmp.setLevel(_minVelocityDb + velocity * (_maxVelocityDb - _minVelocityDb));
-	float env = e.velocityAmp.next(e.slew.next(gate));
-	env /= 10.0f;
-
-	float tilt = clamp(params[TILT_PARAM].getValue(), -1.0f, 1.0f);
-	if (inputs[TILT_INPUT].isConnected()) {
-		tilt *= clamp(inputs[TILT_INPUT].getPolyVoltage(c) / 5.0f, -1.0f, 1.0f);
-	}
-	tilt = e.tiltSL.next(tilt);
-
-	float leftEnv = env;
-	float rightEnv = env;
-	if (tilt < 0.0f) {
-		rightEnv *= 1.0f + tilt;
-	}
-	else {
-		leftEnv *= 1.0f - tilt;
-	}
 
 	float lpfEnv = clamp(params[LPF_ENV_PARAM].getValue(), -1.0f, 1.0f);
 	if (inputs[LPF_ENV_INPUT].isConnected()) {
@@ -154,7 +99,6 @@ void MegaGate::processChannel(const ProcessArgs& args, int c) {
 		lpfBias = clamp(lpfBias + cv, -1.0f, 1.0f);
 	}
 	lpfBias *= lpfBias;
-	int lpfPoles = 1 + roundf(clamp(params[LPF_POLES_PARAM].getValue(), 0.0f, 3.0f));
 
 	float hpfEnv = clamp(params[HPF_ENV_PARAM].getValue(), -1.0f, 1.0f);
 	if (inputs[HPF_ENV_INPUT].isConnected()) {
@@ -169,10 +113,6 @@ void MegaGate::processChannel(const ProcessArgs& args, int c) {
 		hpfBias = clamp(hpfBias + cv, -1.0f, 1.0f);
 	}
 	hpfBias *= hpfBias;
-	int hpfPoles = 1 + roundf(clamp(params[HPF_POLES_PARAM].getValue(), 0.0f, 3.0f));
-
-	bool serial = params[FILTERS_SERIAL_PARAM].getValue() > 0.5f;
-	bool linear = params[LINEAR_VCA_PARAM].getValue() > 0.5f;
 
 	float vcaEnv = clamp(params[VCA_ENV_PARAM].getValue(), -1.0f, 1.0f);
 	if (inputs[VCA_ENV_INPUT].isConnected()) {
@@ -187,126 +127,105 @@ void MegaGate::processChannel(const ProcessArgs& args, int c) {
 		vcaBias = clamp(vcaBias + cv, 0.0f, 1.0f);
 	}
 
-	{
-		float f = clamp(lpfBias + leftEnv * lpfEnv, 0.0f, 1.0f);
-		f *= maxFilterCutoff;
-		f = std::max(f, MultimodeFilter4::minFrequency);
-		e.leftLpf.setParams(
-			_sampleRate,
-			MultimodeFilter::BUTTERWORTH_TYPE,
-			lpfPoles,
-			MultimodeFilter::LOWPASS_MODE,
-			f,
-			0.0f
-		);
-	}
-	{
-		float f = clamp(hpfBias - leftEnv * hpfEnv, 0.0f, 1.0f);
-		f *= maxFilterCutoff;
-		f = std::max(f, MultimodeFilter4::minFrequency);
-		e.leftHpf.setParams(
-			_sampleRate,
-			MultimodeFilter::BUTTERWORTH_TYPE,
-			hpfPoles,
-			MultimodeFilter::HIGHPASS_MODE,
-			f,
-			0.0f
-		);
+	// the highpass closes as the envelope rises.
+	for (LowPassGateVoices* v : { &_leftVoices, &_rightVoices }) {
+		v->setLowpass(c, lpfBias, lpfEnv);
+		v->setHighpass(c, hpfBias, -hpfEnv);
+		v->setLevel(c, vcaBias, vcaEnv);
 	}
-	float level = clamp(vcaBias + leftEnv * vcaEnv, 0.0f, 1.0f);
-	level = e.leftVcaSL.next(level);
+}
 
-	float leftIn = inputs[LEFT_INPUT].getPolyVoltage(c);
-	float leftOut = 0.0f;
-	if (serial) {
-		leftOut = e.leftHpf.next(e.leftLpf.next(leftIn));
-	}
-	else {
-		leftOut = e.leftLpf.next(leftIn) + e.leftHpf.next(leftIn);
-	}
-	leftOut = e.leftFinalHP.next(leftOut);
-	if (linear) {
-		leftOut *= level;
+void MegaGate::processAlways(const ProcessArgs& args) {
+	{
+		int poles = params[LPF_POLES_PARAM].getValue();
+		lights[LPF_POLES_1_LIGHT].value = poles == 0;
+		lights[LPF_POLES_2_LIGHT].value = poles == 1;
+		lights[LPF_POLES_3_LIGHT].value = poles == 2;
+		lights[LPF_POLES_4_LIGHT].value = poles == 3;
 	}
-	else {
-		e.leftVca.setLevel(Amplifier::minDecibels * (1.0f - level));
-		leftOut = e.leftVca.next(leftOut);
+	{
+		int poles = params[HPF_POLES_PARAM].getValue();
+		lights[HPF_POLES_1_LIGHT].value = poles == 0;
+		lights[HPF_POLES_2_LIGHT].value = poles == 1;
+		lights[HPF_POLES_3_LIGHT].value = poles == 2;
+		lights[HPF_POLES_4_LIGHT].value = poles == 3;
 	}
+}
 
-	float rightOut = 0.0f;
-	if (outputs[RIGHT_OUTPUT].isConnected()) {
-		float rightIn = leftIn;
-		if (inputs[RIGHT_INPUT].isConnected()) {
-			rightIn = inputs[RIGHT_INPUT].getPolyVoltage(c);
+// Gates, velocity and tilt are read per channel; the envelopes, filters and
+// VCAs then run a group of channels at a time, for each side.
+void MegaGate::processAll(const ProcessArgs& args) {
+	bool right = outputs[RIGHT_OUTPUT].isConnected();
+	for (int c = 0; c < _channels; ++c) {
+		float in = inputs[GATE_INPUT].getPolyVoltage(c);
+		if (_triggers[c].process(in)) {
+			float time = clamp(params[MINIMUM_GATE_PARAM].getValue(), 0.0f, 1.0f);
+			if (inputs[MINIMUM_GATE_INPUT].isConnected()) {
+				time *= clamp(inputs[MINIMUM_GATE_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
+			}
+			time *= time;
+			time *= _timeScale;
+			_gateElapsedSeconds[c] = 0.0f;
+			if (_gateToTrigger) {
+				_gateSeconds[c] = std::max(0.01f, time);
+			}
+			else {
+				_gateSeconds[c] = time;
+			}
+		}
+		else {
+			_gateElapsedSeconds[c] += _sampleTime;
 		}
 
-		{
-			float f = clamp(lpfBias + rightEnv * lpfEnv, 0.0f, 1.0f);
-			f *= maxFilterCutoff;
-			f = std::max(f, MultimodeFilter4::minFrequency);
-			e.rightLpf.setParams(
-				_sampleRate,
-				MultimodeFilter::BUTTERWORTH_TYPE,
-				lpfPoles,
-				MultimodeFilter::LOWPASS_MODE,
-				f,
-				0.0f
-			);
+		float gate = 0.0f;
+		if (_gateElapsedSeconds[c] < _gateSeconds[c]) {
+			gate = 10.0f;
 		}
-		{
-			float f = clamp(hpfBias - rightEnv * hpfEnv, 0.0f, 1.0f);
-			f *= maxFilterCutoff;
-			f = std::max(f, MultimodeFilter4::minFrequency);
-			e.rightHpf.setParams(
-				_sampleRate,
-				MultimodeFilter::BUTTERWORTH_TYPE,
-				hpfPoles,
-				MultimodeFilter::HIGHPASS_MODE,
-				f,
-				0.0f
-			);
+		else if (!_gateToTrigger) {
+			gate = in;
 		}
-		float level = clamp(vcaBias + rightEnv * vcaEnv, 0.0f, 1.0f);
-		level = e.rightVcaSL.next(level);
+		_gates[c] = gate;
 
-		if (serial) {
-			rightOut = e.rightHpf.next(e.rightLpf.next(rightIn));
+		_velocities[c] = 1.0f;
+		if (inputs[VELOCITY_INPUT].isConnected()) {
+			_velocities[c] = clamp(inputs[VELOCITY_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
 		}
-		else {
-			rightOut = e.rightLpf.next(rightIn) + e.rightHpf.next(rightIn);
+		_tilts[c] = clamp(params[TILT_PARAM].getValue(), -1.0f, 1.0f);
+		if (inputs[TILT_INPUT].isConnected()) {
+			_tilts[c] *= clamp(inputs[TILT_INPUT].getPolyVoltage(c) / 5.0f, -1.0f, 1.0f);
 		}
-		rightOut = e.rightFinalHP.next(rightOut);
-		if (linear) {
-			rightOut *= level;
-		}
-		else {
-			e.rightVca.setLevel(Amplifier::minDecibels * (1.0f - level));
-			rightOut = e.rightVca.next(rightOut);
+
+		_leftIn[c] = inputs[LEFT_INPUT].getPolyVoltage(c);
+		_rightIn[c] = _leftIn[c];
+		if (inputs[RIGHT_INPUT].isConnected()) {
+			_rightIn[c] = inputs[RIGHT_INPUT].getPolyVoltage(c);
 		}
 	}
 
 	outputs[ENV_OUTPUT].setChannels(_channels);
-	outputs[ENV_OUTPUT].setVoltage(env * 10.0f, c);
 	outputs[LEFT_OUTPUT].setChannels(_channels);
-	outputs[LEFT_OUTPUT].setVoltage(leftOut, c);
 	outputs[RIGHT_OUTPUT].setChannels(_channels);
-	outputs[RIGHT_OUTPUT].setVoltage(rightOut, c);
-}
+	for (int g = 0, groups = laneGroups(_channels); g < groups; ++g) {
+		int c0 = g * laneWidth;
+		lanes_t& velocity = _velocity[g];
+		velocity += lanes::fmin(lanes::fmax(lanes::load(_velocities + c0) - velocity, -_velocityDelta), _velocityDelta);
+		lanes_t& tilt = _tilt[g];
+		tilt += lanes::fmin(lanes::fmax(lanes::load(_tilts + c0) - tilt, -_tiltDelta), _tiltDelta);
+
+		lanes_t env = _slews[g].next(lanes::load(_gates + c0));
+		env *= Amplifier::levels(_minVelocityDb + velocity * (_maxVelocityDb - _minVelocityDb));
+		env *= 0.1f;
+		lanes_t leftOut = _leftVoices.next(g, lanes::load(_leftIn + c0), env * (1.0f - lanes::fmax(tilt, 0.0f)));
+		lanes_t rightOut = 0.0f;
+		if (right) {
+			rightOut = _rightVoices.next(g, lanes::load(_rightIn + c0), env * (1.0f + lanes::fmin(tilt, 0.0f)));
+		}
 
-void MegaGate::processAlways(const ProcessArgs& args) {
-	{
-		int poles = params[LPF_POLES_PARAM].getValue();
-		lights[LPF_POLES_1_LIGHT].value = poles == 0;
-		lights[LPF_POLES_2_LIGHT].value = poles == 1;
-		lights[LPF_POLES_3_LIGHT].value = poles == 2;
-		lights[LPF_POLES_4_LIGHT].value = poles == 3;
-	}
-	{
-		int poles = params[HPF_POLES_PARAM].getValue();
-		lights[HPF_POLES_1_LIGHT].value = poles == 0;
-		lights[HPF_POLES_2_LIGHT].value = poles == 1;
-		lights[HPF_POLES_3_LIGHT].value = poles == 2;
-		lights[HPF_POLES_4_LIGHT].value = poles == 3;
+		for (int l = 0, c = c0; l < laneWidth && c < _channels; ++l, ++c) {
+			outputs[ENV_OUTPUT].setVoltage(10.0f * lanes::get(env, l), c);
+			outputs[LEFT_OUTPUT].setVoltage(lanes::get(leftOut, l), c);
+			outputs[RIGHT_OUTPUT].setVoltage(lanes::get(rightOut, l), c);
+		}
 	}
 }
 
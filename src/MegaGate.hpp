@@ -1,7 +1,7 @@
 #pragma once
 
 #include "lpg_common.hpp"
-#include "dsp/filters/multimode.hpp"
+#include "dsp/lpg.hpp"
 
 extern Model* modelMegaGate;
 
@@ -74,30 +74,27 @@ struct MegaGate : LPGEnvBaseModule {
 		NUM_LIGHTS
 	};
 
-	static constexpr float maxFilterCutoff = 20000.0f;
-
-	struct Engine {
-		Trigger trigger;
-		rack::dsp::PulseGenerator gatePulseGen;
-		float gateSeconds = 0.0f;
-		float gateElapsedSeconds = 0.0f;
-		RiseFallShapedSlewLimiter slew;
-		Amplifier velocityAmp;
-		bogaudio::dsp::SlewLimiter velocitySL;
-		bogaudio::dsp::SlewLimiter tiltSL;
-		MultimodeFilter4 leftLpf, rightLpf;
-		MultimodeFilter4 leftHpf, rightHpf;
-		MultimodeFilter4 leftFinalHP, rightFinalHP;
-		Amplifier leftVca, rightVca;
-		bogaudio::dsp::SlewLimiter leftVcaSL, rightVcaSL;
-
-		void reset();
-		void setSampleRate(float sr);
-	};
-
-	Engine* _engines[maxChannels] {};
+	static constexpr float maxFilterCutoff = LowPassGateVoices::maxCutoff;
+	static constexpr float velocitySlewMS = 5.0f;
+	static constexpr float tiltSlewMS = 10.0f;
+
+	Trigger _triggers[maxChannels];
+	float _gateSeconds[maxChannels] {};
+	float _gateElapsedSeconds[maxChannels] {};
+	float _gates[maxChannels] {};
+	float _velocities[maxChannels] {};
+	float _tilts[maxChannels] {};
+	float _leftIn[maxChannels] {};
+	float _rightIn[maxChannels] {};
+	RiseFallShapedSlewLimiterLanes _slews[maxChannels / laneWidth];
+	lanes_t _velocity[maxChannels / laneWidth] {};
+	lanes_t _tilt[maxChannels / laneWidth] {};
+	LowPassGateVoices _leftVoices;
+	LowPassGateVoices _rightVoices;
 	float _sampleRate = 0.0f;
 	float _sampleTime = 0.0f;
+	float _velocityDelta = 1.0f;
+	float _tiltDelta = 1.0f;
 	const float _maxVelocityDb = 0.0f;
 	float _minVelocityDb = -6.0f;
 
@@ -158,10 +155,10 @@ struct MegaGate : LPGEnvBaseModule {
 	bool active() override;
 	int channels() override;
 	void addChannel(int c) override;
-	void removeChannel(int c) override;
+	void modulate() override;
 	void modulateChannel(int c) override;
-	void processChannel(const ProcessArgs& args, int c) override;
 	void processAlways(const ProcessArgs& args) override;
+	void processAll(const ProcessArgs& args) override;
 };
 
 } // namespace bogaudio
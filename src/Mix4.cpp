@@ -36,12 +36,7 @@ void Mix4::sampleRateChange() {
 }
 
 void Mix4::processAll(const ProcessArgs& args) {
-	Mix4ExpanderMessage* toExp = &_dummyExpanderMessage;
-	Mix4ExpanderMessage* fromExp = &_dummyExpanderMessage;
-	if (expanderConnected()) {
-		toExp = toExpander();
-		fromExp = fromExpander();
-	}
+	Mix4Expander* x = expander();
 
 	if (!(
 		inputs[IN1_INPUT].isConnected() ||
@@ -53,7 +48,10 @@ void Mix4::processAll(const ProcessArgs& args) {
 			--_wasActive;
 			for (int i = 0; i < 4; ++i) {
 				_channels[i]->reset();
-				toExp->active[i] = false;
+				_strips.active[i] = false;
+			}
+			if (x) {
+				x->processStrips(_strips);
 			}
 			_rmsLevel = 0.0f;
 			outputs[L_OUTPUT].setVoltage(0.0f);
@@ -77,8 +75,8 @@ void Mix4::processAll(const ProcessArgs& args) {
 			sample = inputs[IN1_INPUT].getVoltageSum();
 		}
 		_channels[0]->next(sample, solo, 0, _linearCV);
-		toExp->preFader[0] = sample;
-		toExp->active[0] = inputs[IN1_INPUT].isConnected();
+		_strips.preFader[0] = sample;
+		_strips.active[0] = inputs[IN1_INPUT].isConnected();
 
 		for (int i = 1; i < 4; ++i) {
 			float sample = 0.0f;
@@ -96,8 +94,8 @@ void Mix4::processAll(const ProcessArgs& args) {
 				_channels[i]->reset();
 				_channelActive[i] = false;
 			}
-			toExp->preFader[i] = sample;
-			toExp->active[i] = _channelActive[i];
+			_strips.preFader[i] = sample;
+			_strips.active[i] = _channelActive[i];
 		}
 	}
 
@@ -122,17 +120,18 @@ void Mix4::processAll(const ProcessArgs& args) {
 
 	float outs[4];
 	for (int i = 0; i < 4; ++i) {
-		toExp->postFader[i] = outs[i] = _channels[i]->out;
+		_strips.postFader[i] = outs[i] = _channels[i]->out;
 	}
 
 	float mono = 0.0f;
 	float left = 0.0f;
 	float right = 0.0f;
-	if (expanderConnected()) {
-		mono += fromExp->returnA[0] + fromExp->returnB[0];
-		left += fromExp->returnA[0] + fromExp->returnB[0];
-		right += fromExp->returnA[1] + fromExp->returnB[1];
-		std::copy(fromExp->postEQ, fromExp->postEQ + 4, outs);
+	if (x) {
+		x->processStrips(_strips);
+		mono += _strips.returnA[0] + _strips.returnB[0];
+		left += _strips.returnA[0] + _strips.returnB[0];
+		right += _strips.returnA[1] + _strips.returnB[1];
+		std::copy(_strips.postEQ, _strips.postEQ + 4, outs);
 	}
 
 	for (int i = 0; i < 4; ++i) {
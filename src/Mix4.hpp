@@ -6,7 +6,7 @@ using namespace bogaudio::dsp;
 
 namespace bogaudio {
 
-struct Mix4 : ExpandableModule<Mix4ExpanderMessage, DimmableMixerModule> {
+struct Mix4 : DirectExpandableModule<Mix4Expander, DimmableMixerModule> {
 	enum ParamsIds {
 		LEVEL1_PARAM,
 		PAN1_PARAM,
@@ -59,7 +59,7 @@ struct Mix4 : ExpandableModule<Mix4ExpanderMessage, DimmableMixerModule> {
 	Saturator _saturator;
 	RootMeanSquare _rms;
 	float _rmsLevel = 0.0f;
-	Mix4ExpanderMessage _dummyExpanderMessage;
+	Mix4ExpanderStrips _strips {};
 	int _wasActive = 0;
 	bogaudio::dsp::SlewLimiter _levelCVSL;
 
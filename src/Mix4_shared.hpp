@@ -9,6 +9,7 @@ extern Model* modelMix4x;
 
 namespace bogaudio {
 
-typedef MixerExpanderMessage<4> Mix4ExpanderMessage;
+typedef MixerExpanderStrips<4> Mix4ExpanderStrips;
+typedef MixerExpander<4> Mix4Expander;
 
 } // namespace bogaudio
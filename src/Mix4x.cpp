@@ -8,36 +8,46 @@ void Mix4x::sampleRateChange() {
 	}
 	_returnASL.setParams(sr, MixerChannel::levelSlewTimeMS, MixerChannel::maxDecibels - MixerChannel::minDecibels);
 	_returnBSL.setParams(sr, MixerChannel::levelSlewTimeMS, MixerChannel::maxDecibels - MixerChannel::minDecibels);
+	_stripSteps = _modulationSteps;
+	_stripsReady = true;
 }
 
-void Mix4x::modulate() {
-	for (int i = 0; i < 4; ++i) {
-		_channels[i]->modulate();
-	}
-}
-
+// With a mixer attached, all the work is done in processStrips(), on the
+// mixer's thread; see DirectExpandableModule.
 void Mix4x::processAll(const ProcessArgs& args) {
 	if (!baseConnected()) {
 		outputs[SEND_A_OUTPUT].setVoltage(0.0f);
 		outputs[SEND_B_OUTPUT].setVoltage(0.0f);
+	}
+}
+
+void Mix4x::processStrips(Mix4ExpanderStrips& strips) {
+	if (!_stripsReady) {
+		std::copy(strips.preFader, strips.preFader + 4, strips.postEQ);
+		std::fill(strips.returnA, strips.returnA + 2, 0.0f);
+		std::fill(strips.returnB, strips.returnB + 2, 0.0f);
 		return;
 	}
+	if (++_stripSteps >= _modulationSteps) {
+		_stripSteps = 0;
+		for (int i = 0; i < 4; ++i) {
+			_channels[i]->modulate();
+		}
+	}
 
-	Mix4ExpanderMessage* from = fromBase();
-	Mix4ExpanderMessage* to = toBase();
 	float sendA = 0.0f;
 	float sendB = 0.0f;
 	bool sendAActive = outputs[SEND_A_OUTPUT].isConnected();
 	bool sendBActive = outputs[SEND_B_OUTPUT].isConnected();
 	for (int i = 0; i < 4; ++i) {
-		if (from->active[i]) {
-			_channels[i]->next(from->preFader[i], from->postFader[i], sendAActive, sendBActive);
-			to->postEQ[i] = _channels[i]->postEQ;
+		if (strips.active[i]) {
+			_channels[i]->next(strips.preFader[i], strips.postFader[i], sendAActive, sendBActive);
+			strips.postEQ[i] = _channels[i]->postEQ;
 			sendA += _channels[i]->sendA;
 			sendB += _channels[i]->sendB;
 		}
 		else {
-			to->postEQ[i] = from->preFader[i];
+			strips.postEQ[i] = strips.preFader[i];
 		}
 	}
 	outputs[SEND_A_OUTPUT].setVoltage(_saturatorA.next(sendA));
@@ -54,18 +64,21 @@ void Mix4x::processAll(const ProcessArgs& args) {
 		levelA *= Amplifier::minDecibels;
 		_returnAAmp.setLevel(_returnASL.next(levelA));
 		if (lAActive) {
-			to->returnA[0] = _returnAAmp.next(inputs[L_A_INPUT].getVoltage());
+			strips.returnA[0] = _returnAAmp.next(inputs[L_A_INPUT].getVoltage());
 		}
 		else {
-			to->returnA[0] = 0.0f;
+			strips.returnA[0] = 0.0f;
 		}
 		if (rAActive) {
-			to->returnA[1] = _returnAAmp.next(inputs[R_A_INPUT].getVoltage());
+			strips.returnA[1] = _returnAAmp.next(inputs[R_A_INPUT].getVoltage());
 		}
 		else {
-			to->returnA[1] = to->returnA[0];
+			strips.returnA[1] = strips.returnA[0];
 		}
 	}
+	else {
+		strips.returnA[0] = strips.returnA[1] = 0.0f;
+	}
 
 	bool lBActive = inputs[L_B_INPUT].isConnected();
 	bool rBActive = inputs[R_B_INPUT].isConnected();
@@ -75,18 +88,21 @@ void Mix4x::processAll(const ProcessArgs& args) {
 		levelB *= Amplifier::minDecibels;
 		_returnBAmp.setLevel(_returnBSL.next(levelB));
 		if (lBActive) {
-			to->returnB[0] = _returnBAmp.next(inputs[L_B_INPUT].getVoltage());
+			strips.returnB[0] = _returnBAmp.next(inputs[L_B_INPUT].getVoltage());
 		}
 		else {
-			to->returnB[0] = 0.0f;
+			strips.returnB[0] = 0.0f;
 		}
 		if (rBActive) {
-			to->returnB[1] = _returnBAmp.next(inputs[R_B_INPUT].getVoltage());
+			strips.returnB[1] = _returnBAmp.next(inputs[R_B_INPUT].getVoltage());
 		}
 		else {
-			to->returnB[1] = to->returnB[0];
+			strips.returnB[1] = strips.returnB[0];
 		}
 	}
+	else {
+		strips.returnB[0] = strips.returnB[1] = 0.0f;
+	}
 }
 
 struct Mix4xWidget : BGModuleWidget {
@@ -7,7 +7,7 @@ using namespace bogaudio::dsp;
 
 namespace bogaudio {
 
-struct Mix4x : ExpanderModule<Mix4ExpanderMessage, BGModule> {
+struct Mix4x : DirectExpanderModule<BGModule>, Mix4Expander {
 	enum ParamsIds {
 		LOW1_PARAM,
 		MID1_PARAM,
@@ -69,6 +69,8 @@ struct Mix4x : ExpanderModule<Mix4ExpanderMessage, BGModule> {
 	Saturator _saturatorA, _saturatorB;
 	Amplifier _returnAAmp, _returnBAmp;
 	bogaudio::dsp::SlewLimiter _returnASL, _returnBSL;
+	int _stripSteps = 0;
+	std::atomic<bool> _stripsReady { false };
 
 	Mix4x() {
 		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS);
@@ -134,8 +136,8 @@ struct Mix4x : ExpanderModule<Mix4ExpanderMessage, BGModule> {
 	}
 
 	void sampleRateChange() override;
-	void modulate() override;
 	void processAll(const ProcessArgs& args) override;
+	void processStrips(Mix4ExpanderStrips& strips) override;
 };
 
 } // namespace bogaudio
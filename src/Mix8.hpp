@@ -6,7 +6,7 @@ using namespace bogaudio::dsp;
 
 namespace bogaudio {
 
-struct Mix8 : ExpandableModule<Mix8ExpanderMessage, DimmableMixerModule> {
+struct Mix8 : DirectExpandableModule<Mix8Expander, DimmableMixerModule> {
 	enum ParamsIds {
 		LEVEL1_PARAM,
 		MUTE1_PARAM,
@@ -83,7 +83,7 @@ struct Mix8 : ExpandableModule<Mix8ExpanderMessage, DimmableMixerModule> {
 	Saturator _saturator;
 	RootMeanSquare _rms;
 	float _rmsLevel = 0.0f;
-	Mix8ExpanderMessage _dummyExpanderMessage;
+	Mix8ExpanderStrips _strips {};
 	int _wasActive = 0;
 	bogaudio::dsp::SlewLimiter _levelCVSL;
 
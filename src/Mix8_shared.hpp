@@ -9,6 +9,7 @@ extern Model* modelMix8x;
 
 namespace bogaudio {
 
-typedef MixerExpanderMessage<8> Mix8ExpanderMessage;
+typedef MixerExpanderStrips<8> Mix8ExpanderStrips;
+typedef MixerExpander<8> Mix8Expander;
 
 } // namespace bogaudio
@@ -6,7 +6,7 @@
 using namespace bogaudio::dsp;
 namespace bogaudio {
 
-struct Mix8x : ExpanderModule<Mix8ExpanderMessage, BGModule> {
+struct Mix8x : DirectExpanderModule<BGModule>, Mix8Expander {
 	enum ParamsIds {
 		LOW1_PARAM,
 		MID1_PARAM,
@@ -104,6 +104,8 @@ struct Mix8x : ExpanderModule<Mix8ExpanderMessage, BGModule> {
 	Saturator _saturatorA, _saturatorB;
 	Amplifier _returnAAmp, _returnBAmp;
 	bogaudio::dsp::SlewLimiter _returnASL, _returnBSL;
+	int _stripSteps = 0;
+	std::atomic<bool> _stripsReady { false };
 
 	Mix8x() {
 		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS);
@@ -209,8 +211,8 @@ struct Mix8x : ExpanderModule<Mix8ExpanderMessage, BGModule> {
 	}
 
 	void sampleRateChange() override;
-	void modulate() override;
 	void processAll(const ProcessArgs& args) override;
+	void processStrips(Mix8ExpanderStrips& strips) override;
 };
 
 } // namespace bogaudio
@@ -5,10 +5,6 @@
 #define RELEASE_MS "release_ms"
 #define THRESHOLD_RANGE "threshold_range"
 
-void Nsgt::Engine::sampleRateChange() {
-	detector.setSampleRate(APP->engine->getSampleRate());
-}
-
 float Nsgt::ThresholdParamQuantity::getDisplayValue() {
 	float v = getValue();
 	if (!module) {
@@ -34,9 +30,7 @@ void Nsgt::ThresholdParamQuantity::setDisplayValue(float v) {
 }
 
 void Nsgt::sampleRateChange() {
-	for (int c = 0; c < _channels; ++c) {
-		_engines[c]->sampleRateChange();
-	}
+	_dynamics.setSampleRate(APP->engine->getSampleRate());
 }
 
 json_t* Nsgt::saveToJson(json_t* root) {
@@ -73,7 +67,7 @@ int Nsgt::channels() {
 
 void Nsgt::addChannel(int c) {
 	_engines[c] = new Engine();
-	_engines[c]->sampleRateChange();
+	_dynamics.reset(c);
 }
 
 void Nsgt::removeChannel(int c) {
@@ -82,19 +76,20 @@ void Nsgt::removeChannel(int c) {
 }
 
 void Nsgt::modulate() {
-	_softKnee = params[KNEE_PARAM].getValue() > 0.5f;
+	_dynamics.setSoftKnee(params[KNEE_PARAM].getValue() > 0.5f);
 }
 
 void Nsgt::modulateChannel(int c) {
 	Engine& e = *_engines[c];
 
-	e.thresholdDb = params[THRESHOLD_PARAM].getValue();
+	float thresholdDb = params[THRESHOLD_PARAM].getValue();
 	if (inputs[THRESHOLD_INPUT].isConnected()) {
-		e.thresholdDb *= clamp(inputs[THRESHOLD_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
+		thresholdDb *= clamp(inputs[THRESHOLD_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
 	}
-	e.thresholdDb *= 30.0f;
-	e.thresholdDb -= 24.0f;
-	e.thresholdDb *= _thresholdRange;
+	thresholdDb *= 30.0f;
+	thresholdDb -= 24.0f;
+	thresholdDb *= _thresholdRange;
+	_dynamics.setThreshold(c, thresholdDb);
 
 	float ratio = params[RATIO_PARAM].getValue();
 	if (inputs[RATIO_INPUT].isConnected()) {
@@ -109,37 +104,25 @@ void Nsgt::modulateChannel(int c) {
 		ratio = tanf(ratio);
 		ratio = 1.0f / ratio;
 		e.ratio = ratio;
+		_dynamics.setRatio(c, e.ratio);
 	}
 
-	float sr = APP->engine->getSampleRate();
-	e.attackSL.setParams(sr, _attackMs);
-	e.releaseSL.setParams(sr, _releaseMs);
+	_dynamics.setAttackRelease(c, _attackMs, _releaseMs);
 }
 
-void Nsgt::processChannel(const ProcessArgs& args, int c) {
-	Engine& e = *_engines[c];
-
-	float leftInput = inputs[LEFT_INPUT].getPolyVoltage(c);
-	float rightInput = inputs[RIGHT_INPUT].getPolyVoltage(c);
-	float env = e.detector.next(leftInput + rightInput);
-	if (env > e.lastEnv) {
-		env = e.attackSL.next(env, e.lastEnv);
-	}
-	else {
-		env = e.releaseSL.next(env, e.lastEnv);
-	}
-	e.lastEnv = env;
-
-	float detectorDb = amplitudeToDecibels(env / 5.0f);
-	float compressionDb = e.noiseGate.compressionDb(detectorDb, e.thresholdDb, e.ratio, _softKnee);
-	e.amplifier.setLevel(-compressionDb);
-	if (outputs[LEFT_OUTPUT].isConnected()) {
-		outputs[LEFT_OUTPUT].setChannels(_channels);
-		outputs[LEFT_OUTPUT].setVoltage(e.saturator.next(e.amplifier.next(leftInput)), c);
-	}
-	if (outputs[RIGHT_OUTPUT].isConnected()) {
-		outputs[RIGHT_OUTPUT].setChannels(_channels);
-		outputs[RIGHT_OUTPUT].setVoltage(e.saturator.next(e.amplifier.next(rightInput)), c);
+void Nsgt::processAll(const ProcessArgs& args) {
+	for (int c = 0, g = 0; c < _channels; c += laneWidth, ++g) {
+		lanes_t leftInput = getPolyLanes(inputs[LEFT_INPUT], c);
+		lanes_t rightInput = getPolyLanes(inputs[RIGHT_INPUT], c);
+		lanes_t level = _dynamics.next(g, leftInput + rightInput);
+		if (outputs[LEFT_OUTPUT].isConnected()) {
+			outputs[LEFT_OUTPUT].setChannels(_channels);
+			setLanes(outputs[LEFT_OUTPUT], _saturator.next(level * leftInput), c);
+		}
+		if (outputs[RIGHT_OUTPUT].isConnected()) {
+			outputs[RIGHT_OUTPUT].setChannels(_channels);
+			setLanes(outputs[RIGHT_OUTPUT], _saturator.next(level * rightInput), c);
+		}
 	}
 }
 
@@ -2,6 +2,7 @@
 
 #include "bogaudio.hpp"
 #include "dsp/filters/utility.hpp"
+#include "dsp/dynamics.hpp"
 #include "dsp/signal.hpp"
 
 using namespace bogaudio::dsp;
@@ -33,19 +34,8 @@ struct Nsgt : BGModule {
 	};
 
 	struct Engine {
-		float thresholdDb = 0.0f;
 		float ratio = 0.0f;
 		float ratioKnob = -1.0f;
-		float lastEnv = 0.0f;
-
-		bogaudio::dsp::SlewLimiter attackSL;
-		bogaudio::dsp::SlewLimiter releaseSL;
-		RootMeanSquare detector;
-		NoiseGate noiseGate;
-		Amplifier amplifier;
-		Saturator saturator;
-
-		void sampleRateChange();
 	};
 
 	static constexpr float defaultAttackMs = 150.0f;
@@ -54,7 +44,8 @@ struct Nsgt : BGModule {
 	static constexpr float maxReleaseMs = 2000.0f;
 
 	Engine* _engines[maxChannels] {};
-	bool _softKnee = true;
+	DynamicsProcessor _dynamics;
+	Saturator _saturator;
 	float _attackMs = defaultAttackMs;
 	float _releaseMs = defaultReleaseMs;
 	float _thresholdRange = 1.0f;
@@ -65,6 +56,7 @@ struct Nsgt : BGModule {
 	};
 
 	Nsgt() {
+		_dynamics.setMode(DynamicsProcessor::NOISE_GATE_MODE);
 		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS);
 		configParam<ThresholdParamQuantity>(THRESHOLD_PARAM, 0.0f, 1.0f, 0.8f, "Threshold", " dB");
 		configParam<DynamicsRatioParamQuantity>(RATIO_PARAM, 0.0f, 1.0f, 0.55159f, "Ratio");
@@ -90,7 +82,7 @@ struct Nsgt : BGModule {
 	void removeChannel(int c) override;
 	void modulate() override;
 	void modulateChannel(int c) override;
-	void processChannel(const ProcessArgs& args, int _c) override;
+	void processAll(const ProcessArgs& args) override;
 };
 
 } // namespace bogaudio
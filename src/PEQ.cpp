@@ -2,10 +2,7 @@
 #include "PEQ.hpp"
 
 void PEQ::sampleRateChange() {
-	float sr = APP->engine->getSampleRate();
-	for (int c = 0; c < _channels; ++c) {
-		_engines[c]->setSampleRate(sr);
-	}
+	_engine.setSampleRate(APP->engine->getSampleRate());
 }
 
 bool PEQ::active() {
@@ -17,40 +14,13 @@ int PEQ::channels() {
 }
 
 void PEQ::addChannel(int c) {
-	const int n = 3;
-	_engines[c] = new PEQEngine(n);
-	for (int i = 0; i < n; ++i) {
-		_engines[c]->configChannel(
-			i,
-			c,
-			params[A_LEVEL_PARAM + i*4],
-			params[A_FREQUENCY_PARAM + i*4],
-			params[A_CV_PARAM + i*4],
-			NULL,
-			params[A_BANDWIDTH_PARAM + i*4],
-			inputs[A_LEVEL_INPUT + i],
-			inputs[A_FREQUENCY_INPUT + i],
-			inputs[ALL_CV_INPUT],
-			&inputs[A_BANDWIDTH_INPUT + i]
-		);
-	}
-	_engines[c]->setSampleRate(APP->engine->getSampleRate());
-}
-
-void PEQ::removeChannel(int c) {
-	delete _engines[c];
-	_engines[c] = NULL;
+	_engine.reset(c);
 }
 
 void PEQ::modulate() {
-	auto lowMode = params[A_MODE_PARAM].getValue() > 0.5f ? MultimodeFilter::LOWPASS_MODE : MultimodeFilter::BANDPASS_MODE;
-	auto highMode = params[C_MODE_PARAM].getValue() > 0.5f ? MultimodeFilter::HIGHPASS_MODE : MultimodeFilter::BANDPASS_MODE;
-	for (int c = 0; c < _channels; ++c) {
-		PEQEngine& e = *_engines[c];
-		e.setLowFilterMode(lowMode);
-		e.setHighFilterMode(highMode);
-		e.modulate();
-	}
+	_engine.setLowFilterMode(params[A_MODE_PARAM].getValue() > 0.5f ? MultimodeFilter::LOWPASS_MODE : MultimodeFilter::BANDPASS_MODE);
+	_engine.setHighFilterMode(params[C_MODE_PARAM].getValue() > 0.5f ? MultimodeFilter::HIGHPASS_MODE : MultimodeFilter::BANDPASS_MODE);
+	_engine.modulate(_channels);
 }
 
 void PEQ::processAlways(const ProcessArgs& args) {
@@ -58,8 +28,11 @@ void PEQ::processAlways(const ProcessArgs& args) {
 	std::fill(_rmsSums, _rmsSums + 3, 0.0f);
 }
 
-void PEQ::processChannel(const ProcessArgs& args, int c) {
-	outputs[OUT_OUTPUT].setVoltage(_engines[c]->next(inputs[IN_INPUT].getVoltage(c), _rmsSums), c);
+void PEQ::processAll(const ProcessArgs& args) {
+	for (int c = 0; c < _channels; c += laneWidth) {
+		setLanes(outputs[OUT_OUTPUT], _engine.next(c / laneWidth, getPolyLanes(inputs[IN_INPUT], c)), c);
+	}
+	_engine.nextRms(_rmsSums);
 }
 
 void PEQ::postProcessAlways(const ProcessArgs& args) {
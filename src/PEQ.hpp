@@ -53,23 +53,23 @@ struct PEQ : BGModule {
 		NUM_LIGHTS
 	};
 
-	PEQEngine* _engines[maxChannels] {};
+	PEQEngine _engine;
 	float _rmsSums[3] {};
 
-	PEQ() {
+	PEQ() : _engine(3) {
 		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
-		float levelDefault = fabsf(PEQChannel::minDecibels) / (PEQChannel::maxDecibels - PEQChannel::minDecibels);
-		configParam(A_LEVEL_PARAM, 0.0f, 1.0f, levelDefault, "Channel A level", " dB", 0.0f, PEQChannel::maxDecibels - PEQChannel::minDecibels, PEQChannel::minDecibels);
-		configParam<ScaledSquaringParamQuantity<(int)PEQChannel::maxFrequency>>(A_FREQUENCY_PARAM, 0.0f, 1.0f, 0.0707107f, "Channel A frequency", " HZ");
+		float levelDefault = fabsf(PEQEngine::minDecibels) / (PEQEngine::maxDecibels - PEQEngine::minDecibels);
+		configParam(A_LEVEL_PARAM, 0.0f, 1.0f, levelDefault, "Channel A level", " dB", 0.0f, PEQEngine::maxDecibels - PEQEngine::minDecibels, PEQEngine::minDecibels);
+		configParam<ScaledSquaringParamQuantity<(int)PEQEngine::maxFrequency>>(A_FREQUENCY_PARAM, 0.0f, 1.0f, 0.0707107f, "Channel A frequency", " HZ");
 		configParam(A_BANDWIDTH_PARAM, 0.0f, 1.0f, 0.5f, "Channel A bandwidth", "%", 0.0f, 100.0f);
 		configParam(A_CV_PARAM, -1.0f, 1.0f, 0.0f, "Channel A frequency CV attenuation", "%", 0.0f, 100.0f);
 		configSwitch(A_MODE_PARAM, 0.0f, 1.0f, 1.0f, "Channel A LP/BP", {"Bandpass", "Lowpass"});
-		configParam(B_LEVEL_PARAM, 0.0f, 1.0f, levelDefault, "Channel B level", " dB", 0.0f, PEQChannel::maxDecibels - PEQChannel::minDecibels, PEQChannel::minDecibels);
-		configParam<ScaledSquaringParamQuantity<(int)PEQChannel::maxFrequency>>(B_FREQUENCY_PARAM, 0.0f, 1.0f, 0.1322876f, "Channel B frequency", " HZ");
+		configParam(B_LEVEL_PARAM, 0.0f, 1.0f, levelDefault, "Channel B level", " dB", 0.0f, PEQEngine::maxDecibels - PEQEngine::minDecibels, PEQEngine::minDecibels);
+		configParam<ScaledSquaringParamQuantity<(int)PEQEngine::maxFrequency>>(B_FREQUENCY_PARAM, 0.0f, 1.0f, 0.1322876f, "Channel B frequency", " HZ");
 		configParam(B_BANDWIDTH_PARAM, 0.0f, 1.0f, 0.66f, "Channel B bandwidth", "%", 0.0f, 100.0f);
 		configParam(B_CV_PARAM, -1.0f, 1.0f, 0.0f, "Channel B frequency CV attenuation", "%", 0.0f, 100.0f);
-		configParam(C_LEVEL_PARAM, 0.0f, 1.0f, levelDefault, "Channel C level", " dB", 0.0f, PEQChannel::maxDecibels - PEQChannel::minDecibels, PEQChannel::minDecibels);
-		configParam<ScaledSquaringParamQuantity<(int)PEQChannel::maxFrequency>>(C_FREQUENCY_PARAM, 0.0f, 1.0f, 0.223607f, "Channel C frequency", " HZ");
+		configParam(C_LEVEL_PARAM, 0.0f, 1.0f, levelDefault, "Channel C level", " dB", 0.0f, PEQEngine::maxDecibels - PEQEngine::minDecibels, PEQEngine::minDecibels);
+		configParam<ScaledSquaringParamQuantity<(int)PEQEngine::maxFrequency>>(C_FREQUENCY_PARAM, 0.0f, 1.0f, 0.223607f, "Channel C frequency", " HZ");
 		configParam(C_BANDWIDTH_PARAM, 0.0f, 1.0f, 0.5f, "Channel C bandwidth", "%", 0.0f, 100.0f);
 		configParam(C_CV_PARAM, -1.0f, 1.0f, 0.0f, "Channel C frequency CV attenuation", "%", 0.0f, 100.0f);
 		configSwitch(C_MODE_PARAM, 0.0f, 1.0f, 1.0f, "Channel C HP/BP", {"Bandpass", "Highpass"});
@@ -88,16 +88,30 @@ struct PEQ : BGModule {
 		configInput(IN_INPUT, "Signal");
 
 		configOutput(OUT_OUTPUT, "Signal");
+
+		for (int i = 0; i < 3; ++i) {
+			_engine.configBand(
+				i,
+				params[A_LEVEL_PARAM + i*4],
+				params[A_FREQUENCY_PARAM + i*4],
+				params[A_CV_PARAM + i*4],
+				NULL,
+				params[A_BANDWIDTH_PARAM + i*4],
+				inputs[A_LEVEL_INPUT + i],
+				inputs[A_FREQUENCY_INPUT + i],
+				inputs[ALL_CV_INPUT],
+				&inputs[A_BANDWIDTH_INPUT + i]
+			);
+		}
 	}
 
 	void sampleRateChange() override;
 	bool active() override;
 	int channels() override;
 	void addChannel(int c) override;
-	void removeChannel(int c) override;
 	void modulate() override;
 	void processAlways(const ProcessArgs& args) override;
-	void processChannel(const ProcessArgs& args, int c) override;
+	void processAll(const ProcessArgs& args) override;
 	void postProcessAlways(const ProcessArgs& args) override;
 };
 
@@ -2,10 +2,7 @@
 #include "PEQ14.hpp"
 
 void PEQ14::sampleRateChange() {
-	float sr = APP->engine->getSampleRate();
-	for (int c = 0; c < _channels; ++c) {
-		_engines[c]->setSampleRate(sr);
-	}
+	_engine.setSampleRate(APP->engine->getSampleRate());
 }
 
 bool PEQ14::active() {
@@ -35,29 +32,7 @@ int PEQ14::channels() {
 }
 
 void PEQ14::addChannel(int c) {
-	const int n = 14;
-	_engines[c] = new PEQEngine(n);
-	for (int i = 0; i < n; ++i) {
-		_engines[c]->configChannel(
-			i,
-			c,
-			params[LEVEL1_PARAM + i*3],
-			params[FREQUENCY1_PARAM + i*3],
-			params[FREQUENCY_CV1_PARAM + i*3],
-			&params[FREQUENCY_CV_PARAM],
-			params[BANDWIDTH_PARAM],
-			inputs[LEVEL1_INPUT + i*2],
-			inputs[FREQUENCY_CV1_INPUT + i*2],
-			inputs[FREQUENCY_CV_INPUT],
-			&inputs[BANDWIDTH_INPUT]
-		);
-	}
-	_engines[c]->setSampleRate(APP->engine->getSampleRate());
-}
-
-void PEQ14::removeChannel(int c) {
-	delete _engines[c];
-	_engines[c] = NULL;
+	_engine.reset(c);
 }
 
 void PEQ14::modulate() {
@@ -65,13 +40,11 @@ void PEQ14::modulate() {
 
 	_lowMode = params[LP_PARAM].getValue() > 0.5f ? MultimodeFilter::LOWPASS_MODE : MultimodeFilter::BANDPASS_MODE;
 	_highMode = params[HP_PARAM].getValue() > 0.5f ? MultimodeFilter::HIGHPASS_MODE : MultimodeFilter::BANDPASS_MODE;
-	for (int c = 0; c < _channels; ++c) {
-		PEQEngine& e = *_engines[c];
-		e.setLowFilterMode(_lowMode);
-		e.setHighFilterMode(_highMode);
-		e.setFrequencyMode(_fullFrequencyMode);
-		e.modulate();
-	}
+	_engine.setLowFilterMode(_lowMode);
+	_engine.setHighFilterMode(_highMode);
+	_engine.setFrequencyMode(_fullFrequencyMode);
+	_engine.modulate(_channels);
+	_modulated = true;
 }
 
 void PEQ14::processAlways(const ProcessArgs& args) {
@@ -84,48 +57,78 @@ void PEQ14::processAlways(const ProcessArgs& args) {
 	std::fill(_rmsSums, _rmsSums + 14, 0.0f);
 }
 
-void PEQ14::processChannel(const ProcessArgs& args, int c) {
-	PEQEngine& e = *_engines[c];
-	float out = e.next(inputs[IN_INPUT].getVoltage(c), _rmsSums);
-	float oddOut = 0.0f;
-	float evenOut = 0.0f;
-	float beOut = 0.0f;
-	float beOddOut = 0.0f;
-	float beEvenOut = 0.0f;
+void PEQ14::processAll(const ProcessArgs& args) {
+	float oddWeights[14];
+	float evenWeights[14];
 	for (int i = 0; i < 14; ++i) {
-		float odd = e.outs[i] * (float)(i % 2 == 0 || (i == 13 && _highMode == MultimodeFilter::HIGHPASS_MODE));
-		oddOut += odd;
-		float even = e.outs[i] * (float)(i % 2 == 1 || (i == 0 && _lowMode == MultimodeFilter::LOWPASS_MODE));
-		evenOut += even;
-		if (outputs[OUT1_OUTPUT + i].isConnected()) {
-			outputs[OUT1_OUTPUT + i].setVoltage(e.outs[i], c);
-		}
-		else {
-			beOut += e.outs[i];
-			beOddOut += odd;
-			beEvenOut += even;
-		}
-	}
-	if (_bandExclude) {
-		outputs[OUT_OUTPUT].setVoltage(beOut, c);
-		outputs[ODDS_OUTPUT].setVoltage(beOddOut, c);
-		outputs[EVENS_OUTPUT].setVoltage(beEvenOut, c);
-	}
-	else {
-		outputs[OUT_OUTPUT].setVoltage(out, c);
-		outputs[ODDS_OUTPUT].setVoltage(oddOut, c);
-		outputs[EVENS_OUTPUT].setVoltage(evenOut, c);
+		oddWeights[i] = (float)(i % 2 == 0 || (i == 13 && _highMode == MultimodeFilter::HIGHPASS_MODE));
+		evenWeights[i] = (float)(i % 2 == 1 || (i == 0 && _lowMode == MultimodeFilter::LOWPASS_MODE));
 	}
 
+	PEQ14ExpanderMessage* m = NULL;
 	if (expanderConnected()) {
-		auto m = toExpander();
+		m = toExpander();
 		m->valid = true;
-		std::copy(e.outs, e.outs + 14, m->outs[c]);
-		std::copy(e.frequencies, e.frequencies + 14, m->frequencies[c]);
-		m->bandwidths[c] = e.bandwidth;
 		m->lowLP = _lowMode == MultimodeFilter::LOWPASS_MODE;
 		m->highHP = _highMode == MultimodeFilter::HIGHPASS_MODE;
+		std::fill(m->designsChanged, m->designsChanged + PEQEngine::maxGroups, 0);
+		if (_modulated) {
+			for (int g = 0, groups = laneGroups(_channels); g < groups; ++g) {
+				m->designsChanged[g] = _engine.designsChanged(g);
+				for (int i = 0; i < 14; ++i) {
+					if (m->designsChanged[g] & (1 << i)) {
+						_engine.filterDesign(g, i, m->designs[g][i]);
+					}
+				}
+			}
+		}
+	}
+	_modulated = false;
+
+	for (int c = 0, g = 0; c < _channels; c += laneWidth, ++g) {
+		lanes_t out = _engine.next(g, getPolyLanes(inputs[IN_INPUT], c));
+		lanes_t oddOut = 0.0f;
+		lanes_t evenOut = 0.0f;
+		lanes_t beOut = 0.0f;
+		lanes_t beOddOut = 0.0f;
+		lanes_t beEvenOut = 0.0f;
+		for (int i = 0; i < 14; ++i) {
+			const lanes_t& o = _engine.out(g, i);
+			lanes_t odd = oddWeights[i] * o;
+			oddOut += odd;
+			lanes_t even = evenWeights[i] * o;
+			evenOut += even;
+			if (outputs[OUT1_OUTPUT + i].isConnected()) {
+				setLanes(outputs[OUT1_OUTPUT + i], o, c);
+			}
+			else {
+				beOut += o;
+				beOddOut += odd;
+				beEvenOut += even;
+			}
+		}
+		if (_bandExclude) {
+			setLanes(outputs[OUT_OUTPUT], beOut, c);
+			setLanes(outputs[ODDS_OUTPUT], beOddOut, c);
+			setLanes(outputs[EVENS_OUTPUT], beEvenOut, c);
+		}
+		else {
+			setLanes(outputs[OUT_OUTPUT], out, c);
+			setLanes(outputs[ODDS_OUTPUT], oddOut, c);
+			setLanes(outputs[EVENS_OUTPUT], evenOut, c);
+		}
+
+		if (m) {
+			for (int l = 0; l < laneWidth && c + l < _channels; ++l) {
+				for (int i = 0; i < 14; ++i) {
+					m->outs[c + l][i] = lanes::get(_engine.out(g, i), l);
+					m->frequencies[c + l][i] = lanes::get(_engine.frequency(g, i), l);
+				}
+				m->bandwidths[c + l] = lanes::get(_engine.bandwidth(g), l);
+			}
+		}
 	}
+	_engine.nextRms(_rmsSums);
 }
 
 void PEQ14::postProcessAlways(const ProcessArgs& args) {
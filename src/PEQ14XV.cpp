@@ -2,27 +2,23 @@
 #include "PEQ14XV.hpp"
 #include "dsp/pitch.hpp"
 
-PEQ14XV::Engine::Engine() {
-	filters[0] = new MultimodeFilter8();
-	for (int i = 1; i < 13; ++i) {
-		filters[i] = new MultimodeFilter4();
-	}
-	filters[13] = new MultimodeFilter8();
-}
-
-PEQ14XV::Engine::~Engine() {
-	for (int i = 0; i < 14; ++i) {
-		delete filters[i];
-	}
-}
-
 void PEQ14XV::addChannel(int c) {
 	_engines[c] = new Engine();
+	if (c % laneWidth == 0) {
+		_groups[c / laneWidth] = new Group();
+	}
+	else {
+		_groups[c / laneWidth]->reset(c % laneWidth);
+	}
 }
 
 void PEQ14XV::removeChannel(int c) {
 	delete _engines[c];
 	_engines[c] = NULL;
+	if (c % laneWidth == 0) {
+		delete _groups[c / laneWidth];
+		_groups[c / laneWidth] = NULL;
+	}
 }
 
 void PEQ14XV::modulate() {
@@ -41,17 +37,19 @@ void PEQ14XV::modulate() {
 
 void PEQ14XV::modulateChannel(int c) {
 	Engine& e = *_engines[c];
+	Group& g = *_groups[c / laneWidth];
 
 	float sr = APP->engine->getSampleRate();
 	float response = sensitivity(params[EF_DAMP_PARAM], &inputs[EF_DAMP_INPUT], c);
 	if (e.response != response) {
 		e.response = response;
 		for (int i = 0; i < 14; ++i) {
-			e.efs[i].setParams(sr, e.response);
+			g.efs[i].setParams(c % laneWidth, sr, e.response);
 		}
 	}
 
 	e.efGain.setLevel(gain(params[EF_GAIN_PARAM], &inputs[EF_GAIN_INPUT], c));
+	lanes::set(g.efGains, c % laneWidth, e.efGain._level);
 
 	float transpose = clamp(params[TRANSPOSE_PARAM].getValue(), -1.0f, 1.0f);
 	if (inputs[TRANSPOSE_INPUT].isConnected()) {
@@ -83,37 +81,67 @@ void PEQ14XV::processAlways(const ProcessArgs& args) {
 
 void PEQ14XV::processChannel(const ProcessArgs& args, int c) {
 	if (_baseMessage && _baseMessage->valid) {
-		Engine& e = *_engines[c];
-		float in = inputs[IN_INPUT].getPolyVoltage(c);
-		float out = 0.0f;
-		float odds = 0.0f;
-		float evens = 0.0f;
-		for (int i = 0; i < 14; ++i) {
-			auto mode = MultimodeFilter::BANDPASS_MODE;
-			int poles = 4;
-			float bandwidth = _baseMessage->bandwidths[c];
-			if (i == 0 && _baseMessage->lowLP) {
-				mode = MultimodeFilter::LOWPASS_MODE;
-				poles = 12;
-				bandwidth = MultimodeFilter::minQbw;
-			}
-			if (i == 13 && _baseMessage->highHP) {
-				mode = MultimodeFilter::HIGHPASS_MODE;
-				poles = 12;
-				bandwidth = MultimodeFilter::minQbw;
-			}
-			float f = _baseMessage->frequencies[c][i];
-			if (e.transposeSemitones > 0.01f || e.transposeSemitones < -0.01f) {
-				f = frequencyToSemitone(f);
-				f += e.transposeSemitones;
-				f = semitoneToFrequency(f);
-			}
-			if (f < MultimodeFilter::minFrequency || f > MultimodeFilter::maxFrequency) {
-				continue;
-			}
+		design(*_engines[c], *_groups[c / laneWidth], c);
+	}
+}
+
+// Redesigns the bands of channel c whose base frequency has changed, or all of
+// them if anything else they depend on has; the envelope scaling and whether
+// the band is in range are worked out along with the filter.  Untransposed,
+// a band is the base's, so its design is taken from the base when the base
+// has sent it.
+void PEQ14XV::design(Engine& e, Group& g, int c) {
+	int lane = c % laneWidth;
+	float sr = APP->engine->getSampleRate();
+	float baseBandwidth = _baseMessage->bandwidths[c];
+	bool all = e.bandwidth != baseBandwidth || e.designedTranspose != e.transposeSemitones || e.lowLP != _baseMessage->lowLP || e.highHP != _baseMessage->highHP || e.sampleRate != sr;
+	e.bandwidth = baseBandwidth;
+	e.designedTranspose = e.transposeSemitones;
+	e.lowLP = _baseMessage->lowLP;
+	e.highHP = _baseMessage->highHP;
+	e.sampleRate = sr;
+
+	for (int i = 0; i < 14; ++i) {
+		float baseFrequency = _baseMessage->frequencies[c][i];
+		if (!all && e.baseFrequencies[i] == baseFrequency) {
+			continue;
+		}
+		e.baseFrequencies[i] = baseFrequency;
 
-			e.filters[i]->setParams(
-				APP->engine->getSampleRate(),
+		auto mode = MultimodeFilter::BANDPASS_MODE;
+		int poles = 4;
+		float bandwidth = baseBandwidth;
+		if (i == 0 && e.lowLP) {
+			mode = MultimodeFilter::LOWPASS_MODE;
+			poles = 12;
+			bandwidth = MultimodeFilter::minQbw;
+		}
+		if (i == 13 && e.highHP) {
+			mode = MultimodeFilter::HIGHPASS_MODE;
+			poles = 12;
+			bandwidth = MultimodeFilter::minQbw;
+		}
+		float f = baseFrequency;
+		bool transposed = e.transposeSemitones > 0.01f || e.transposeSemitones < -0.01f;
+		if (transposed) {
+			f = frequencyToSemitone(f);
+			f += e.transposeSemitones;
+			f = semitoneToFrequency(f);
+		}
+		if (f < MultimodeFilter::minFrequency || f > MultimodeFilter::maxFrequency) {
+			lanes::set(g.actives[i], lane, 0.0f);
+			continue;
+		}
+		lanes::set(g.actives[i], lane, 1.0f);
+
+		if (!transposed && (_baseMessage->designsChanged[c / laneWidth] & (1 << i))) {
+			g.bank.setDesign(i, lane, _baseMessage->designs[c / laneWidth][i]);
+		}
+		else {
+			g.bank.setParams(
+				i,
+				lane,
+				sr,
 				MultimodeFilter::BUTTERWORTH_TYPE,
 				poles,
 				mode,
@@ -121,37 +149,66 @@ void PEQ14XV::processChannel(const ProcessArgs& args, int c) {
 				bandwidth,
 				MultimodeFilter::PITCH_BANDWIDTH_MODE
 			);
+		}
+		lanes::set(g.scales[i], lane, scaleEF(1.0f, baseFrequency, baseBandwidth));
+	}
+}
+
+// The bands run after the channel loop, a lane group at a time.  A band's
+// level follows the envelope of the matching base band; bands out of range
+// have a zero active factor, and contribute nothing.
+void PEQ14XV::postProcess(const ProcessArgs& args) {
+	if (!_baseMessage || !_baseMessage->valid) {
+		for (int c = 0; c < _channels; c += laneWidth) {
+			setLanes(outputs[OUT_OUTPUT], 0.0f, c);
+			setLanes(outputs[ODDS_OUTPUT], 0.0f, c);
+			setLanes(outputs[EVENS_OUTPUT], 0.0f, c);
+		}
+		return;
+	}
+
+	float outWeights[14];
+	float oddsWeights[14];
+	float evensWeights[14];
+	for (int i = 0; i < 14; ++i) {
+		outWeights[i] = (float)((i != 0 || _band1Enable) && (i != 13 || _band14Enable));
+		oddsWeights[i] = (float)(i % 2 == 0 && (i != 0 || _band1Enable));
+		evensWeights[i] = (float)(i % 2 == 1 && (i != 13 || _band14Enable));
+	}
 
-			float level = e.efs[i].next(_baseMessage->outs[c][i]);
-			level = scaleEF(level, _baseMessage->frequencies[c][i], _baseMessage->bandwidths[c]);
-			level = e.efGain.next(level);
-			level *= 0.1f;
-			level = std::max(0.0f, std::min(1.0f, level));
-			level = 1.0f - level;
-			level *= Amplifier::minDecibels;
-			e.amplifiers[i].setLevel(level);
-
-			float o = e.amplifiers[i].next(e.filters[i]->next(in));
-			o = _outputGain.next(o);
-			out += (float)((i != 0 || _band1Enable) && (i != 13 || _band14Enable)) * o;
-			odds += (float)(i % 2 == 0 && (i != 0 || _band1Enable)) * o;
-			evens += (float)(i % 2 == 1 && (i != 13 || _band14Enable)) * o;
+	for (int c = 0; c < _channels; c += laneWidth) {
+		Group& g = *_groups[c / laneWidth];
+		int n = std::min(laneWidth, _channels - c);
+		lanes_t in = getPolyLanes(inputs[IN_INPUT], c);
+		lanes_t out = 0.0f;
+		lanes_t odds = 0.0f;
+		lanes_t evens = 0.0f;
+		lanes_t baseOut = 0.0f;
+		for (int i = 0; i < 14; ++i) {
+			for (int l = 0; l < n; ++l) {
+				lanes::set(baseOut, l, _baseMessage->outs[c + l][i]);
+			}
+
+			lanes_t level = g.efs[i].next(baseOut);
+			level = level * g.scales[i] * g.efGains * 0.1f;
+			level = lanes::fmax(0.0f, lanes::fmin(1.0f, level));
+			level = DynamicsProcessor::decibelsToLevel((1.0f - level) * Amplifier::minDecibels);
+
+			lanes_t o = g.actives[i] * level * g.bank.next(i, in);
+			o = _outputGain._level * o;
+			out += outWeights[i] * o;
+			odds += oddsWeights[i] * o;
+			evens += evensWeights[i] * o;
 		}
 
-		float band14raw = _baseMessage->outs[c][13];
-		band14raw = _band14Mix.next(band14raw);
+		lanes_t band14raw = _band14Mix._level * baseOut;
 		out += band14raw;
 		odds += band14raw;
 		evens += band14raw;
 
-		outputs[OUT_OUTPUT].setVoltage(_saturator.next(out), c);
-		outputs[ODDS_OUTPUT].setVoltage(_saturator.next(odds), c);
-		outputs[EVENS_OUTPUT].setVoltage(_saturator.next(evens), c);
-	}
-	else {
-		outputs[OUT_OUTPUT].setVoltage(0.0f, c);
-		outputs[ODDS_OUTPUT].setVoltage(0.0f, c);
-		outputs[EVENS_OUTPUT].setVoltage(0.0f, c);
+		setLanes(outputs[OUT_OUTPUT], _saturator.next(out), c);
+		setLanes(outputs[ODDS_OUTPUT], _saturator.next(odds), c);
+		setLanes(outputs[EVENS_OUTPUT], _saturator.next(evens), c);
 	}
 }
 
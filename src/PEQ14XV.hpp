@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PEQ14_shared.hpp"
+#include "dsp/dynamics.hpp"
 
 namespace bogaudio {
 
@@ -31,21 +32,55 @@ struct PEQ14XV : ExpanderModule<PEQ14ExpanderMessage, ExpandableModule<PEQ14Expa
 		NUM_OUTPUTS
 	};
 
+	// per channel: the modulated follower settings, and what each band was
+	// last designed for, so the bank is only redesigned on change.
 	struct Engine {
-		MultimodeFilter* filters[14] {};
-		Amplifier amplifiers[14];
-		EnvelopeFollower efs[14];
 		float response = -1.0f;
 		Amplifier efGain;
 		float transposeSemitones = 0.0f;
+		float baseFrequencies[14];
+		float bandwidth = -1.0f;
+		float sampleRate = -1.0f;
+		float designedTranspose = 0.0f;
+		bool lowLP = false;
+		bool highHP = false;
 
-		Engine();
-		~Engine();
+		Engine() {
+			std::fill(baseFrequencies, baseFrequencies + 14, -1.0f);
+		}
+	};
+
+	// per lane group: the vocoder's 14 bands and their envelope followers,
+	// for laneWidth channels at once.
+	struct Group {
+		MultimodeBankLanes bank;
+		EnvelopeFollowerLanes efs[14];
+		lanes_t scales[14];
+		lanes_t actives[14];
+		lanes_t efGains = 0.0f;
+
+		Group() : bank(14) {
+			std::fill(scales, scales + 14, lanes_t(0.0f));
+			std::fill(actives, actives + 14, lanes_t(0.0f));
+		}
+
+		// clears a lane for a new channel, as a new group would have it.
+		void reset(int lane) {
+			for (int i = 0; i < 14; ++i) {
+				bank.reset(i, lane);
+				efs[i].reset(lane);
+				lanes::set(scales[i], lane, 0.0f);
+				lanes::set(actives[i], lane, 0.0f);
+			}
+			lanes::set(efGains, lane, 0.0f);
+		}
 	};
 
 	static constexpr float maxOutputGain = 24.0f;
+	static constexpr int maxGroups = maxChannels / laneWidth;
 
 	Engine* _engines[maxChannels] {};
+	Group* _groups[maxGroups] {};
 	Amplifier _outputGain;
 	Amplifier _band14Mix;
 	bool _band1Enable = true;
@@ -82,6 +117,8 @@ struct PEQ14XV : ExpanderModule<PEQ14ExpanderMessage, ExpandableModule<PEQ14Expa
 	void modulateChannel(int c) override;
 	void processAlways(const ProcessArgs& args) override;
 	void processChannel(const ProcessArgs& args, int c) override;
+	void postProcess(const ProcessArgs& args) override;
+	void design(Engine& e, Group& g, int c);
 };
 
 } // namespace bogaudio
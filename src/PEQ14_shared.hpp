@@ -18,6 +18,11 @@ struct PEQ14ExpanderMessage : ExpanderMessage {
 	float bandwidths[BGModule::maxChannels];
 	bool lowLP = false;
 	bool highHP = false;
+	// the base's band filters, by lane group, for expanders running the same
+	// bands; a group's designs are only sent for the bands set in its
+	// designsChanged, those the base redesigned on this sample.
+	uint32_t designsChanged[PEQEngine::maxGroups];
+	MultimodeBankLanes::Design designs[PEQEngine::maxGroups][14];
 
 	PEQ14ExpanderMessage() {
 		reset();
@@ -31,6 +36,7 @@ struct PEQ14ExpanderMessage : ExpanderMessage {
 		std::fill((float*)bandwidths, (float*)bandwidths + BGModule::maxChannels, 0.0f);
 		lowLP = false;
 		highHP = false;
+		std::fill(designsChanged, designsChanged + PEQEngine::maxGroups, 0);
 	}
 
 	void copyTo(PEQ14ExpanderMessage* o) {
@@ -41,6 +47,14 @@ struct PEQ14ExpanderMessage : ExpanderMessage {
 		std::copy((float*)bandwidths, (float*)bandwidths + BGModule::maxChannels, (float*)o->bandwidths);
 		o->lowLP = lowLP;
 		o->highHP = highHP;
+		std::copy(designsChanged, designsChanged + PEQEngine::maxGroups, o->designsChanged);
+		for (int g = 0; g < PEQEngine::maxGroups; ++g) {
+			for (int i = 0; i < 14; ++i) {
+				if (designsChanged[g] & (1 << i)) {
+					o->designs[g][i] = designs[g][i];
+				}
+			}
+		}
 	}
 };
 
@@ -2,10 +2,7 @@
 #include "PEQ6.hpp"
 
 void PEQ6::sampleRateChange() {
-	float sr = APP->engine->getSampleRate();
-	for (int c = 0; c < _channels; ++c) {
-		_engines[c]->setSampleRate(sr);
-	}
+	_engine.setSampleRate(APP->engine->getSampleRate());
 }
 
 bool PEQ6::active() {
@@ -25,43 +22,16 @@ int PEQ6::channels() {
 }
 
 void PEQ6::addChannel(int c) {
-	const int n = 6;
-	_engines[c] = new PEQEngine(n);
-	for (int i = 0; i < n; ++i) {
-		_engines[c]->configChannel(
-			i,
-			c,
-			params[LEVEL1_PARAM + i*3],
-			params[FREQUENCY1_PARAM + i*3],
-			params[FREQUENCY_CV1_PARAM + i*3],
-			&params[FREQUENCY_CV_PARAM],
-			params[BANDWIDTH_PARAM],
-			inputs[LEVEL1_INPUT + i*2],
-			inputs[FREQUENCY_CV1_INPUT + i*2],
-			inputs[FREQUENCY_CV_INPUT],
-			&inputs[BANDWIDTH_INPUT]
-		);
-	}
-	_engines[c]->setSampleRate(APP->engine->getSampleRate());
-}
-
-void PEQ6::removeChannel(int c) {
-	delete _engines[c];
-	_engines[c] = NULL;
+	_engine.reset(c);
 }
 
 void PEQ6::modulate() {
 	_fullFrequencyMode = params[FMOD_PARAM].getValue() > 0.5f;
 
-	auto lowMode = params[LP_PARAM].getValue() > 0.5f ? MultimodeFilter::LOWPASS_MODE : MultimodeFilter::BANDPASS_MODE;
-	auto highMode = params[HP_PARAM].getValue() > 0.5f ? MultimodeFilter::HIGHPASS_MODE : MultimodeFilter::BANDPASS_MODE;
-	for (int c = 0; c < _channels; ++c) {
-		PEQEngine& e = *_engines[c];
-		e.setLowFilterMode(lowMode);
-		e.setHighFilterMode(highMode);
-		e.setFrequencyMode(_fullFrequencyMode);
-		e.modulate();
-	}
+	_engine.setLowFilterMode(params[LP_PARAM].getValue() > 0.5f ? MultimodeFilter::LOWPASS_MODE : MultimodeFilter::BANDPASS_MODE);
+	_engine.setHighFilterMode(params[HP_PARAM].getValue() > 0.5f ? MultimodeFilter::HIGHPASS_MODE : MultimodeFilter::BANDPASS_MODE);
+	_engine.setFrequencyMode(_fullFrequencyMode);
+	_engine.modulate(_channels);
 }
 
 void PEQ6::processAlways(const ProcessArgs& args) {
@@ -77,30 +47,36 @@ void PEQ6::processAlways(const ProcessArgs& args) {
 	}
 }
 
-void PEQ6::processChannel(const ProcessArgs& args, int c) {
-	PEQEngine& e = *_engines[c];
-	float out = e.next(inputs[IN_INPUT].getVoltage(c), _rmsSums);
-	float beOut = 0.0f;
-	for (int i = 0; i < 6; ++i) {
-		if (outputs[OUT1_OUTPUT + i].isConnected()) {
-			outputs[OUT1_OUTPUT + i].setVoltage(e.outs[i], c);
+void PEQ6::processAll(const ProcessArgs& args) {
+	for (int c = 0, g = 0; c < _channels; c += laneWidth, ++g) {
+		lanes_t out = _engine.next(g, getPolyLanes(inputs[IN_INPUT], c));
+		lanes_t beOut = 0.0f;
+		for (int i = 0; i < 6; ++i) {
+			if (outputs[OUT1_OUTPUT + i].isConnected()) {
+				setLanes(outputs[OUT1_OUTPUT + i], _engine.out(g, i), c);
+			}
+			else {
+				beOut += _engine.out(g, i);
+			}
+		}
+		if (_bandExclude) {
+			setLanes(outputs[OUT_OUTPUT], beOut, c);
 		}
 		else {
-			beOut += e.outs[i];
+			setLanes(outputs[OUT_OUTPUT], out, c);
 		}
-	}
-	if (_bandExclude) {
-		outputs[OUT_OUTPUT].setVoltage(beOut, c);
-	}
-	else {
-		outputs[OUT_OUTPUT].setVoltage(out, c);
-	}
 
-	if (_expanderMessage) {
-		std::copy(e.outs, e.outs + 6, _expanderMessage->outs[c]);
-		std::copy(e.frequencies, e.frequencies + 6, _expanderMessage->frequencies[c]);
-		_expanderMessage->bandwidths[c] = e.bandwidth;
+		if (_expanderMessage) {
+			for (int l = 0; l < laneWidth && c + l < _channels; ++l) {
+				for (int i = 0; i < 6; ++i) {
+					_expanderMessage->outs[c + l][i] = lanes::get(_engine.out(g, i), l);
+					_expanderMessage->frequencies[c + l][i] = lanes::get(_engine.frequency(g, i), l);
+				}
+				_expanderMessage->bandwidths[c + l] = lanes::get(_engine.bandwidth(g), l);
+			}
+		}
 	}
+	_engine.nextRms(_rmsSums);
 }
 
 void PEQ6::postProcessAlways(const ProcessArgs& args) {
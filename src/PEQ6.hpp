@@ -68,37 +68,37 @@ struct PEQ6 : ExpandableModule<PEQ6ExpanderMessage, BandExcludeModule> {
 		NUM_LIGHTS
 	};
 
-	PEQEngine* _engines[maxChannels] {};
+	PEQEngine _engine;
 	float _rmsSums[6] {};
 	float _rms[6] {};
 	bool _fullFrequencyMode = false;
 	PEQ6ExpanderMessage* _expanderMessage = NULL;
 
-	PEQ6() {
+	PEQ6() : _engine(6) {
 		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
-		float levelDefault = fabsf(PEQChannel::minDecibels) / (PEQChannel::maxDecibels - PEQChannel::minDecibels);
+		float levelDefault = fabsf(PEQEngine::minDecibels) / (PEQEngine::maxDecibels - PEQEngine::minDecibels);
 		configParam(FREQUENCY_CV_PARAM, -1.0f, 1.0f, 0.0f, "Global frequency CV attenuation", "%", 0.0f, 100.0f);
 		configParam(BANDWIDTH_PARAM, 0.0f, 1.0f, 0.33f, "Bandwidth", "%", 0.0f, 100.0f);
 		configSwitch(LP_PARAM, 0.0f, 1.0f, 1.0f, "Channel 1 LP/BP", {"Bandpass", "Lowpass"});
 		configSwitch(HP_PARAM, 0.0f, 1.0f, 1.0f, "Channel 6 HP/BP", {"Bandpass", "Highpass"});
 		configSwitch(FMOD_PARAM, 0.0f, 1.0f, 0.0f, "Frequency modulation range", {"Octave", "Full"});
-		configParam(LEVEL1_PARAM, 0.0f, 1.0f, levelDefault, "Channel 1 level", " dB", 0.0f, PEQChannel::maxDecibels - PEQChannel::minDecibels, PEQChannel::minDecibels);
-		configParam<ScaledSquaringParamQuantity<(int)PEQChannel::maxFrequency>>(FREQUENCY1_PARAM, 0.0f, 1.0f, 0.0707107f, "Channel 1 frequency", " HZ");
+		configParam(LEVEL1_PARAM, 0.0f, 1.0f, levelDefault, "Channel 1 level", " dB", 0.0f, PEQEngine::maxDecibels - PEQEngine::minDecibels, PEQEngine::minDecibels);
+		configParam<ScaledSquaringParamQuantity<(int)PEQEngine::maxFrequency>>(FREQUENCY1_PARAM, 0.0f, 1.0f, 0.0707107f, "Channel 1 frequency", " HZ");
 		configParam(FREQUENCY_CV1_PARAM, -1.0f, 1.0f, 1.0f, "Channel 1 frequency CV attenuation", "%", 0.0f, 100.0f);
-		configParam(LEVEL2_PARAM, 0.0f, 1.0f, levelDefault, "Channel 2 level", " dB", 0.0f, PEQChannel::maxDecibels - PEQChannel::minDecibels, PEQChannel::minDecibels);
-		configParam<ScaledSquaringParamQuantity<(int)PEQChannel::maxFrequency>>(FREQUENCY2_PARAM, 0.0f, 1.0f, 0.0935414f, "Channel 2 frequency", " HZ");
+		configParam(LEVEL2_PARAM, 0.0f, 1.0f, levelDefault, "Channel 2 level", " dB", 0.0f, PEQEngine::maxDecibels - PEQEngine::minDecibels, PEQEngine::minDecibels);
+		configParam<ScaledSquaringParamQuantity<(int)PEQEngine::maxFrequency>>(FREQUENCY2_PARAM, 0.0f, 1.0f, 0.0935414f, "Channel 2 frequency", " HZ");
 		configParam(FREQUENCY_CV2_PARAM, -1.0f, 1.0f, 1.0f, "Channel 2 frequency CV attenuation", "%", 0.0f, 100.0f);
-		configParam(LEVEL3_PARAM, 0.0f, 1.0f, levelDefault, "Channel 3 level", " dB", 0.0f, PEQChannel::maxDecibels - PEQChannel::minDecibels, PEQChannel::minDecibels);
-		configParam<ScaledSquaringParamQuantity<(int)PEQChannel::maxFrequency>>(FREQUENCY3_PARAM, 0.0f, 1.0f, 0.1322876f, "Channel 3 frequency", " HZ");
+		configParam(LEVEL3_PARAM, 0.0f, 1.0f, levelDefault, "Channel 3 level", " dB", 0.0f, PEQEngine::maxDecibels - PEQEngine::minDecibels, PEQEngine::minDecibels);
+		configParam<ScaledSquaringParamQuantity<(int)PEQEngine::maxFrequency>>(FREQUENCY3_PARAM, 0.0f, 1.0f, 0.1322876f, "Channel 3 frequency", " HZ");
 		configParam(FREQUENCY_CV3_PARAM, -1.0f, 1.0f, 1.0f, "Channel 3 frequency CV attenuation", "%", 0.0f, 100.0f);
-		configParam(LEVEL4_PARAM, 0.0f, 1.0f, levelDefault, "Channel 4 level", " dB", 0.0f, PEQChannel::maxDecibels - PEQChannel::minDecibels, PEQChannel::minDecibels);
-		configParam<ScaledSquaringParamQuantity<(int)PEQChannel::maxFrequency>>(FREQUENCY4_PARAM, 0.0f, 1.0f, 0.1870829f, "Channel 4 frequency", " HZ");
+		configParam(LEVEL4_PARAM, 0.0f, 1.0f, levelDefault, "Channel 4 level", " dB", 0.0f, PEQEngine::maxDecibels - PEQEngine::minDecibels, PEQEngine::minDecibels);
+		configParam<ScaledSquaringParamQuantity<(int)PEQEngine::maxFrequency>>(FREQUENCY4_PARAM, 0.0f, 1.0f, 0.1870829f, "Channel 4 frequency", " HZ");
 		configParam(FREQUENCY_CV4_PARAM, -1.0f, 1.0f, 1.0f, "Channel 4 frequency CV attenuation", "%", 0.0f, 100.0f);
-		configParam(LEVEL5_PARAM, 0.0f, 1.0f, levelDefault, "Channel 5 level", " dB", 0.0f, PEQChannel::maxDecibels - PEQChannel::minDecibels, PEQChannel::minDecibels);
-		configParam<ScaledSquaringParamQuantity<(int)PEQChannel::maxFrequency>>(FREQUENCY5_PARAM, 0.0f, 1.0f, 0.2645751f, "Channel 5 frequency", " HZ");
+		configParam(LEVEL5_PARAM, 0.0f, 1.0f, levelDefault, "Channel 5 level", " dB", 0.0f, PEQEngine::maxDecibels - PEQEngine::minDecibels, PEQEngine::minDecibels);
+		configParam<ScaledSquaringParamQuantity<(int)PEQEngine::maxFrequency>>(FREQUENCY5_PARAM, 0.0f, 1.0f, 0.2645751f, "Channel 5 frequency", " HZ");
 		configParam(FREQUENCY_CV5_PARAM, -1.0f, 1.0f, 1.0f, "Channel 5 frequency CV attenuation", "%", 0.0f, 100.0f);
-		configParam(LEVEL6_PARAM, 0.0f, 1.0f, levelDefault, "Channel 6 level", " dB", 0.0f, PEQChannel::maxDecibels - PEQChannel::minDecibels, PEQChannel::minDecibels);
-		configParam<ScaledSquaringParamQuantity<(int)PEQChannel::maxFrequency>>(FREQUENCY6_PARAM, 0.0f, 1.0f, 0.3535534f, "Channel 6 frequency", " HZ");
+		configParam(LEVEL6_PARAM, 0.0f, 1.0f, levelDefault, "Channel 6 level", " dB", 0.0f, PEQEngine::maxDecibels - PEQEngine::minDecibels, PEQEngine::minDecibels);
+		configParam<ScaledSquaringParamQuantity<(int)PEQEngine::maxFrequency>>(FREQUENCY6_PARAM, 0.0f, 1.0f, 0.3535534f, "Channel 6 frequency", " HZ");
 		configParam(FREQUENCY_CV6_PARAM, -1.0f, 1.0f, 1.0f, "Channel 6 frequency CV attenuation", "%", 0.0f, 100.0f);
 		configBypass(IN_INPUT, OUT_OUTPUT);
 
@@ -127,16 +127,30 @@ struct PEQ6 : ExpandableModule<PEQ6ExpanderMessage, BandExcludeModule> {
 		configOutput(OUT6_OUTPUT, "Channel 6");
 
 		setExpanderModelPredicate([](Model* m) { return m == modelPEQ6XF; });
+
+		for (int i = 0; i < 6; ++i) {
+			_engine.configBand(
+				i,
+				params[LEVEL1_PARAM + i*3],
+				params[FREQUENCY1_PARAM + i*3],
+				params[FREQUENCY_CV1_PARAM + i*3],
+				&params[FREQUENCY_CV_PARAM],
+				params[BANDWIDTH_PARAM],
+				inputs[LEVEL1_INPUT + i*2],
+				inputs[FREQUENCY_CV1_INPUT + i*2],
+				inputs[FREQUENCY_CV_INPUT],
+				&inputs[BANDWIDTH_INPUT]
+			);
+		}
 	}
 
 	void sampleRateChange() override;
 	bool active() override;
 	int channels() override;
 	void addChannel(int c) override;
-	void removeChannel(int c) override;
 	void modulate() override;
 	void processAlways(const ProcessArgs& args) override;
-	void processChannel(const ProcessArgs& args, int c) override;
+	void processAll(const ProcessArgs& args) override;
 	void postProcessAlways(const ProcessArgs& args) override;
 };
 
@@ -7,13 +7,11 @@
 #define LAST_TRIGGERED_ELEMENTS_COUNT "last_triggered_elements_count"
 
 void Pgmr::reset() {
-	std::lock_guard<SpinLock> lock(_elementsLock);
-
 	for (int c = 0; c < maxChannels; ++c) {
 		_lastSteps[c] = -1;
 		_allPulseGens[c].process(1000.0f);
 	}
-	for (auto* element : _elements) {
+	for (auto* element : elements()) {
 		element->reset();
 	}
 }
@@ -32,7 +30,7 @@ json_t* Pgmr::saveToJson(json_t* root) {
 			json_array_append_new(a, json_integer(_step[c]));
 		}
 		json_object_set_new(root, LAST_TRIGGERED_STEP, a);
-		json_object_set_new(root, LAST_TRIGGERED_ELEMENTS_COUNT, json_integer(_elements.size()));
+		json_object_set_new(root, LAST_TRIGGERED_ELEMENTS_COUNT, json_integer(elementsN()));
 	}
 	return root;
 }
@@ -62,7 +60,7 @@ void Pgmr::loadFromJson(json_t* root) {
 				}
 				_restoreLastTriggered = new std::function<void()>([this, restoreSteps]() {
 					for (int c = 0; c < maxChannels; ++c) {
-						setStep(c, restoreSteps[c], _elements.size());
+						setStep(c, restoreSteps[c], elementsN());
 					}
 				});
 			}
@@ -75,6 +73,8 @@ void Pgmr::modulate() {
 }
 
 void Pgmr::processAlways(const ProcessArgs& args) {
+	_steps = &elements();
+
 	if (expanderConnected()) {
 		PgmrExpanderMessage* te = toExpander();
 		te->baseID = _id;
@@ -85,8 +85,7 @@ void Pgmr::processAlways(const ProcessArgs& args) {
 }
 
 void Pgmr::processChannel(const ProcessArgs& args, int c) {
-	std::lock_guard<SpinLock> lock(_elementsLock);
-	std::vector<PgmrStep*>& steps = _elements;
+	const std::vector<PgmrStep*>& steps = *_steps;
 	int stepsN = steps.size();
 
 	if (c == 0) {
@@ -162,8 +161,8 @@ void Pgmr::processChannel(const ProcessArgs& args, int c) {
 	}
 }
 
-void Pgmr::elementsChanged() {
-	if (_restoreLastTriggered && (int)_elements.size() == _restoreLastTriggeredExpectedElementsN) {
+void Pgmr::elementsChanged(const std::vector<PgmrStep*>& elements) {
+	if (_restoreLastTriggered && (int)elements.size() == _restoreLastTriggeredExpectedElementsN) {
 		(*_restoreLastTriggered)();
 		delete _restoreLastTriggered;
 		_restoreLastTriggered = NULL;
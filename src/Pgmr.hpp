@@ -67,6 +67,7 @@ struct Pgmr : PgmrBase {
 		NUM_LIGHTS
 	};
 
+	const std::vector<PgmrStep*>* _steps = NULL; // the chain's steps, taken once per sample.
 	float _sampleTime = 0.001f;
 	bool _selectTriggers = false;
 	int _lastSteps[maxChannels] {};
@@ -142,7 +143,7 @@ struct Pgmr : PgmrBase {
 	void modulate() override;
 	void processAlways(const ProcessArgs& args) override;
 	void processChannel(const ProcessArgs& args, int c) override;
-	void elementsChanged() override;
+	void elementsChanged(const std::vector<PgmrStep*>& elements) override;
 };
 
 } // namespace bogaudio
@@ -3,10 +3,6 @@
 
 #define THRESHOLD_RANGE "threshold_range"
 
-void Pressor::Engine::sampleRateChange() {
-	detectorRMS.setSampleRate(APP->engine->getSampleRate());
-}
-
 float Pressor::ThresholdParamQuantity::getDisplayValue() {
 	float v = getValue();
 	if (!module) {
@@ -32,9 +28,7 @@ void Pressor::ThresholdParamQuantity::setDisplayValue(float v) {
 }
 
 void Pressor::sampleRateChange() {
-	for (int c = 0; c < _channels; ++c) {
-		_engines[c]->sampleRateChange();
-	}
+	_dynamics.setSampleRate(APP->engine->getSampleRate());
 }
 
 json_t* Pressor::saveToJson(json_t* root) {
@@ -66,7 +60,7 @@ int Pressor::channels() {
 
 void Pressor::addChannel(int c) {
 	_engines[c] = new Engine();
-	_engines[c]->sampleRateChange();
+	_dynamics.reset(c);
 }
 
 void Pressor::removeChannel(int c) {
@@ -75,21 +69,23 @@ void Pressor::removeChannel(int c) {
 }
 
 void Pressor::modulate() {
-	_compressorMode = params[MODE_PARAM].getValue() > 0.5f;
-	_rmsDetector = params[DECTECTOR_MODE_PARAM].getValue() > 0.5f;
-	_softKnee = params[KNEE_PARAM].getValue() > 0.5f;
+	_dynamics.setMode(params[MODE_PARAM].getValue() > 0.5f ? DynamicsProcessor::COMPRESSOR_MODE : DynamicsProcessor::NOISE_GATE_MODE);
+	_dynamics.setDetector(params[DECTECTOR_MODE_PARAM].getValue() > 0.5f ? DynamicsProcessor::RMS_DETECTOR : DynamicsProcessor::PEAK_DETECTOR);
+	_dynamics.setSoftKnee(params[KNEE_PARAM].getValue() > 0.5f);
+	_detectorMix.setParams(params[DETECTOR_MIX_PARAM].getValue(), 0.0f, true);
 }
 
 void Pressor::modulateChannel(int c) {
 	Engine& e = *_engines[c];
 
-	e.thresholdDb = params[THRESHOLD_PARAM].getValue();
+	float thresholdDb = params[THRESHOLD_PARAM].getValue();
 	if (inputs[THRESHOLD_INPUT].isConnected()) {
-		e.thresholdDb *= clamp(inputs[THRESHOLD_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
+		thresholdDb *= clamp(inputs[THRESHOLD_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
 	}
-	e.thresholdDb *= 30.0f;
-	e.thresholdDb -= 24.0f;
-	e.thresholdDb *= _thresholdRange;
+	thresholdDb *= 30.0f;
+	thresholdDb -= 24.0f;
+	thresholdDb *= _thresholdRange;
+	_dynamics.setThreshold(c, thresholdDb);
 
 	float ratio = params[RATIO_PARAM].getValue();
 	if (inputs[RATIO_INPUT].isConnected()) {
@@ -104,22 +100,21 @@ void Pressor::modulateChannel(int c) {
 		ratio = tanf(ratio);
 		ratio = 1.0f / ratio;
 		e.ratio = ratio;
+		_dynamics.setRatio(c, e.ratio);
 	}
 
-	float sampleRate = APP->engine->getSampleRate();
 	float attack = params[ATTACK_PARAM].getValue();
 	if (inputs[ATTACK_INPUT].isConnected()) {
 		attack *= clamp(inputs[ATTACK_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
 	}
 	attack *= attack;
-	e.attackSL.setParams(sampleRate, attack * 500.0f);
 
 	float release = params[RELEASE_PARAM].getValue();
 	if (inputs[RELEASE_INPUT].isConnected()) {
 		release *= clamp(inputs[RELEASE_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
 	}
 	release *= release;
-	e.releaseSL.setParams(sampleRate, release * 2000.0f);
+	_dynamics.setAttackRelease(c, attack * 500.0f, release * 2000.0f);
 
 	float inGain = params[INPUT_GAIN_PARAM].getValue();
 	if (inputs[INPUT_GAIN_INPUT].isConnected()) {
@@ -129,6 +124,7 @@ void Pressor::modulateChannel(int c) {
 	if (e.inGain != inGain) {
 		e.inGain = inGain;
 		e.inLevel = decibelsToAmplitude(e.inGain);
+		lanes::set(_inLevels[c / laneWidth], c % laneWidth, e.inLevel);
 	}
 
 	float outGain = params[OUTPUT_GAIN_PARAM].getValue();
@@ -139,56 +135,34 @@ void Pressor::modulateChannel(int c) {
 	if (e.outGain != outGain) {
 		e.outGain = outGain;
 		e.outLevel = decibelsToAmplitude(e.outGain);
+		_dynamics.setOutputLevel(c, e.outLevel);
 	}
-
-	e.detectorMix.setParams(params[DETECTOR_MIX_PARAM].getValue(), 0.0f, true);
 }
 
-void Pressor::processChannel(const ProcessArgs& args, int c) {
-	Engine& e = *_engines[c];
-
-	float leftInput = inputs[LEFT_INPUT].getPolyVoltage(c) * e.inLevel;
-	float rightInput = inputs[RIGHT_INPUT].getPolyVoltage(c) * e.inLevel;
-	float env = leftInput + rightInput;
-	if (inputs[SIDECHAIN_INPUT].isConnected()) {
-		env = e.detectorMix.next(env, inputs[SIDECHAIN_INPUT].getPolyVoltage(c));
-	}
-	if (_rmsDetector) {
-		env = e.detectorRMS.next(env);
-	}
-	else {
-		env = fabsf(env);
-	}
-	if (env > e.lastEnv) {
-		env = e.attackSL.next(env, e.lastEnv);
-	}
-	else {
-		env = e.releaseSL.next(env, e.lastEnv);
-	}
-	e.lastEnv = env;
+void Pressor::processAll(const ProcessArgs& args) {
+	outputs[ENVELOPE_OUTPUT].setChannels(_channels);
+	outputs[LEFT_OUTPUT].setChannels(_channels);
+	outputs[RIGHT_OUTPUT].setChannels(_channels);
+	bool sidechain = inputs[SIDECHAIN_INPUT].isConnected();
+
+	for (int c = 0, g = 0; c < _channels; c += laneWidth, ++g) {
+		lanes_t leftInput = getPolyLanes(inputs[LEFT_INPUT], c) * _inLevels[g];
+		lanes_t rightInput = getPolyLanes(inputs[RIGHT_INPUT], c) * _inLevels[g];
+		lanes_t env = leftInput + rightInput;
+		if (sidechain) {
+			env = _detectorMix.next(env, getPolyLanes(inputs[SIDECHAIN_INPUT], c));
+		}
+		lanes_t level = _dynamics.next(g, env);
 
-	float detectorDb = amplitudeToDecibels(env / 5.0f);
-	float compressionDb = 0.0f;
-	if (_compressorMode) {
-		compressionDb = e.compressor.compressionDb(detectorDb, e.thresholdDb, e.ratio, _softKnee);
-	}
-	else {
-		compressionDb = e.noiseGate.compressionDb(detectorDb, e.thresholdDb, e.ratio, _softKnee);
-	}
-	e.amplifier.setLevel(-compressionDb);
-	if (c == 0) {
-		_compressionDb = compressionDb;
-		outputs[ENVELOPE_OUTPUT].setChannels(_channels);
-		outputs[LEFT_OUTPUT].setChannels(_channels);
-		outputs[RIGHT_OUTPUT].setChannels(_channels);
-	}
-	outputs[ENVELOPE_OUTPUT].setVoltage(env, c);
-	if (outputs[LEFT_OUTPUT].isConnected()) {
-		outputs[LEFT_OUTPUT].setVoltage(e.saturator.next(e.amplifier.next(leftInput) * e.outLevel), c);
-	}
-	if (outputs[RIGHT_OUTPUT].isConnected()) {
-		outputs[RIGHT_OUTPUT].setVoltage(e.saturator.next(e.amplifier.next(rightInput) * e.outLevel), c);
+		setLanes(outputs[ENVELOPE_OUTPUT], _dynamics.group(g).env, c);
+		if (outputs[LEFT_OUTPUT].isConnected()) {
+			setLanes(outputs[LEFT_OUTPUT], _saturator.next(level * leftInput), c);
+		}
+		if (outputs[RIGHT_OUTPUT].isConnected()) {
+			setLanes(outputs[RIGHT_OUTPUT], _saturator.next(level * rightInput), c);
+		}
 	}
+	_compressionDb = lanes::get(_dynamics.group(0).compressionDb, 0);
 }
 
 struct PressorWidget : BGModuleWidget {
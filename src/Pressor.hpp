@@ -2,6 +2,7 @@
 
 #include "bogaudio.hpp"
 #include "dsp/filters/utility.hpp"
+#include "dsp/dynamics.hpp"
 #include "dsp/signal.hpp"
 
 using namespace bogaudio::dsp;
@@ -46,34 +47,20 @@ struct Pressor : BGModule {
 	};
 
 	struct Engine {
-		float thresholdDb = 0.0f;
 		float ratio = 0.0f;
 		float ratioKnob = -1.0f;
 		float inGain = -1.0f;
 		float inLevel = 0.0f;
 		float outGain = -1.0f;
 		float outLevel = 0.0f;
-		float lastEnv = 0.0f;
-
-		bogaudio::dsp::SlewLimiter attackSL;
-		bogaudio::dsp::SlewLimiter releaseSL;
-		CrossFader detectorMix;
-		RootMeanSquare detectorRMS;
-		Compressor compressor;
-		NoiseGate noiseGate;
-		Amplifier amplifier;
-		Saturator saturator;
-
-		Engine() : detectorRMS(1000.0f, 1.0f, 50.0f) {}
-
-		void sampleRateChange();
 	};
 
 	Engine* _engines[maxChannels] {};
+	DynamicsProcessor _dynamics;
+	CrossFader _detectorMix;
+	Saturator _saturator;
+	lanes_t _inLevels[DynamicsProcessor::maxGroups] {};
 	float _compressionDb = 0.0f;
-	bool _compressorMode = true;
-	bool _rmsDetector = true;
-	bool _softKnee = true;
 	float _thresholdRange = 1.0f;
 
 	struct ThresholdParamQuantity : ParamQuantity {
@@ -81,7 +68,7 @@ struct Pressor : BGModule {
 		void setDisplayValue(float v) override;
 	};
 
-	Pressor() {
+	Pressor() : _dynamics(50.0f) {
 		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS);
 		configParam<ThresholdParamQuantity>(THRESHOLD_PARAM, 0.0f, 1.0f, 0.8f, "Threshold", " dB");
 		configParam<DynamicsRatioParamQuantity>(RATIO_PARAM, 0.0f, 1.0f, 0.55159f, "Ratio");
@@ -120,7 +107,7 @@ struct Pressor : BGModule {
 	void removeChannel(int c) override;
 	void modulate() override;
 	void modulateChannel(int c) override;
-	void processChannel(const ProcessArgs& args, int c) override;
+	void processAll(const ProcessArgs& args) override;
 };
 
 } // namespace bogaudio
@@ -11,6 +11,77 @@
 #define WINDOW_TYPE_TAPER "taper"
 #define WINDOW_TYPE_HAMMING "hamming"
 #define WINDOW_TYPE_KAISER "Kaiser"
+#define MEASUREMENT "measurement"
+#define MEASUREMENT_SPECTRA "spectra"
+#define MEASUREMENT_SWEEP "sweep"
+
+constexpr int SweepAnalysis::maxCaptureSamples;
+
+SweepAnalysis::~SweepAnalysis() {
+	{
+		std::lock_guard<std::mutex> lock(_workerMutex);
+		_workerStop = true;
+	}
+	_workerCV.notify_one();
+	_worker.join();
+	delete[] _capture;
+	delete[] _pending;
+	delete[] _working;
+}
+
+void SweepAnalysis::submit(int size, float sampleRate, float frequency1, float frequency2, float amplitude) {
+	assert(captureSamples(size) <= maxCaptureSamples);
+	{
+		std::lock_guard<std::mutex> lock(_workerMutex);
+		std::swap(_capture, _pending);
+		_pendingSize = size;
+		_pendingSampleRate = sampleRate;
+		_pendingFrequency1 = frequency1;
+		_pendingFrequency2 = frequency2;
+		_pendingAmplitude = amplitude;
+		_pendingReady = true;
+	}
+	_workerCV.notify_one();
+}
+
+// Traces are laid out as Ranalyzer displays them: 2nd and 3rd harmonics,
+// then the linear response.
+void SweepAnalysis::work() {
+	while (true) {
+		int size;
+		float sampleRate, frequency1, frequency2, amplitude;
+		{
+			std::unique_lock<std::mutex> lock(_workerMutex);
+			while (!(_pendingReady || _workerStop)) {
+				_workerCV.wait(lock);
+			}
+			if (_workerStop) {
+				return;
+			}
+			std::swap(_pending, _working);
+			size = _pendingSize;
+			sampleRate = _pendingSampleRate;
+			frequency1 = _pendingFrequency1;
+			frequency2 = _pendingFrequency2;
+			amplitude = _pendingAmplitude;
+			_pendingReady = false;
+		}
+
+		_deconvolver.setParams(sampleRate, frequency1, frequency2, size, amplitude);
+		_deconvolver.analyze(_working);
+
+		float* out = _currentOutBuf == _outBuf0 ? _outBuf1 : _outBuf0;
+		const float* traces[SweepAnalysis::traces] = { _deconvolver.harmonic(2), _deconvolver.harmonic(3), _deconvolver._magnitudes };
+		for (int t = 0; t < SweepAnalysis::traces; ++t) {
+			float* bins = out + t * traceBinsN;
+			for (int i = 0, n = size / 2; i < n; ++i) {
+				bins[i] = AnalyzerDisplay::dbToBinValue(amplitudeToDecibels(traces[t][i]));
+			}
+		}
+		_currentOutBuf = out;
+	}
+}
+
 
 void Ranalyzer::reset() {
 	_trigger.reset();
@@ -48,6 +119,7 @@ json_t* Ranalyzer::saveToJson(json_t* root) {
 	frequencyRangeToJson(root);
 	amplitudePlotToJson(root);
 	json_object_set_new(root, TRIGGER_ON_LOAD, json_boolean(_triggerOnLoad));
+	json_object_set_new(root, MEASUREMENT, json_string(_measurement == SWEEP_MEASUREMENT ? MEASUREMENT_SWEEP : MEASUREMENT_SPECTRA));
 
 	switch (_displayTraces) {
 		case ALL_TRACES: {
@@ -96,6 +168,17 @@ void Ranalyzer::loadFromJson(json_t* root) {
 		_triggerOnLoad = json_boolean_value(t);
 	}
 
+	json_t* m = json_object_get(root, MEASUREMENT);
+	if (m) {
+		std::string ms = json_string_value(m);
+		if (ms == MEASUREMENT_SPECTRA) {
+			setMeasurement(SPECTRA_MEASUREMENT);
+		}
+		else if (ms == MEASUREMENT_SWEEP) {
+			setMeasurement(SWEEP_MEASUREMENT);
+		}
+	}
+
 	json_t* dt = json_object_get(root, DISPLAY_TRACES);
 	if (dt) {
 		std::string dts = json_string_value(dt);
@@ -169,14 +252,22 @@ void Ranalyzer::processAll(const ProcessArgs& args) {
 			_chirp.reset();
 			_cycleN = _core.size();
 			_cycleI = 0;
-			_chirp.setParams(_frequency1, _frequency2, _core.size() / (double)_sampleRate, !_exponential);
 			_triggerPulseGen.trigger(0.001f);
-			_useTestInput = inputs[TEST_INPUT].isConnected();
+			if (_measurement == SWEEP_MEASUREMENT) {
+				startSweep();
+			}
+			else {
+				_chirp.setParams(_frequency1, _frequency2, _core.size() / (double)_sampleRate, !_exponential);
+				_useTestInput = inputs[TEST_INPUT].isConnected();
+			}
 		}
 	}
 
 	float out = 0.0f;
-	if (_run) {
+	if (_run && _measurement == SWEEP_MEASUREMENT) {
+		out = stepSweep();
+	}
+	else if (_run) {
 		if (_useTestInput) {
 			out = inputs[TEST_INPUT].getVoltage();
 		}
@@ -217,6 +308,62 @@ void Ranalyzer::processAll(const ProcessArgs& args) {
 	outputs[EOC_OUTPUT].setVoltage(_eocPulseGen.process(_sampleTime) * 5.0f);
 }
 
+// The sweep always runs upward, exponentially, over at least an octave: the
+// deconvolution needs the harmonics' responses to land ahead of the linear
+// one.  The test input isn't used; the deconvolver has to know the sweep.
+void Ranalyzer::startSweep() {
+	float f1 = std::min(_frequency1, _frequency2);
+	float f2 = std::max(_frequency1, _frequency2);
+	if (f2 < 2.0f * f1) {
+		f2 = std::min(2.0f * f1, _maxFrequency);
+		f1 = 0.5f * f2;
+	}
+	_sweepFrequency1 = f1;
+	_sweepFrequency2 = f2;
+
+	if (_sweepSize != _core.size()) {
+		_sweepSize = _core.size();
+		_sweepBinsN = _sweepSize / 2;
+	}
+	_chirp.setParams(_sweepFrequency1, _sweepFrequency2, _sweepSize / (double)_sampleRate, false);
+	_cycleN = SweepAnalysis::captureSamples(_sweepSize) + _currentReturnSampleDelay - 1;
+	_useTestInput = false;
+}
+
+// Plays the sweep, then silence while the return's tail is recorded; the
+// return is captured with the same alignment the spectra measurement gives it
+// against the test signal.
+float Ranalyzer::stepSweep() {
+	float out = 0.0f;
+	if (_cycleI < _sweepSize) {
+		out = _chirp.next() * 5.0f;
+	}
+	int i = _cycleI - (_currentReturnSampleDelay - 1);
+	if (i >= 0) {
+		_sweepAnalysis->capture()[i] = inputs[RETURN_INPUT].getVoltage();
+	}
+
+	++_cycleI;
+	if (_cycleI >= _cycleN) {
+		_run = false;
+		_sweepAnalysis->submit(_sweepSize, _sampleRate, _sweepFrequency1, _sweepFrequency2, 5.0f);
+		_eocPulseGen.trigger(0.001f);
+	}
+	return out;
+}
+
+void Ranalyzer::setMeasurement(Measurement m) {
+	if (_measurement != m) {
+		_measurement = m;
+		_run = false;
+		_flush = false;
+		_core.resetChannels();
+	}
+	if (_channelDisplayListener) {
+		_channelDisplayListener->displaySweepTraces(_measurement == SWEEP_MEASUREMENT);
+	}
+}
+
 void Ranalyzer::setDisplayTraces(Traces traces) {
 	_displayTraces = traces;
 	if (_channelDisplayListener) {
@@ -239,6 +386,7 @@ void Ranalyzer::setDisplayTraces(Traces traces) {
 
 void Ranalyzer::setChannelDisplayListener(ChannelDisplayListener* listener) {
 	_channelDisplayListener = listener;
+	setMeasurement(_measurement);
 }
 
 void Ranalyzer::setWindow(WindowType wt) {
@@ -287,9 +435,31 @@ struct AnalysisBinsReader : AnalyzerDisplay::BinsReader {
 };
 
 
+struct SweepBinsReader : AnalyzerDisplay::BinsReader {
+	const float* _bins;
+	int _binsN;
+
+	SweepBinsReader(const float* bins, int binsN) : _bins(bins), _binsN(binsN) {}
+
+	float at(int i) override {
+		return i < _binsN ? _bins[i] : 0.0f;
+	}
+
+	static AnalyzerDisplay::BinsReaderFactory factory(Ranalyzer* module, int trace) {
+		return [module, trace](AnalyzerCore& core) {
+			return std::unique_ptr<BinsReader>(new SweepBinsReader(module->getSweepBins(trace), module->_sweepBinsN));
+		};
+	}
+};
+
+
 struct RanalyzerDisplay : AnalyzerDisplay, ChannelDisplayListener {
+	Ranalyzer* _ranalyzer;
+	bool _sweepTraces = false;
+
 	RanalyzerDisplay(Ranalyzer* module, Vec size, bool drawInset)
 	: AnalyzerDisplay(module, size, drawInset)
+	, _ranalyzer(module)
 	{}
 
 	void displayChannels(bool c0, bool c1, bool c2) override {
@@ -298,6 +468,26 @@ struct RanalyzerDisplay : AnalyzerDisplay, ChannelDisplayListener {
 		displayChannel(2, c2);
 	}
 
+	void displaySweepTraces(bool sweep) override {
+		_sweepTraces = sweep;
+		if (sweep) {
+			for (int i = 0; i < SweepAnalysis::traces; ++i) {
+				setChannelBinsReaderFactory(i, SweepBinsReader::factory(_ranalyzer, i));
+			}
+			channelLabel(0, "2nd harmonic");
+			channelLabel(1, "3rd harmonic");
+			channelLabel(2, "Response");
+		}
+		else {
+			setChannelBinsReaderFactory(0, BinsReaderFactory());
+			setChannelBinsReaderFactory(1, BinsReaderFactory());
+			setChannelBinsReaderFactory(2, AnalysisBinsReader::factory);
+			channelLabel(0, "Test");
+			channelLabel(1, "Response");
+			channelLabel(2, "Analysis");
+		}
+	}
+
 	void drawHeader(const DrawArgs& args, float rangeMinHz, float rangeMaxHz) override {
 		nvgSave(args.vg);
 
@@ -309,7 +499,9 @@ struct RanalyzerDisplay : AnalyzerDisplay, ChannelDisplayListener {
 		drawText(args, s.c_str(), x, _insetTop + textY);
 		x += s.size() * charPx + 20;
 
-		const char* labels[3] = { "TEST", "RESPONSE", "ANALYSIS" };
+		const char* spectraLabels[3] = { "TEST", "RESPONSE", "ANALYSIS" };
+		const char* sweepLabels[3] = { "2ND HARMONIC", "3RD HARMONIC", "RESPONSE" };
+		const char** labels = _sweepTraces ? sweepLabels : spectraLabels;
 		for (int i = 0; i < 3; ++i) {
 			if (_displayChannel[i]) {
 				auto color = _channelColors[i % channelColorsN];
@@ -348,11 +540,7 @@ struct RanalyzerWidget : AnalyzerBaseWidget {
 			display->box.pos = inset;
 			display->box.size = size;
 			if (module) {
-				display->setChannelBinsReaderFactory(2, AnalysisBinsReader::factory);
 				module->setChannelDisplayListener(display);
-				display->channelLabel(0, "Test");
-				display->channelLabel(1, "Response");
-				display->channelLabel(2, "Analysis");
 			}
 			addChild(display);
 		}
@@ -406,10 +594,17 @@ struct RanalyzerWidget : AnalyzerBaseWidget {
 
 		menu->addChild(new MenuLabel());
 		{
+			OptionsMenuItem* mi = new OptionsMenuItem("Measurement");
+			mi->addItem(OptionMenuItem("Swept spectra", [a]() { return a->_measurement == Ranalyzer::SPECTRA_MEASUREMENT; }, [a]() { a->setMeasurement(Ranalyzer::SPECTRA_MEASUREMENT); }));
+			mi->addItem(OptionMenuItem("Sweep deconvolution", [a]() { return a->_measurement == Ranalyzer::SWEEP_MEASUREMENT; }, [a]() { a->setMeasurement(Ranalyzer::SWEEP_MEASUREMENT); }));
+			OptionsMenuItem::addToMenu(mi, menu);
+		}
+		{
+			bool sweep = a->_measurement == Ranalyzer::SWEEP_MEASUREMENT;
 			OptionsMenuItem* mi = new OptionsMenuItem("Display traces");
 			mi->addItem(OptionMenuItem("All", [a]() { return a->_displayTraces == Ranalyzer::ALL_TRACES; }, [a]() { a->setDisplayTraces(Ranalyzer::ALL_TRACES); }));
-			mi->addItem(OptionMenuItem("Analysis only", [a]() { return a->_displayTraces == Ranalyzer::ANALYSIS_TRACES; }, [a]() { a->setDisplayTraces(Ranalyzer::ANALYSIS_TRACES); }));
-			mi->addItem(OptionMenuItem("Test/return only", [a]() { return a->_displayTraces == Ranalyzer::TEST_RETURN_TRACES; }, [a]() { a->setDisplayTraces(Ranalyzer::TEST_RETURN_TRACES); }));
+			mi->addItem(OptionMenuItem(sweep ? "Response only" : "Analysis only", [a]() { return a->_displayTraces == Ranalyzer::ANALYSIS_TRACES; }, [a]() { a->setDisplayTraces(Ranalyzer::ANALYSIS_TRACES); }));
+			mi->addItem(OptionMenuItem(sweep ? "Harmonics only" : "Test/return only", [a]() { return a->_displayTraces == Ranalyzer::TEST_RETURN_TRACES; }, [a]() { a->setDisplayTraces(Ranalyzer::TEST_RETURN_TRACES); }));
 			OptionsMenuItem::addToMenu(mi, menu);
 		}
 		{
@@ -13,6 +13,59 @@ namespace bogaudio {
 
 struct ChannelDisplayListener {
 	virtual void displayChannels(bool c0, bool c1, bool c2) = 0;
+	virtual void displaySweepTraces(bool sweep) = 0;
+};
+
+// Runs a SweepDeconvolver on a worker thread, as ChannelAnalyzer does its
+// FFTs.  The module records the return into capture(); submit() swaps that
+// for a free buffer and wakes the worker, which publishes the response and
+// harmonic traces, as display bin values, by flipping currentOutBuf between
+// the two output buffers.  One instance lives as long as the module, with
+// buffers for the largest analysis size; each submission carries its own
+// size and sample rate, so the module never builds or stops one while it
+// runs.
+struct SweepAnalysis {
+	static constexpr int traces = 3;
+	static constexpr int traceBinsN = SpectrumAnalyzer::maxSize / 2;
+	static constexpr int maxCaptureSamples = SweepDeconvolver::responseSamples(SpectrumAnalyzer::maxSize);
+
+	SweepDeconvolver _deconvolver;
+	float* _capture;
+	float* _pending;
+	float* _working;
+	int _pendingSize = 0;
+	float _pendingSampleRate = 0.0f;
+	float _pendingFrequency1 = 0.0f;
+	float _pendingFrequency2 = 0.0f;
+	float _pendingAmplitude = 1.0f;
+	bool _pendingReady = false;
+	float* _outBuf0;
+	float* _outBuf1;
+	std::atomic<float*>& _currentOutBuf;
+	bool _workerStop = false;
+	std::mutex _workerMutex;
+	std::condition_variable _workerCV;
+	std::thread _worker;
+
+	SweepAnalysis(
+		float* outBuf0,
+		float* outBuf1,
+		std::atomic<float*>& currentOutBuf
+	)
+	: _capture(new float[maxCaptureSamples] {})
+	, _pending(new float[maxCaptureSamples] {})
+	, _working(new float[maxCaptureSamples] {})
+	, _outBuf0(outBuf0)
+	, _outBuf1(outBuf1)
+	, _currentOutBuf(currentOutBuf)
+	, _worker(&SweepAnalysis::work, this)
+	{}
+	~SweepAnalysis();
+
+	static inline int captureSamples(int size) { return SweepDeconvolver::responseSamples(size); }
+	inline float* capture() { return _capture; }
+	void submit(int size, float sampleRate, float frequency1, float frequency2, float amplitude);
+	void work();
 };
 
 struct Ranalyzer : AnalyzerBase {
@@ -46,6 +99,11 @@ struct Ranalyzer : AnalyzerBase {
 		ANALYSIS_TRACES
 	};
 
+	enum Measurement {
+		SPECTRA_MEASUREMENT,
+		SWEEP_MEASUREMENT
+	};
+
 	enum WindowType {
 		NONE_WINDOW_TYPE,
 		TAPER_WINDOW_TYPE,
@@ -110,10 +168,21 @@ struct Ranalyzer : AnalyzerBase {
 	Timer* _initialDelay = NULL;
 	WindowType _windowType = TAPER_WINDOW_TYPE;
 	bogaudio::dsp::Window* _window = NULL;
+	Measurement _measurement = SPECTRA_MEASUREMENT;
+	SweepAnalysis* _sweepAnalysis;
+	int _sweepSize = 0;
+	float _sweepFrequency1 = 0.0f;
+	float _sweepFrequency2 = 0.0f;
+	float* _sweepOutBufs;
+	std::atomic<float*> _currentSweepOutBuf;
+	std::atomic<int> _sweepBinsN;
 
 	Ranalyzer()
 	: AnalyzerBase(3, NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, 0, SpectrumAnalyzer::OVERLAP_1)
 	, _inputBuffer(maxResponseDelay, 0.0f)
+	, _sweepOutBufs(new float[2 * SweepAnalysis::traces * SweepAnalysis::traceBinsN] {})
+	, _currentSweepOutBuf(_sweepOutBufs)
+	, _sweepBinsN(0)
 	{
 		configParam<FrequencyParamQuantity>(FREQUENCY1_PARAM, 0.0f, 1.0f, 0.0f, "Frequency 1", " Hz");
 		configParam<FrequencyParamQuantity>(FREQUENCY2_PARAM, 0.0f, 1.0f, 1.0f, "Frequency 2", " Hz");
@@ -132,6 +201,11 @@ struct Ranalyzer : AnalyzerBase {
 		configOutput(SEND_OUTPUT, "Send signal");
 
 		_skinnable = false;
+		_sweepAnalysis = new SweepAnalysis(
+			_sweepOutBufs,
+			_sweepOutBufs + SweepAnalysis::traces * SweepAnalysis::traceBinsN,
+			_currentSweepOutBuf
+		);
 	}
 	virtual ~Ranalyzer() {
 		if (_initialDelay) {
@@ -140,6 +214,8 @@ struct Ranalyzer : AnalyzerBase {
 		if (_window) {
 			delete _window;
 		}
+		delete _sweepAnalysis;
+		delete[] _sweepOutBufs;
 	}
 
 	void reset() override;
@@ -151,6 +227,13 @@ struct Ranalyzer : AnalyzerBase {
 	void setDisplayTraces(Traces traces);
 	void setChannelDisplayListener(ChannelDisplayListener* listener);
 	void setWindow(WindowType wt);
+	void setMeasurement(Measurement m);
+	void startSweep();
+	float stepSweep();
+	inline float* getSweepBins(int trace) {
+		assert(trace >= 0 && trace < SweepAnalysis::traces);
+		return _currentSweepOutBuf.load() + trace * SweepAnalysis::traceBinsN;
+	}
 };
 
 } // namespace bogaudio
@@ -88,6 +88,8 @@ struct VCF : BGModule {
 		configInput(SLOPE_INPUT, "Slope CV");
 
 		configOutput(OUT_OUTPUT, "Signal");
+
+		_parallelizable = true;
 	}
 
 	json_t* saveToJson(json_t* root) override;
@@ -1,14 +1,9 @@
 
 #include "Vish.hpp"
 
-void Vish::Engine::reset() {
-	trigger.reset();
-	gatePulseGen.process(10.0);
-}
-
 void Vish::reset() {
 	for (int c = 0; c < _channels; ++c) {
-		_engines[c]->reset();
+		_triggers[c].reset();
 	}
 }
 
@@ -26,17 +21,14 @@ int Vish::channels() {
 }
 
 void Vish::addChannel(int c) {
-	_engines[c] = new Engine();
-	_engines[c]->reset();
-}
-
-void Vish::removeChannel(int c) {
-	delete _engines[c];
-	_engines[c] = NULL;
+	_triggers[c].reset();
+	_gateSeconds[c] = _gateElapsedSeconds[c] = 0.0f;
+	_slews[c / laneWidth].reset(c % laneWidth);
 }
 
 void Vish::modulateChannel(int c) {
-	_engines[c]->slew.modulate(
+	RiseFallShapedSlewLimiter::modulate(
+		_slews[c / laneWidth],
 		_sampleRate,
 		params[RISE_PARAM],
 		&inputs[RISE_INPUT],
@@ -54,41 +46,45 @@ void Vish::modulateChannel(int c) {
 	);
 }
 
-void Vish::processChannel(const ProcessArgs& args, int c) {
-	Engine& e = *_engines[c];
-
-	float in = inputs[GATE_INPUT].getPolyVoltage(c);
-	if (e.trigger.process(in)) {
-		float time = clamp(params[MINIMUM_GATE_PARAM].getValue(), 0.0f, 1.0f);
-		if (inputs[MINIMUM_GATE_INPUT].isConnected()) {
-			time *= clamp(inputs[MINIMUM_GATE_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
-		}
-		time *= time;
-		time *= _timeScale;
-		e.gateSeconds = time;
-
-		e.gateElapsedSeconds = 0.0f;
-		if (_gateToTrigger) {
-			e.gateSeconds = std::max(0.01f, time);
+void Vish::processAll(const ProcessArgs& args) {
+	for (int c = 0; c < _channels; ++c) {
+		float in = inputs[GATE_INPUT].getPolyVoltage(c);
+		if (_triggers[c].process(in)) {
+			float time = clamp(params[MINIMUM_GATE_PARAM].getValue(), 0.0f, 1.0f);
+			if (inputs[MINIMUM_GATE_INPUT].isConnected()) {
+				time *= clamp(inputs[MINIMUM_GATE_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
+			}
+			time *= time;
+			time *= _timeScale;
+			_gateElapsedSeconds[c] = 0.0f;
+			if (_gateToTrigger) {
+				_gateSeconds[c] = std::max(0.01f, time);
+			}
+			else {
+				_gateSeconds[c] = time;
+			}
 		}
 		else {
-			e.gateSeconds = time;
+			_gateElapsedSeconds[c] += _sampleTime;
 		}
-	}
-	else {
-		e.gateElapsedSeconds += _sampleTime;
-	}
 
-	float gate = 0.0f;
-	if (e.gateElapsedSeconds < e.gateSeconds) {
-		gate = 10.0f;
-	}
-	else if (!_gateToTrigger) {
-		gate = in;
+		float gate = 0.0f;
+		if (_gateElapsedSeconds[c] < _gateSeconds[c]) {
+			gate = 10.0f;
+		}
+		else if (!_gateToTrigger) {
+			gate = in;
+		}
+		_gates[c] = gate;
 	}
 
 	outputs[OUT_OUTPUT].setChannels(_channels);
-	outputs[OUT_OUTPUT].setVoltage(e.slew.next(gate), c);
+	for (int g = 0, groups = laneGroups(_channels); g < groups; ++g) {
+		lanes_t out = _slews[g].next(lanes::load(_gates + g * laneWidth));
+		for (int l = 0, c = g * laneWidth; l < laneWidth && c < _channels; ++l, ++c) {
+			outputs[OUT_OUTPUT].setVoltage(lanes::get(out, l), c);
+		}
+	}
 }
 
 struct VishWidget : LPGEnvBaseWidget {
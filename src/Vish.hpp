@@ -32,17 +32,11 @@ struct Vish : LPGEnvBaseModule {
 		NUM_OUTPUTS
 	};
 
-	struct Engine {
-		Trigger trigger;
-		rack::dsp::PulseGenerator gatePulseGen;
-		float gateSeconds = 0.0f;
-		float gateElapsedSeconds = 0.0f;
-		RiseFallShapedSlewLimiter slew;
-
-		void reset();
-	};
-
-	Engine* _engines[maxChannels] {};
+	Trigger _triggers[maxChannels];
+	float _gateSeconds[maxChannels] {};
+	float _gateElapsedSeconds[maxChannels] {};
+	float _gates[maxChannels] {};
+	RiseFallShapedSlewLimiterLanes _slews[maxChannels / laneWidth];
 	float _sampleRate = 0.0f;
 	float _sampleTime = 0.0f;
 
@@ -72,9 +66,8 @@ struct Vish : LPGEnvBaseModule {
 	bool active() override;
 	int channels() override;
 	void addChannel(int c) override;
-	void removeChannel(int c) override;
 	void modulateChannel(int c) override;
-	void processChannel(const ProcessArgs& args, int c) override;
+	void processAll(const ProcessArgs& args) override;
 };
 
 } // namespace bogaudio
@@ -6,6 +6,7 @@
 #define JUMP_MODE_JUMP "jump"
 #define JUMP_MODE_TRACKHOLD "track_and_hold"
 #define JUMP_MODE_SAMPLEHOLD "sample_and_hold"
+#define CONTROL_RATE "control_rate"
 
 void Walk::reset() {
 	for (int i = 0; i < maxChannels; ++i) {
@@ -35,6 +36,7 @@ json_t* Walk::saveToJson(json_t* root) {
 			break;
 		}
 	}
+	json_object_set_new(root, CONTROL_RATE, json_boolean(_controlRate));
 	return root;
 }
 
@@ -56,6 +58,11 @@ void Walk::loadFromJson(json_t* root) {
 			_jumpMode = SAMPLEHOLD_JUMPMODE;
 		}
 	}
+
+	json_t* cr = json_object_get(root, CONTROL_RATE);
+	if (cr) {
+		_controlRate = json_is_true(cr);
+	}
 }
 
 int Walk::channels() {
@@ -72,7 +79,7 @@ void Walk::modulateChannel(int c) {
 		rate *= clamp(inputs[RATE_INPUT].getPolyVoltage(c) / 10.0f, 0.0f, 1.0f);
 	}
 	rate = 0.2f * powf(rate, 5.0f);
-	_walk[c].setParams(APP->engine->getSampleRate(), rate);
+	_walks[c / laneWidth].setParams(c % laneWidth, APP->engine->getSampleRate(), rate, _controlRate ? _modulationSteps : 1);
 
 	_offset[c] = params[OFFSET_PARAM].getValue();
 	if (inputs[OFFSET_INPUT].isConnected()) {
@@ -86,14 +93,42 @@ void Walk::modulateChannel(int c) {
 	}
 }
 
+// The walks advance a group of channels at a time: every sample, or, at
+// control rate, once per modulation, interpolating the steps between.
+void Walk::processAll(const ProcessArgs& args) {
+	int groups = laneGroups(_channels);
+	if (!_controlRate) {
+		for (int g = 0; g < groups; ++g) {
+			lanes_t w = _walks[g].next();
+			lanes::store(_walkOut + g * laneWidth, w);
+			lanes::store(_walkTo + g * laneWidth, w); // so switching to control rate doesn't jump.
+		}
+		return;
+	}
+
+	if (_steps == 0) {
+		for (int g = 0; g < groups; ++g) {
+			int c = g * laneWidth;
+			lanes::store(_walkFrom + c, lanes::load(_walkTo + c));
+			lanes::store(_walkTo + c, _walks[g].next());
+		}
+	}
+	float t = (_steps + 1) / (float)_modulationSteps;
+	for (int g = 0; g < groups; ++g) {
+		int c = g * laneWidth;
+		lanes_t from = lanes::load(_walkFrom + c);
+		lanes::store(_walkOut + c, from + t * (lanes::load(_walkTo + c) - from));
+	}
+}
+
 void Walk::processChannel(const ProcessArgs& args, int c) {
 	float triggered = _jumpTrigger[c].process(inputs[JUMP_INPUT].getPolyVoltage(c));
-	float out = _walk[c].next();
+	float out = _walkOut[c];
 
 	switch (_jumpMode) {
 		case JUMP_JUMPMODE: {
 			if (triggered) {
-				_walk[c].jump();
+				_walkFrom[c] = _walkTo[c] = _walks[c / laneWidth].jump(c % laneWidth);
 			}
 			break;
 		}
@@ -175,6 +210,8 @@ struct WalkWidget : BGModuleWidget {
 		jm->addItem(OptionMenuItem("Sample and hold", [m]() { return m->_jumpMode == Walk::SAMPLEHOLD_JUMPMODE; }, [m]() { m->_jumpMode = Walk::SAMPLEHOLD_JUMPMODE; }));
 		jm->addItem(OptionMenuItem("Track and hold", [m]() { return m->_jumpMode == Walk::TRACKHOLD_JUMPMODE; }, [m]() { m->_jumpMode = Walk::TRACKHOLD_JUMPMODE; }));
 		OptionsMenuItem::addToMenu(jm, menu);
+
+		menu->addChild(new BoolOptionMenuItem("Walk at control rate", [m]() { return &m->_controlRate; }));
 	}
 };
 
@@ -40,11 +40,15 @@ struct Walk : BGModule {
 	float _offset[maxChannels] {};
 	float _scale[maxChannels] {};
 	Trigger _jumpTrigger[maxChannels];
-	RandomWalk _walk[maxChannels];
+	RandomWalkLanes _walks[maxChannels / laneWidth];
+	float _walkOut[maxChannels] {};
+	float _walkFrom[maxChannels] {};
+	float _walkTo[maxChannels] {};
 	bogaudio::dsp::SlewLimiter _slew[maxChannels];
 	float _lastOut[maxChannels] {};
 	int _polyInputID = RATE_INPUT;
 	JumpMode _jumpMode = JUMP_JUMPMODE;
+	bool _controlRate = false;
 
 	Walk() {
 		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS);
@@ -66,6 +70,7 @@ struct Walk : BGModule {
 	void loadFromJson(json_t* root) override;
 	int channels() override;
 	void modulateChannel(int c) override;
+	void processAll(const ProcessArgs& args) override;
 	void processChannel(const ProcessArgs& args, int c) override;
 };
 
@@ -49,7 +49,7 @@ void Walk2::modulate() {
 		rateX *= clamp(inputs[RATE_X_INPUT].getVoltage() / 10.0f, 0.0f, 1.0f);
 	}
 	rateX = scaleRate(rateX);
-	_walkX.setParams(sampleRate, rateX);
+	setWalkParams(0, sampleRate, rateX);
 	_slewX.setParams(sampleRate, std::max((1.0f - rateX) * 100.0f, 0.0f), 10.0f);
 
 	_offsetX = params[OFFSET_X_PARAM].getValue();
@@ -68,7 +68,7 @@ void Walk2::modulate() {
 		rateY *= clamp(inputs[RATE_Y_INPUT].getVoltage() / 10.0f, 0.0f, 1.0f);
 	}
 	rateY = scaleRate(rateY);
-	_walkY.setParams(sampleRate, rateY);
+	setWalkParams(1, sampleRate, rateY);
 	_slewY.setParams(sampleRate, std::max((1.0f - rateY) * 100.0f, 0.0f), 10.0f);
 
 	_offsetY = params[OFFSET_Y_PARAM].getValue();
@@ -105,21 +105,25 @@ void Walk2::processAll(const ProcessArgs& args) {
 	if (jumpTo != NULL) {
 		_jumpTo = NULL;
 		_lastOutX = jumpTo->x;
-		_walkX.tell(jumpTo->x);
+		tellWalk(0, jumpTo->x);
 		_lastOutY = jumpTo->y;
-		_walkY.tell(jumpTo->y);
+		tellWalk(1, jumpTo->y);
 		delete jumpTo;
 	}
 
 	bool triggered = _jumpTrigger.process(inputs[JUMP_INPUT].getVoltage());
-	float outX = _walkX.next();
-	float outY = _walkY.next();
+	float walked[walkGroups * laneWidth];
+	for (int g = 0; g < walkGroups; ++g) {
+		lanes::store(walked + g * laneWidth, _walks[g].next());
+	}
+	float outX = walked[0];
+	float outY = walked[1];
 
 	switch (_jumpMode) {
 		case Walk::JUMP_JUMPMODE: {
 			if (triggered) {
-				_walkX.jump();
-				_walkY.jump();
+				jumpWalk(0);
+				jumpWalk(1);
 			}
 			break;
 		}
@@ -181,6 +185,10 @@ struct Walk2Display : DisplayWidget {
 	int _midX, _midY;
 	NVGcolor _traceColor = _defaultTraceColor;
 	Vec _dragLast;
+	bool _staticZoomOut = false;
+	bool _staticDrawGrid = true;
+	float _staticOffsetX = 0.0f;
+	float _staticOffsetY = 0.0f;
 
 	Walk2Display(
 		Walk2* module,
@@ -193,6 +201,7 @@ struct Walk2Display : DisplayWidget {
 	, _midX(_insetAround + _drawSize.x/2)
 	, _midY(_insetAround + _drawSize.y/2)
 	{
+		_cacheStatic = true;
 	}
 
 	void onButton(const event::Button& e) override {
@@ -226,49 +235,75 @@ struct Walk2Display : DisplayWidget {
 		}
 	}
 
-	void drawOnce(const DrawArgs& args, bool screenshot, bool lit) override {
-		float strokeWidth = std::max(1.0f, 3.0f - getZoom());
+	void step() override {
+		if (_module && (
+			_module->_zoomOut != _staticZoomOut ||
+			_module->_drawGrid != _staticDrawGrid ||
+			(!_module->_zoomOut && (_module->_offsetX != _staticOffsetX || _module->_offsetY != _staticOffsetY))
+		)) {
+			invalidateStatic();
+		}
+		DisplayWidget::step();
+	}
 
-		nvgSave(args.vg);
-		drawBackground(args);
+	// scissors to the display and sets up its zoom or offset, returning the stroke width to use.
+	float transform(const DrawArgs& args, bool zoomOut, float offsetX, float offsetY) {
+		float strokeWidth = std::max(1.0f, 3.0f - getZoom());
 		nvgScissor(args.vg, _insetAround, _insetAround, _drawSize.x / 2, _drawSize.y / 2);
-		if (_module && _module->_zoomOut) {
+		if (zoomOut) {
 			nvgScale(args.vg, 0.5f, 0.5f);
 			strokeWidth *= 2.0f;
 		}
 		else {
-			float offsetX = _module ? _module->_offsetX : 0.0f;
-			float offsetY = _module ? _module->_offsetY : 0.0f;
 			float tx = 1.0f + (clamp(offsetX, -5.0f, 5.0f) / 5.0f);
 			tx *= -_drawSize.x / 4;
 			float ty = 1.0f - (clamp(offsetY, -5.0f, 5.0f) / 5.0f);
 			ty *= -_drawSize.y / 4;
 			nvgTranslate(args.vg, tx, ty);
 		}
-		drawAxes(args, strokeWidth);
+		return strokeWidth;
+	}
 
-		if (lit) {
-			switch (_module->_traceColor) {
-				case Walk2::ORANGE_TRACE_COLOR: {
-					_traceColor = nvgRGBA(0xff, 0x80, 0x00, 0xee);
-					break;
-				}
-				case Walk2::RED_TRACE_COLOR: {
-					_traceColor = nvgRGBA(0xff, 0x00, 0x00, 0xee);
-					break;
-				}
-				case Walk2::BLUE_TRACE_COLOR: {
-					_traceColor = nvgRGBA(0x00, 0xdd, 0xff, 0xee);
-					break;
-				}
-				case Walk2::GREEN_TRACE_COLOR:
-				default: {
-					_traceColor = _defaultTraceColor;
-				}
+	void drawStatic(const DrawArgs& args, bool screenshot, bool lit) override {
+		_staticZoomOut = _module && _module->_zoomOut;
+		_staticDrawGrid = !_module || _module->_drawGrid;
+		_staticOffsetX = _module ? _module->_offsetX : 0.0f;
+		_staticOffsetY = _module ? _module->_offsetY : 0.0f;
+
+		nvgSave(args.vg);
+		drawBackground(args);
+		float strokeWidth = transform(args, _staticZoomOut, _staticOffsetX, _staticOffsetY);
+		drawAxes(args, strokeWidth, _staticDrawGrid);
+		nvgRestore(args.vg);
+	}
+
+	void drawOnce(const DrawArgs& args, bool screenshot, bool lit) override {
+		if (!lit) {
+			return;
+		}
+
+		switch (_module->_traceColor) {
+			case Walk2::ORANGE_TRACE_COLOR: {
+				_traceColor = nvgRGBA(0xff, 0x80, 0x00, 0xee);
+				break;
+			}
+			case Walk2::RED_TRACE_COLOR: {
+				_traceColor = nvgRGBA(0xff, 0x00, 0x00, 0xee);
+				break;
+			}
+			case Walk2::BLUE_TRACE_COLOR: {
+				_traceColor = nvgRGBA(0x00, 0xdd, 0xff, 0xee);
+				break;
+			}
+			case Walk2::GREEN_TRACE_COLOR:
+			default: {
+				_traceColor = _defaultTraceColor;
 			}
-			drawTrace(args, _traceColor, _module->_outsX, _module->_outsY);
 		}
 
+		nvgSave(args.vg);
+		transform(args, _module->_zoomOut, _module->_offsetX, _module->_offsetY);
+		drawTrace(args, _traceColor, _module->_outsX, _module->_outsY);
 		nvgRestore(args.vg);
 	}
 
@@ -283,7 +318,7 @@ struct Walk2Display : DisplayWidget {
 		nvgRestore(args.vg);
 	}
 
-	void drawAxes(const DrawArgs& args, float strokeWidth) {
+	void drawAxes(const DrawArgs& args, float strokeWidth, bool drawGrid) {
 		const float shortTick = 4.0f;
 		const float longTick = 8.0f;
 		float dot = 0.5f * strokeWidth;
@@ -327,7 +362,7 @@ struct Walk2Display : DisplayWidget {
 			nvgLineTo(args.vg, _midX + tick, _midY - y);
 			nvgStroke(args.vg);
 
-			if (!_module || _module->_drawGrid) {
+			if (drawGrid) {
 				for (int j = 1; j <= 10; ++j) {
 					float y = (j * 0.1f) * 0.5f * _drawSize.y;
 
@@ -354,7 +389,7 @@ struct Walk2Display : DisplayWidget {
 			}
 		}
 
-		if (!_module || _module->_drawGrid) {
+		if (drawGrid) {
 			const float tick = shortTick;
 			{
 				float x = _midX - _drawSize.x / 4;
@@ -58,7 +58,9 @@ struct Walk2 : BGModule {
 
 	float _offsetX = 0.0f, _offsetY = 0.0f;
 	float _scaleX = 0.0f, _scaleY = 0.0f;
-	RandomWalk _walkX, _walkY;
+	// the X walk runs in lane 0 and Y in lane 1, of as many groups as that takes.
+	static constexpr int walkGroups = (2 + laneWidth - 1) / laneWidth;
+	RandomWalkLanes _walks[walkGroups];
 	bogaudio::dsp::SlewLimiter _slewX, _slewY;
 	Trigger _jumpTrigger;
 	HistoryBuffer<float> _outsX, _outsY;
@@ -110,6 +112,9 @@ struct Walk2 : BGModule {
 	void modulate() override;
 	void processAlways(const ProcessArgs& args) override;
 	void processAll(const ProcessArgs& args) override;
+	inline void setWalkParams(int xy, float sampleRate, float change) { _walks[xy / laneWidth].setParams(xy % laneWidth, sampleRate, change); }
+	inline void tellWalk(int xy, float v) { _walks[xy / laneWidth].tell(xy % laneWidth, v); }
+	inline void jumpWalk(int xy) { _walks[xy / laneWidth].jump(xy % laneWidth); }
 };
 
 } // namespace bogaudio
@@ -48,7 +48,6 @@ void ChannelAnalyzer::work() {
 			process = false;
 
 			_analyzer.process();
-			_analyzer.postProcess();
 			float* bins = _bins0;
 			if (_currentBins == _bins0) {
 				bins = _bins1;
@@ -453,16 +452,23 @@ void AnalyzerDisplay::channelLabel(int channel, std::string label) {
 	_channelLabels[channel] = label;
 }
 
-void AnalyzerDisplay::drawOnce(const DrawArgs& args, bool screenshot, bool lit) {
-	if (!screenshot) {
-		assert(_module);
-		_module->_core._channelsMutex.lock();
+void AnalyzerDisplay::step() {
+	if (_module && (
+		_module->_frequencyPlot != _staticFrequencyPlot ||
+		_module->_amplitudePlot != _staticAmplitudePlot ||
+		_module->_rangeMinHz != _staticRangeMinHz ||
+		_module->_rangeMaxHz != _staticRangeMaxHz
+	)) {
+		invalidateStatic();
 	}
+	DisplayWidget::step();
+}
 
-	FrequencyPlot frequencyPlot = LOG_FP;
-	AmplitudePlot amplitudePlot = DECIBELS_80_AP;
-	float rangeMinHz = 0.0f;
-	float rangeMaxHz = 0.0f;
+void AnalyzerDisplay::plotSettings(bool screenshot, FrequencyPlot& frequencyPlot, AmplitudePlot& amplitudePlot, float& rangeMinHz, float& rangeMaxHz) {
+	frequencyPlot = LOG_FP;
+	amplitudePlot = DECIBELS_80_AP;
+	rangeMinHz = 0.0f;
+	rangeMaxHz = 0.0f;
 	if (!screenshot) {
 		frequencyPlot = _module->_frequencyPlot;
 		amplitudePlot = _module->_amplitudePlot;
@@ -475,7 +481,6 @@ void AnalyzerDisplay::drawOnce(const DrawArgs& args, bool screenshot, bool lit)
 		rangeMaxHz = 0.5f * APP->engine->getSampleRate();
 	}
 
-	float strokeWidth = std::max(1.0f, 3.0f - getZoom());
 	if (frequencyPlot == LINEAR_FP) {
 		_xAxisLogFactor = 1.0f;
 	}
@@ -484,49 +489,65 @@ void AnalyzerDisplay::drawOnce(const DrawArgs& args, bool screenshot, bool lit)
 		_xAxisLogFactor *= 1.0f - baseXAxisLogFactor;
 		_xAxisLogFactor = 1.0f - _xAxisLogFactor;
 	}
+}
+
+void AnalyzerDisplay::drawStatic(const DrawArgs& args, bool screenshot, bool lit) {
+	plotSettings(screenshot, _staticFrequencyPlot, _staticAmplitudePlot, _staticRangeMinHz, _staticRangeMaxHz);
+	float strokeWidth = std::max(1.0f, 3.0f - getZoom());
 
 	nvgSave(args.vg);
 	drawBackground(args);
 	nvgScissor(args.vg, _insetAround, _insetAround, _size.x - _insetAround, _size.y - _insetAround);
-	if (isScreenshot() || !lit) {
-		drawYAxis(args, strokeWidth, amplitudePlot);
-		drawXAxis(args, strokeWidth, frequencyPlot, rangeMinHz, rangeMaxHz);
+	drawYAxis(args, strokeWidth, _staticAmplitudePlot);
+	drawXAxis(args, strokeWidth, _staticFrequencyPlot, _staticRangeMinHz, _staticRangeMaxHz);
+	nvgRestore(args.vg);
+}
+
+void AnalyzerDisplay::drawOnce(const DrawArgs& args, bool screenshot, bool lit) {
+	if (screenshot || !lit) {
+		return;
 	}
-	else {
-		drawHeader(args, rangeMinHz, rangeMaxHz);
-		drawYAxis(args, strokeWidth, amplitudePlot);
-		drawXAxis(args, strokeWidth, frequencyPlot, rangeMinHz, rangeMaxHz);
-		int freezeBinI = 0;
-		float freezeLowHz = 0.0f;
-		float freezeHighHz = 0.0f;
-		if (_freezeDraw) {
-			freezeValues(rangeMinHz, rangeMaxHz, freezeBinI, freezeLowHz, freezeHighHz);
-			_freezeLastBinI = freezeBinI;
-			drawFreezeUnder(args, freezeLowHz, freezeHighHz, rangeMinHz, rangeMaxHz, strokeWidth);
-		}
+	assert(_module);
+	_module->_core._channelsMutex.lock();
 
-		for (int i = 0; i < _module->_core._nChannels; ++i) {
-			if (_displayChannel[i]) {
-				if (_module->_core._channels[i]) {
-					GenericBinsReader br(_freezeBufs ? _freezeBufs + i * _module->_core._outBufferN : _module->_core.getBins(i));
-					drawGraph(args, br, _channelColors[i % channelColorsN], strokeWidth, frequencyPlot, rangeMinHz, rangeMaxHz, amplitudePlot);
-				}
-				else if (_channelBinsReaderFactories[i]) {
-					std::unique_ptr<BinsReader> br = _channelBinsReaderFactories[i](_module->_core);
-					drawGraph(args, *br, _channelColors[i % channelColorsN], strokeWidth, frequencyPlot, rangeMinHz, rangeMaxHz, amplitudePlot);
-				}
+	FrequencyPlot frequencyPlot;
+	AmplitudePlot amplitudePlot;
+	float rangeMinHz;
+	float rangeMaxHz;
+	plotSettings(screenshot, frequencyPlot, amplitudePlot, rangeMinHz, rangeMaxHz);
+	float strokeWidth = std::max(1.0f, 3.0f - getZoom());
+
+	nvgSave(args.vg);
+	nvgScissor(args.vg, _insetAround, _insetAround, _size.x - _insetAround, _size.y - _insetAround);
+	drawHeader(args, rangeMinHz, rangeMaxHz);
+	int freezeBinI = 0;
+	float freezeLowHz = 0.0f;
+	float freezeHighHz = 0.0f;
+	if (_freezeDraw) {
+		freezeValues(rangeMinHz, rangeMaxHz, freezeBinI, freezeLowHz, freezeHighHz);
+		_freezeLastBinI = freezeBinI;
+		drawFreezeUnder(args, freezeLowHz, freezeHighHz, rangeMinHz, rangeMaxHz, strokeWidth);
+	}
+
+	for (int i = 0; i < _module->_core._nChannels; ++i) {
+		if (_displayChannel[i]) {
+			if (_module->_core._channels[i]) {
+				GenericBinsReader br(_freezeBufs ? _freezeBufs + i * _module->_core._outBufferN : _module->_core.getBins(i));
+				drawGraph(args, br, _channelColors[i % channelColorsN], strokeWidth, frequencyPlot, rangeMinHz, rangeMaxHz, amplitudePlot);
+			}
+			else if (_channelBinsReaderFactories[i]) {
+				std::unique_ptr<BinsReader> br = _channelBinsReaderFactories[i](_module->_core);
+				drawGraph(args, *br, _channelColors[i % channelColorsN], strokeWidth, frequencyPlot, rangeMinHz, rangeMaxHz, amplitudePlot);
 			}
 		}
+	}
 
-		if (_freezeDraw) {
-			drawFreezeOver(args, freezeBinI, _module->_core._size / _module->_core._binAverageN, freezeLowHz, freezeHighHz, strokeWidth);
-		}
+	if (_freezeDraw) {
+		drawFreezeOver(args, freezeBinI, _module->_core._size / _module->_core._binAverageN, freezeLowHz, freezeHighHz, strokeWidth);
 	}
 	nvgRestore(args.vg);
 
-	if (!screenshot) {
-		_module->_core._channelsMutex.unlock();
-	}
+	_module->_core._channelsMutex.unlock();
 }
 
 void AnalyzerDisplay::drawBackground(const DrawArgs& args) {
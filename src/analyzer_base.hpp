@@ -234,6 +234,10 @@ struct AnalyzerDisplay : DisplayWidget, AnalyzerTypes {
 	float* _freezeBufs = NULL;
 	int _freezeNudgeBin = 0;
 	int _freezeLastBinI = -1;
+	FrequencyPlot _staticFrequencyPlot = LOG_FP;
+	AmplitudePlot _staticAmplitudePlot = DECIBELS_80_AP;
+	float _staticRangeMinHz = 0.0f;
+	float _staticRangeMaxHz = 0.0f;
 
 	AnalyzerDisplay(
 		AnalyzerBase* module,
@@ -247,6 +251,7 @@ struct AnalyzerDisplay : DisplayWidget, AnalyzerTypes {
 	, _drawInset(drawInset)
 	, _fontPath(asset::plugin(pluginInstance, "res/fonts/inconsolata.ttf"))
 	{
+		_cacheStatic = true;
 		if (_module) {
 			_channelBinsReaderFactories = new BinsReaderFactory[_module->_core._nChannels] {};
 			_displayChannel = new bool[_module->_core._nChannels] {};
@@ -269,6 +274,9 @@ struct AnalyzerDisplay : DisplayWidget, AnalyzerTypes {
 	void setChannelBinsReaderFactory(int channel, BinsReaderFactory brf);
 	void displayChannel(int channel, bool display);
 	void channelLabel(int channel, std::string label);
+	void step() override;
+	void plotSettings(bool screenshot, FrequencyPlot& frequencyPlot, AmplitudePlot& amplitudePlot, float& rangeMinHz, float& rangeMaxHz);
+	void drawStatic(const DrawArgs& args, bool screenshot, bool lit) override;
 	void drawOnce(const DrawArgs& args, bool screenshot, bool lit) override;
 	void drawBackground(const DrawArgs& args);
 	virtual void drawHeader(const DrawArgs& args, float rangeMinHz, float rangeMaxHz);
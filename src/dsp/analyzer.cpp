@@ -3,11 +3,16 @@
 
 #include "buffer.hpp"
 #include "analyzer.hpp"
+#include "oscillator.hpp"
 
 using namespace bogaudio::dsp;
 
 void Window::apply(float* in, float* out) {
-	for (int i = 0; i < _size; ++i) {
+	int i = 0;
+	for (; i + laneWidth <= _size; i += laneWidth) {
+		lanes::store(out + i, lanes::load(in + i) * lanes::load(_window + i));
+	}
+	for (; i < _size; ++i) {
 		out[i] = in[i] * _window[i];
 	}
 }
@@ -213,6 +218,7 @@ SpectrumAnalyzer::SpectrumAnalyzer(
 	}
 
 	_fftOut = new float[_size];
+	_normalization = 2.0 / powf(_window ? _window->sum() : _size, 2.0);
 }
 
 SpectrumAnalyzer::~SpectrumAnalyzer() {
@@ -269,20 +275,226 @@ void SpectrumAnalyzer::processBuffer(float* samples) {
 	}
 }
 
+// The FFT output has the real parts of bands [0, _size/2) followed by the
+// imaginary parts; the power of each band is normalized and averaged across
+// the bands making up each bin.
 void SpectrumAnalyzer::getMagnitudes(float* bins, int nBins) {
 	assert(nBins <= _size / 2);
 	assert(_size % nBins == 0);
 
 	const int bands = _size / 2;
 	const int binWidth = bands / nBins;
-	const float invBinWidth = 1.0 / (float)binWidth;
-	const float normalization = 2.0 / powf(_window ? _window->sum() : _size, 2.0);
-	for (int bin = 0; bin < nBins; ++bin) {
-		float sum = 0.0;
-		int binEnd = bin * binWidth + binWidth;
-		for (int i = binEnd - binWidth; i < binEnd; ++i) {
-			sum += (_fftOut[i]*_fftOut[i] + _fftOut[i + bands]*_fftOut[i + bands]) * normalization;
+	const float* re = _fftOut;
+	const float* im = _fftOut + bands;
+	if (binWidth == 1) {
+		int i = 0;
+		for (; i + laneWidth <= bands; i += laneWidth) {
+			lanes_t r = lanes::load(re + i);
+			lanes_t m = lanes::load(im + i);
+			lanes::store(bins + i, (r*r + m*m) * _normalization);
+		}
+		for (; i < bands; ++i) {
+			bins[i] = (re[i]*re[i] + im[i]*im[i]) * _normalization;
+		}
+	}
+	else if (binWidth % laneWidth == 0) {
+		const float scale = _normalization / (float)binWidth;
+		for (int bin = 0, i = 0; bin < nBins; ++bin) {
+			lanes_t sum = 0.0f;
+			for (int binEnd = i + binWidth; i < binEnd; i += laneWidth) {
+				lanes_t r = lanes::load(re + i);
+				lanes_t m = lanes::load(im + i);
+				sum = sum + r*r + m*m;
+			}
+			bins[bin] = lanes::sum(sum) * scale;
+		}
+	}
+	else {
+		const float scale = _normalization / (float)binWidth;
+		for (int bin = 0, i = 0; bin < nBins; ++bin) {
+			float sum = 0.0f;
+			for (int binEnd = i + binWidth; i < binEnd; ++i) {
+				sum += re[i]*re[i] + im[i]*im[i];
+			}
+			bins[bin] = sum * scale;
 		}
-		bins[bin] = sum * invBinWidth;
 	}
 }
+
+
+constexpr int SweepDeconvolver::maxHarmonic;
+constexpr int SweepDeconvolver::preSamples;
+constexpr float SweepDeconvolver::bandEdgeRatio;
+
+SweepDeconvolver::~SweepDeconvolver() {
+	dispose();
+}
+
+void SweepDeconvolver::dispose() {
+	if (_fft) {
+		delete _fft;
+		delete _segmentFft;
+		delete[] _inverse;
+		delete[] _work;
+		delete[] _spectrum;
+		delete[] _impulseResponse;
+		delete[] _magnitudes;
+		delete[] _phases;
+		delete[] _harmonics;
+		_fft = NULL;
+	}
+}
+
+void SweepDeconvolver::setParams(float sampleRate, float frequency1, float frequency2, int size, float amplitude) {
+	assert(sampleRate > 0.0f);
+	assert(frequency1 > 0.0f && frequency1 < frequency2);
+	assert(size >= 2 * preSamples && (size & (size - 1)) == 0);
+	assert(amplitude > 0.0f);
+	if (_sampleRate == sampleRate && _frequency1 == frequency1 && _frequency2 == frequency2 && _size == size && _amplitude == amplitude) {
+		return;
+	}
+	if (_size != size) {
+		dispose();
+		_size = size;
+		_fftSize = 2 * size;
+		_fft = new ffft::FFTReal<float>(_fftSize);
+		_segmentFft = new ffft::FFTReal<float>(_size);
+		_inverse = new float[_fftSize];
+		_work = new float[_fftSize];
+		_spectrum = new float[_fftSize];
+		_impulseResponse = new float[_size] {};
+		_magnitudes = new float[_size / 2] {};
+		_phases = new float[_size / 2] {};
+		_harmonics = new float[(maxHarmonic - 1) * (_size / 2)] {};
+	}
+	_sampleRate = sampleRate;
+	_frequency1 = frequency1;
+	_frequency2 = frequency2;
+	_amplitude = amplitude;
+
+	PureChirpOscillator chirp;
+	chirp.setSampleRate(_sampleRate);
+	chirp.setParams(_frequency1, _frequency2, _size / (double)_sampleRate, false);
+	for (int i = 0; i < _size; ++i) {
+		_work[i] = _amplitude * chirp.next();
+	}
+	std::fill(_work + _size, _work + _fftSize, 0.0f);
+	_fft->do_fft(_inverse, _work);
+
+	// inverse = conj(X) / (|X|^2 + e), with e tiny where the sweep has energy
+	// and large outside it, so out-of-band noise isn't amplified.  ffft keeps
+	// the real parts of bins [0, N/2] then the negated imaginary parts of bins
+	// [1, N/2); either sign of imaginary gives the same arithmetic here.  The
+	// inverse FFT's missing 1/N is folded in.
+	const int half = _fftSize / 2;
+	const float binHz = _sampleRate / (float)_fftSize;
+	float maxPower = 0.0f;
+	for (int k = 0; k <= half; ++k) {
+		float im = (k > 0 && k < half) ? _inverse[half + k] : 0.0f;
+		float hz = k * binHz;
+		if (hz >= _frequency1 && hz <= _frequency2) {
+			maxPower = std::max(maxPower, _inverse[k]*_inverse[k] + im*im);
+		}
+	}
+	const float invN = 1.0f / (float)_fftSize;
+	for (int k = 0; k <= half; ++k) {
+		float re = _inverse[k];
+		float im = (k > 0 && k < half) ? _inverse[half + k] : 0.0f;
+		float hz = k * binHz;
+		float e = (hz >= _frequency1 && hz <= _frequency2) ? 1e-6f * maxPower : maxPower;
+		float d = invN / (re*re + im*im + e);
+		_inverse[k] = re * d;
+		if (k > 0 && k < half) {
+			_inverse[half + k] = -im * d;
+		}
+	}
+}
+
+float SweepDeconvolver::harmonicDelay(int k) {
+	return _size * logf((float)k) / logf(_frequency2 / _frequency1);
+}
+
+void SweepDeconvolver::analyze(const float* response) {
+	assert(_fft);
+	deconvolve(response);
+
+	const int bins = _size / 2;
+	segmentSpectrum(-preSamples, _size, _size / 8, _impulseResponse);
+	const float alignment = 2.0f * M_PI * preSamples / (float)_size;
+	for (int i = 0; i < bins; ++i) {
+		float re = _spectrum[i];
+		float im = i > 0 ? -_spectrum[bins + i] : 0.0f;
+		_magnitudes[i] = sqrtf(re*re + im*im);
+		float phase = atan2f(im, re) + alignment * i;
+		_phases[i] = phase - 2.0f * M_PI * floorf((phase + M_PI) / (2.0f * M_PI));
+	}
+
+	float lastDelay = 0.0f;
+	for (int k = 2; k <= maxHarmonic; ++k) {
+		float* h = harmonic(k);
+		float delay = harmonicDelay(k);
+		int n = delay - lastDelay;
+		if (delay + preSamples > _size || n < 1) {
+			std::fill(h, h + bins, 0.0f);
+			continue;
+		}
+		segmentSpectrum(-(int)delay - preSamples, n, n / 4, NULL);
+		const float binHz = _sampleRate / (float)_size;
+		for (int i = 0; i < bins; ++i) {
+			int j = k * i;
+			if (j < bins && i * binHz >= bandEdgeRatio * _frequency1 && j * binHz * bandEdgeRatio <= _frequency2) {
+				float re = _spectrum[j];
+				float im = j > 0 ? _spectrum[bins + j] : 0.0f;
+				h[i] = sqrtf(re*re + im*im);
+			}
+			else {
+				h[i] = 0.0f;
+			}
+		}
+		lastDelay = delay;
+	}
+}
+
+// leaves the circular impulse response, harmonics at negative times, in _work.
+void SweepDeconvolver::deconvolve(const float* response) {
+	const int n = responseSamples();
+	std::copy(response, response + n, _work);
+	std::fill(_work + n, _work + _fftSize, 0.0f);
+	_fft->do_fft(_spectrum, _work);
+
+	const int half = _fftSize / 2;
+	_spectrum[0] *= _inverse[0];
+	_spectrum[half] *= _inverse[half];
+	for (int k = 1; k < half; ++k) {
+		float a = _spectrum[k];
+		float b = _spectrum[half + k];
+		float c = _inverse[k];
+		float d = _inverse[half + k];
+		_spectrum[k] = a*c - b*d;
+		_spectrum[half + k] = a*d + b*c;
+	}
+	_fft->do_ifft(_spectrum, _work);
+}
+
+// transforms n samples of the impulse response, from start (which may be
+// negative), zero-padded to _size and faded out over the last fadeOut
+// samples, into _spectrum; the windowed segment is copied to out if given.
+void SweepDeconvolver::segmentSpectrum(int start, int n, int fadeOut, float* out) {
+	assert(n <= _size);
+	float* segment = _spectrum + _size;
+	const int mask = _fftSize - 1;
+	for (int i = 0; i < n; ++i) {
+		segment[i] = _work[(start + i) & mask];
+	}
+	std::fill(segment + n, segment + _size, 0.0f);
+	for (int i = 0, fadeIn = std::min(preSamples, n / 2); i < fadeIn; ++i) {
+		segment[i] *= 0.5f - 0.5f * cosf(M_PI * i / (float)fadeIn);
+	}
+	for (int i = 0; i < fadeOut; ++i) {
+		segment[n - fadeOut + i] *= 0.5f + 0.5f * cosf(M_PI * i / (float)fadeOut);
+	}
+	if (out) {
+		std::copy(segment, segment + _size, out);
+	}
+	_segmentFft->do_fft(_spectrum, segment);
+}
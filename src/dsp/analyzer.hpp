@@ -6,6 +6,7 @@
 #include "ffft/FFTReal.h"
 
 #include "buffer.hpp"
+#include "lanes.hpp"
 
 namespace bogaudio {
 namespace dsp {
@@ -126,6 +127,7 @@ struct SpectrumAnalyzer : OverlappingBuffer<float> {
 	Window* _window = NULL;
 	float* _windowOut = NULL;
 	float* _fftOut = NULL;
+	float _normalization;
 
 	SpectrumAnalyzer(
 		Size size,
@@ -140,5 +142,59 @@ struct SpectrumAnalyzer : OverlappingBuffer<float> {
 	void getMagnitudes(float* bins, int nBins);
 };
 
+// Impulse response measurement from a single exponential sine sweep (after
+// Farina).  setParams() renders the sweep the caller will play, with
+// PureChirpOscillator so it matches sample for sample, and precomputes a
+// regularized inverse filter for it.  analyze() takes the recorded return --
+// the sweep plus a decay tail, responseSamples() long -- and deconvolves it
+// with one forward and one inverse FFT.  With an exponential sweep, the k-th
+// harmonic's impulse response lands harmonicDelay(k) samples ahead of the
+// linear one, so distortion orders are cut out of the same result.
+//
+// Spectra are _size / 2 bins of sampleRate / _size Hz: _magnitudes are
+// linear gains, _phases radians with the capture alignment taken out, and
+// harmonic k's gains are indexed by excitation frequency, so bin i is the
+// level of the k-th harmonic produced by a sine at bin i's frequency (zero
+// where either is within bandEdgeRatio of the sweep's ends, where the sweep's
+// abrupt start and stop smear into the harmonic windows).
+struct SweepDeconvolver {
+	static constexpr int maxHarmonic = 5;
+	static constexpr int preSamples = 32;
+	static constexpr float bandEdgeRatio = 1.05f;
+
+	int _size = 0;
+	int _fftSize = 0;
+	float _sampleRate = 0.0f;
+	float _frequency1 = 0.0f;
+	float _frequency2 = 0.0f;
+	float _amplitude = 1.0f;
+	ffft::FFTReal<float>* _fft = NULL;
+	ffft::FFTReal<float>* _segmentFft = NULL;
+	float* _inverse = NULL;
+	float* _work = NULL;
+	float* _spectrum = NULL;
+	float* _impulseResponse = NULL;
+	float* _magnitudes = NULL;
+	float* _phases = NULL;
+	float* _harmonics = NULL;
+
+	SweepDeconvolver() {}
+	~SweepDeconvolver();
+
+	void setParams(float sampleRate, float frequency1, float frequency2, int size, float amplitude = 1.0f);
+	static constexpr int responseSamples(int size) { return size + size / 2; }
+	inline int responseSamples() { return responseSamples(_size); }
+	float harmonicDelay(int k);
+	inline float* harmonic(int k) {
+		assert(k >= 2 && k <= maxHarmonic);
+		return _harmonics + (k - 2) * (_size / 2);
+	}
+	void analyze(const float* response);
+
+	void dispose();
+	void deconvolve(const float* response);
+	void segmentSpectrum(int start, int n, int fadeOut, float* out);
+};
+
 } // namespace dsp
 } // namespace bogaudio
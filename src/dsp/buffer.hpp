@@ -4,27 +4,34 @@
 #include "math.h"
 #include <algorithm>
 
+#include "lanes.hpp"
+
 namespace bogaudio {
 namespace dsp {
 
+// Calls processBuffer() with the last _size samples, every _size / _overlap
+// samples once the first _size have arrived.  The history is a mirrored ring:
+// each sample is written at _sample and again at _sample + _size, so the
+// window ending at the write position is always contiguous at _samples +
+// _sample and nothing needs shifting between frames.
 template<typename T>
 struct OverlappingBuffer {
 	const int _size;
 	const int _overlap;
 	const bool _autoProcess;
 	const int _overlapN;
-	const int _samplesN;
 	T* _samples;
 	int _sample;
+	int _untilProcess;
 
 	OverlappingBuffer(int size, int o, bool autoProcess = true)
 	: _size(size)
 	, _overlap(o)
 	, _autoProcess(autoProcess)
 	, _overlapN(_size / _overlap)
-	, _samplesN(2*_size - _overlapN)
-	, _samples(new T[_samplesN])
+	, _samples(new T[2 * _size] {})
 	, _sample(0)
+	, _untilProcess(_size)
 	{
 		assert(_size > 0);
 		assert(_overlap > 0 && _overlap <= _size && _size % _overlap == 0);
@@ -33,26 +40,21 @@ struct OverlappingBuffer {
 		delete[] _samples;
 	}
 
-	inline void process() { processBuffer(_samples + _sample - _size); }
+	// oldest first; valid until the next step().
+	inline T* samples() { return _samples + _sample; }
+	inline void process() { processBuffer(samples()); }
 	virtual void processBuffer(T* samples) = 0;
-	void postProcess() {
-		if (_overlap == 1) {
-			_sample = 0;
-		}
-		else if (_sample == _samplesN) {
-			std::copy(_samples + _size, _samples + _samplesN, _samples);
-			_sample = _samplesN - _size;
-		}
-	}
 
 	virtual bool step(T sample) {
-		_samples[_sample++] = sample;
-		assert(_sample <= _samplesN);
+		_samples[_sample] = _samples[_sample + _size] = sample;
+		if (++_sample == _size) {
+			_sample = 0;
+		}
 
-		if (_sample >= _size && _sample % _overlapN == 0) {
+		if (--_untilProcess == 0) {
+			_untilProcess = _overlapN;
 			if (_autoProcess) {
 				process();
-				postProcess();
 			}
 			return true;
 		}
@@ -97,7 +99,11 @@ struct AveragingBuffer {
 
 	T* getInputFrame() {
 		float* frame = _frames + _currentFrame*_size;
-		for (int i = 0; i < _size; ++i) {
+		int i = 0;
+		for (; i + laneWidth <= _size; i += laneWidth) {
+			lanes::store(_sums + i, lanes::load(_sums + i) - lanes::load(frame + i));
+		}
+		for (; i < _size; ++i) {
 			_sums[i] -= frame[i];
 		}
 		return frame;
@@ -105,7 +111,13 @@ struct AveragingBuffer {
 
 	void commitInputFrame() {
 		float* frame = _frames + _currentFrame*_size;
-		for (int i = 0; i < _size; ++i) {
+		int i = 0;
+		for (; i + laneWidth <= _size; i += laneWidth) {
+			lanes_t sums = lanes::load(_sums + i) + lanes::load(frame + i);
+			lanes::store(_sums + i, sums);
+			lanes::store(_averages + i, sums * _inverseFramesN);
+		}
+		for (; i < _size; ++i) {
 			_sums[i] += frame[i];
 			_averages[i] = _sums[i] * _inverseFramesN;
 		}
@@ -127,36 +139,109 @@ struct AveragingBuffer {
 	}
 };
 
+// Circular buffer with power-of-two capacity, so indexes wrap with a mask.
+// Positions are given as delays back from the most recent sample, which is at
+// delay 0.  reserve() only reallocates to grow, so callers can size it for a
+// new sample rate without churning the allocation; the contents are kept
+// when it doesn't need to grow.
+template<typename T>
+struct RingBuffer {
+	int _capacity = 0;
+	int _mask = 0;
+	int _i = 0;
+	T* _buf = NULL;
+
+	RingBuffer(int size = 0, T initialValue = T()) {
+		reserve(size, initialValue);
+	}
+	~RingBuffer() {
+		if (_buf) {
+			delete[] _buf;
+		}
+	}
+
+	// ensures delays up to size - 1 can be read.
+	void reserve(int size, T initialValue = T()) {
+		assert(size >= 0);
+		if (size > _capacity) {
+			int capacity = 1;
+			while (capacity < size) {
+				capacity <<= 1;
+			}
+			if (_buf) {
+				delete[] _buf;
+			}
+			_capacity = capacity;
+			_mask = capacity - 1;
+			_i = 0;
+			_buf = new T[_capacity];
+			clear(initialValue);
+		}
+	}
+
+	inline void clear(T value = T()) {
+		std::fill(_buf, _buf + _capacity, value);
+	}
+
+	inline void push(T s) {
+		_i = (_i + 1) & _mask;
+		_buf[_i] = s;
+	}
+
+	inline T value(int delay) const {
+		assert(delay >= 0 && delay < _capacity);
+		return _buf[(_i - delay) & _mask];
+	}
+
+	// linearly interpolated read between whole delays.
+	inline T value(float delay) const {
+		assert(delay >= 0.0f && delay < (float)(_capacity - 1));
+		int d = delay;
+		float f = delay - (float)d;
+		T a = _buf[(_i - d) & _mask];
+		T b = _buf[(_i - d - 1) & _mask];
+		return a + f * (b - a);
+	}
+
+	// pushes n samples, oldest first, copying at most two spans.
+	void write(const T* samples, int n) {
+		assert(n >= 0 && n <= _capacity);
+		int start = (_i + 1) & _mask;
+		int first = std::min(n, _capacity - start);
+		std::copy(samples, samples + first, _buf + start);
+		std::copy(samples + first, samples + n, _buf);
+		_i = (_i + n) & _mask;
+	}
+
+	// copies the n samples ending delay samples back, oldest first.
+	void read(T* samples, int n, int delay = 0) const {
+		assert(n >= 0 && delay >= 0 && n + delay <= _capacity);
+		int start = (_i - delay - n + 1) & _mask;
+		int first = std::min(n, _capacity - start);
+		std::copy(_buf + start, _buf + start + first, samples);
+		std::copy(_buf, _buf + (n - first), samples + first);
+	}
+};
+
 template<typename T>
 struct HistoryBuffer {
-	int _size, _i;
-	T* _buf;
+	int _size;
+	RingBuffer<T> _buf;
 
 	HistoryBuffer(int size, T initialValue)
 	: _size(size)
-	, _i(0)
+	, _buf(size, initialValue)
 	{
 		assert(size > 0);
-		_buf = new T[size];
-		std::fill(_buf, _buf + size, initialValue);
-	}
-	~HistoryBuffer() {
-		delete[] _buf;
 	}
 
 	inline void push(T s) {
-		++_i;
-		_i %= _size;
-		_buf[_i] = s;
+		_buf.push(s);
 	}
 
 	inline T value(int i) {
 		assert(i >= 0 && i < _size);
-		int j = _i - i;
-		if (j < 0) {
-			j += _size;
-		}
-		return _buf[j];
+		return _buf.value(i);
 	}
 };
 
@@ -0,0 +1,170 @@
+#include <assert.h>
+#include <algorithm>
+
+#include "dynamics.hpp"
+#include "signal.hpp"
+
+using namespace bogaudio::dsp;
+
+constexpr float DynamicsProcessor::softKneeCompressorDb;
+constexpr float DynamicsProcessor::softKneeNoiseGateDb;
+
+void DynamicsProcessor::setSampleRate(float sampleRate) {
+	assert(sampleRate > 0.0f);
+	if (_sampleRate != sampleRate) {
+		_sampleRate = sampleRate;
+		if (_window) {
+			delete[] _window;
+		}
+		_windowN = std::max(1.0f, (_windowMS / 1000.0f) * _sampleRate);
+		_invWindowN = 1.0f / (float)_windowN;
+		_window = new lanes_t[maxGroups * _windowN];
+		std::fill(_window, _window + maxGroups * _windowN, lanes_t(0.0f));
+		for (Group& g : _groups) {
+			g.sum = 0.0f;
+			g.i = 0;
+		}
+	}
+}
+
+void DynamicsProcessor::setThreshold(int c, float thresholdDb) {
+	lanes::set(_groups[c / laneWidth].thresholdDb, c % laneWidth, thresholdDb);
+}
+
+void DynamicsProcessor::setRatio(int c, float ratio) {
+	assert(ratio >= 1.0f);
+	lanes::set(_groups[c / laneWidth].ratio, c % laneWidth, ratio);
+}
+
+void DynamicsProcessor::setAttackRelease(int c, float attackMS, float releaseMS, float range) {
+	assert(attackMS >= 0.0f);
+	assert(releaseMS >= 0.0f);
+	Group& g = _groups[c / laneWidth];
+	lanes::set(g.attackDelta, c % laneWidth, range / ((attackMS / 1000.0f) * _sampleRate));
+	lanes::set(g.releaseDelta, c % laneWidth, range / ((releaseMS / 1000.0f) * _sampleRate));
+}
+
+void DynamicsProcessor::setOutputLevel(int c, float level) {
+	lanes::set(_groups[c / laneWidth].outputLevel, c % laneWidth, level);
+}
+
+void DynamicsProcessor::reset(int c) {
+	Group& g = _groups[c / laneWidth];
+	int l = c % laneWidth;
+	lanes_t* w = _window + (c / laneWidth) * _windowN;
+	for (int i = 0; i < _windowN; ++i) {
+		lanes::set(w[i], l, 0.0f);
+	}
+	lanes::set(g.dcLastIn, l, 0.0f);
+	lanes::set(g.dcLastOut, l, 0.0f);
+	lanes::set(g.sum, l, 0.0f);
+	lanes::set(g.lastEnv, l, 0.0f);
+	lanes::set(g.env, l, 0.0f);
+	lanes::set(g.compressionDb, l, 0.0f);
+	lanes::set(g.level, l, 0.0f);
+}
+
+lanes_t DynamicsProcessor::next(int gi, const lanes_t& detector) {
+	Group& g = _groups[gi];
+
+	lanes_t env = detect(g, detector);
+	env = lanes::ifelse(
+		env > g.lastEnv,
+		lanes::fmin(g.lastEnv + g.attackDelta, env),
+		lanes::fmax(g.lastEnv - g.releaseDelta, env)
+	);
+	g.lastEnv = g.env = env;
+
+	lanes_t detectorDb = amplitudeToDecibels(env * 0.2f);
+	if (_mode == COMPRESSOR_MODE) {
+		g.compressionDb = compressorDb(detectorDb, g.thresholdDb, g.ratio, _softKnee);
+	}
+	else {
+		g.compressionDb = noiseGateDb(detectorDb, g.thresholdDb, g.ratio, _softKnee);
+	}
+	return g.level = decibelsToLevel(-g.compressionDb) * g.outputLevel;
+}
+
+// Rectified running average of the DC-blocked input, as FastRootMeanSquare.
+// The sum is recomputed from the window each time the index wraps, so float
+// accumulation error can't build up the way it would in a long-running sum.
+lanes_t DynamicsProcessor::detect(Group& g, const lanes_t& sample) {
+	if (_detector == PEAK_DETECTOR) {
+		return lanes::abs(sample);
+	}
+
+	const float r = 0.999f;
+	g.dcLastOut = sample - g.dcLastIn + r * g.dcLastOut;
+	g.dcLastIn = sample;
+	lanes_t s = lanes::abs(g.dcLastOut);
+
+	lanes_t* w = _window + (&g - _groups) * _windowN;
+	g.sum = g.sum - w[g.i] + s;
+	w[g.i] = s;
+	if (++g.i >= _windowN) {
+		g.i = 0;
+		lanes_t sum = 0.0f;
+		for (int i = 0; i < _windowN; ++i) {
+			sum = sum + w[i];
+		}
+		g.sum = sum;
+	}
+	return g.sum * _invWindowN;
+}
+
+// Same curves as Compressor::compressionDb: the soft knee starts
+// softKneeCompressorDb under the threshold and is a line whose slope
+// depends on distance from the knee start, simplified algebraically here.
+lanes_t DynamicsProcessor::compressorDb(const lanes_t& detectorDb, const lanes_t& thresholdDb, const lanes_t& ratio, bool softKnee) {
+	const lanes_t zero = 0.0f;
+	if (softKnee) {
+		const float k = softKneeCompressorDb;
+		lanes_t x = detectorDb - (thresholdDb - k);
+		lanes_t t = x / (k * lanes::fmin(ratio, Compressor::maxEffectiveRatio));
+		lanes_t s = (k * t + k) / (x + k);
+		return lanes::ifelse(x <= zero, zero, x - s * x);
+	}
+
+	lanes_t x = detectorDb - thresholdDb;
+	return lanes::ifelse(x <= zero, zero, x - x / ratio);
+}
+
+// Same curves as NoiseGate::compressionDb.
+lanes_t DynamicsProcessor::noiseGateDb(const lanes_t& detectorDb, const lanes_t& thresholdDb, const lanes_t& ratio, bool softKnee) {
+	const lanes_t zero = 0.0f;
+	const lanes_t maxDb = -Amplifier::minDecibels;
+	if (softKnee) {
+		const float k = softKneeNoiseGateDb;
+		lanes_t ix = thresholdDb + k;
+		lanes_t ox = thresholdDb - (thresholdDb - Amplifier::minDecibels) / ratio;
+		lanes_t t = (detectorDb - ox) / (ix - ox);
+		lanes_t px = k * t + thresholdDb;
+		lanes_t py = thresholdDb - t * thresholdDb;
+		lanes_t s = (py - Amplifier::minDecibels) / (px - ox);
+		lanes_t db = maxDb - s * (detectorDb - ox);
+		db = lanes::ifelse(detectorDb <= ox, maxDb, db);
+		return lanes::ifelse(detectorDb >= ix, zero, db);
+	}
+
+	lanes_t difference = thresholdDb - detectorDb;
+	lanes_t db = lanes::fmin(difference * ratio - difference, maxDb);
+	return lanes::ifelse(detectorDb >= thresholdDb, zero, db);
+}
+
+lanes_t DynamicsProcessor::amplitudeToDecibels(const lanes_t& amplitude) {
+	const float dbPerLn = 20.0f / M_LN10;
+	lanes_t a = lanes::fmax(amplitude, 0.000001f);
+	return lanes::ifelse(amplitude < 0.000001f, lanes_t(-120.0f), dbPerLn * lanes::log(a));
+}
+
+// Matches Amplifier's level table (a linear ramp to zero over the bottom
+// 6dB, otherwise 10^(db/20)), computed directly rather than looked up.
+lanes_t DynamicsProcessor::decibelsToLevel(const lanes_t& db) {
+	const float lnPerDb = M_LN10 / 20.0f;
+	const float rampDb = 6.0f;
+	const float rampTopDb = Amplifier::minDecibels + rampDb;
+	const float rampTop = decibelsToAmplitude(rampTopDb);
+	lanes_t level = lanes::exp(lanes::fmax(db, rampTopDb) * lnPerDb);
+	lanes_t ramp = lanes::fmax((db - Amplifier::minDecibels) * (rampTop / rampDb), 0.0f);
+	return lanes::ifelse(db <= rampTopDb, ramp, level);
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "lanes.hpp"
+
+namespace bogaudio {
+namespace dsp {
+
+// Shared compressor/noise gate/limiter chain, run for all channels together,
+// laneWidth channels at a time.  Per group this is: rectifying (DC-blocked,
+// averaged) or peak detector, attack/release slew, conversion to decibels,
+// gain computation with optional soft knee, and conversion of the resulting
+// gain back to a level.  Everything is branch-free per lane; it matches the
+// scalar RootMeanSquare -> SlewLimiter -> Compressor/NoiseGate -> Amplifier
+// chain it replaces in Pressor, Lmtr and Nsgt.
+struct DynamicsProcessor {
+	static constexpr int maxChannels = 16;
+	static constexpr int maxGroups = maxChannels / laneWidth;
+	static constexpr float softKneeCompressorDb = 3.0f;
+	static constexpr float softKneeNoiseGateDb = 6.0f;
+
+	enum Mode {
+		COMPRESSOR_MODE,
+		NOISE_GATE_MODE
+	};
+
+	enum Detector {
+		RMS_DETECTOR,
+		PEAK_DETECTOR
+	};
+
+	struct Group {
+		lanes_t thresholdDb = 0.0f;
+		lanes_t ratio = 1.0f;
+		lanes_t attackDelta = 1.0f;
+		lanes_t releaseDelta = 1.0f;
+		lanes_t outputLevel = 1.0f;
+
+		lanes_t dcLastIn = 0.0f;
+		lanes_t dcLastOut = 0.0f;
+		lanes_t sum = 0.0f;
+		lanes_t lastEnv = 0.0f;
+		int i = 0;
+
+		lanes_t env = 0.0f;
+		lanes_t compressionDb = 0.0f;
+		lanes_t level = 0.0f;
+	};
+
+	const float _windowMS;
+	float _sampleRate = -1.0f;
+	Mode _mode = COMPRESSOR_MODE;
+	Detector _detector = RMS_DETECTOR;
+	bool _softKnee = true;
+	int _windowN = 0;
+	float _invWindowN = 0.0f;
+	lanes_t* _window = NULL;
+	Group _groups[maxGroups];
+
+	DynamicsProcessor(float windowMS = 300.0f, float sampleRate = 1000.0f) : _windowMS(windowMS) {
+		setSampleRate(sampleRate);
+	}
+	~DynamicsProcessor() {
+		if (_window) {
+			delete[] _window;
+		}
+	}
+
+	void setSampleRate(float sampleRate);
+	inline void setMode(Mode mode) { _mode = mode; }
+	inline void setDetector(Detector detector) { _detector = detector; }
+	inline void setSoftKnee(bool softKnee) { _softKnee = softKnee; }
+	void setThreshold(int c, float thresholdDb);
+	void setRatio(int c, float ratio);
+	void setAttackRelease(int c, float attackMS, float releaseMS, float range = 10.0f);
+	void setOutputLevel(int c, float level);
+	void reset(int c);
+
+	// runs group g (channels g*laneWidth...) for one sample of detector input;
+	// returns the level to apply to the signal, which is also left in the group
+	// with the envelope and compression amount.
+	lanes_t next(int g, const lanes_t& detector);
+	inline const Group& group(int g) const { return _groups[g]; }
+
+	lanes_t detect(Group& g, const lanes_t& sample);
+	static lanes_t compressorDb(const lanes_t& detectorDb, const lanes_t& thresholdDb, const lanes_t& ratio, bool softKnee);
+	static lanes_t noiseGateDb(const lanes_t& detectorDb, const lanes_t& thresholdDb, const lanes_t& ratio, bool softKnee);
+	static lanes_t amplitudeToDecibels(const lanes_t& amplitude);
+	static lanes_t decibelsToLevel(const lanes_t& db);
+};
+
+} // namespace dsp
+} // namespace bogaudio
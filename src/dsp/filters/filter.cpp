@@ -1,4 +1,5 @@
 
+#include <assert.h>
 #include <math.h>
 
 #include "filters/filter.hpp"
@@ -6,25 +7,57 @@
 using namespace bogaudio::dsp;
 
 // See: http://www.musicdsp.org/files/Audio-EQ-Cookbook.txt
-void LowPassFilter::setParams(float sampleRate, float cutoff, float q) {
+// See: https://cytomic.com/files/dsp/SvfLinearTrapOptimised2.pdf
+void StateVariableFilter::setParams(float sampleRate, float cutoff, float q, Mode mode) {
+	_mode = mode;
 	if (_sampleRate == sampleRate && _cutoff == cutoff && _q == q) {
 		return;
 	}
 	_sampleRate = sampleRate;
 	_cutoff = cutoff;
 	_q = q;
-	// printf("\nLPF set param: sr=%f c=%f q=%f\n", _sampleRate, _cutoff, _q);
-
-	double w0 = 2.0 * M_PI * (double)(_cutoff / _sampleRate);
-	double cosw0 = cos(w0);
-	double alpha = sin(w0) / (2.0 * _q);
-
-	_biquad.setParams(
-		(1.0 - cosw0) / 2.0,
-		1.0 - cosw0,
-		(1.0 - cosw0) / 2.0,
-		1.0 + alpha,
-		-2.0 * cosw0,
-		1.0 - alpha
-	);
+	coefficients(_sampleRate, _cutoff, _q, _k, _a1, _a2, _a3);
+}
+
+void StateVariableFilter::reset() {
+	_ic1 = _ic2 = 0.0f;
+}
+
+void StateVariableFilter::coefficients(float sampleRate, float cutoff, float q, float& k, float& a1, float& a2, float& a3) {
+	assert(sampleRate > 0.0f);
+	assert(q > 0.0f);
+	double g = tan(M_PI * (double)(cutoff / sampleRate));
+	double dk = 1.0 / (double)q;
+	double da1 = 1.0 / (1.0 + g * (g + dk));
+	k = dk;
+	a1 = da1;
+	a2 = g * da1;
+	a3 = g * g * da1;
+}
+
+
+void LowPassFilterLanes::setParams(int lane, float sampleRate, float cutoff, float q) {
+	assert(lane >= 0 && lane < laneWidth);
+	if (_sampleRate[lane] == sampleRate && _cutoff[lane] == cutoff && _q[lane] == q) {
+		return;
+	}
+	_sampleRate[lane] = sampleRate;
+	_cutoff[lane] = cutoff;
+	_q[lane] = q;
+
+	float k, a1, a2, a3;
+	StateVariableFilter::coefficients(sampleRate, cutoff, q, k, a1, a2, a3);
+	lanes::set(_a1, lane, a1);
+	lanes::set(_a2, lane, a2);
+	lanes::set(_a3, lane, a3);
+}
+
+void LowPassFilterLanes::reset() {
+	_ic1 = _ic2 = 0.0f;
+}
+
+void LowPassFilterLanes::reset(int lane) {
+	assert(lane >= 0 && lane < laneWidth);
+	lanes::set(_ic1, lane, 0.0f);
+	lanes::set(_ic2, lane, 0.0f);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "buffer.hpp"
+#include "lanes.hpp"
 #include "signal.hpp"
 
 namespace bogaudio {
@@ -58,21 +59,96 @@ struct BiquadFilter : ResetableFilter {
 	}
 };
 
-struct LowPassFilter : ResetableFilter {
+// A topology-preserving (trapezoidal) state variable filter.  Its state is
+// its integrators' values rather than past inputs and outputs, so it stays
+// accurate in float at the very low cutoffs (relative to sample rate) where a
+// direct form biquad needs double.  Lowpass, bandpass and highpass share the
+// same state; the responses match the RBJ cookbook biquads.
+struct StateVariableFilter : ResetableFilter {
+	enum Mode {
+		LOWPASS_MODE,
+		BANDPASS_MODE,
+		HIGHPASS_MODE
+	};
+
 	float _sampleRate = 0.0f;
 	float _cutoff = 0.0f;
 	float _q = 0.0f;
+	Mode _mode = LOWPASS_MODE;
+	float _k = 0.0f;
+	float _a1 = 0.0f;
+	float _a2 = 0.0f;
+	float _a3 = 0.0f;
+	float _ic1 = 0.0f;
+	float _ic2 = 0.0f;
+
+	StateVariableFilter(float sampleRate = 1000.0f, float cutoff = 100.0f, float q = 0.001f, Mode mode = LOWPASS_MODE) {
+		setParams(sampleRate, cutoff, q, mode);
+	}
 
-	BiquadFilter<double> _biquad; // double is necessary here to make low cutoffs work at high sample rates.
+	void setParams(float sampleRate, float cutoff, float q = 0.001f, Mode mode = LOWPASS_MODE);
+	void reset() override;
+	float next(float sample) override {
+		float v3 = sample - _ic2;
+		float v1 = _a1 * _ic1 + _a2 * v3;
+		float d2 = _a2 * _ic1 + _a3 * v3;
+		float v2 = _ic2 + d2;
+		_ic1 = 2.0f * v1 - _ic1;
+		_ic2 = v2 + d2;
+		switch (_mode) {
+			case BANDPASS_MODE: {
+				return v1;
+			}
+			case HIGHPASS_MODE: {
+				return sample - _k * v1 - v2;
+			}
+			default: {
+				return v2;
+			}
+		}
+	}
+
+	static void coefficients(float sampleRate, float cutoff, float q, float& k, float& a1, float& a2, float& a3);
+};
+
+struct LowPassFilter : ResetableFilter {
+	StateVariableFilter _filter;
 
 	LowPassFilter(float sampleRate = 1000.0f, float cutoff = 100.0f, float q = 0.001f) {
 		setParams(sampleRate, cutoff, q);
 	}
 
-	void setParams(float sampleRate, float cutoff, float q = 0.001f);
-	void reset() override { _biquad.reset(); }
+	inline void setParams(float sampleRate, float cutoff, float q = 0.001f) {
+		_filter.setParams(sampleRate, cutoff, q);
+	}
+	void reset() override { _filter.reset(); }
 	float next(float sample) override {
-		return _biquad.next(sample);
+		return _filter.next(sample);
+	}
+};
+
+// LowPassFilter for laneWidth channels at once, with per-lane parameters.
+struct LowPassFilterLanes {
+	float _sampleRate[laneWidth] {};
+	float _cutoff[laneWidth] {};
+	float _q[laneWidth] {};
+	lanes_t _a1 = 0.0f;
+	lanes_t _a2 = 0.0f;
+	lanes_t _a3 = 0.0f;
+	lanes_t _ic1 = 0.0f;
+	lanes_t _ic2 = 0.0f;
+
+	void setParams(int lane, float sampleRate, float cutoff, float q = 0.001f);
+	void reset();
+	void reset(int lane);
+	inline lanes_t next(const lanes_t& sample) {
+		lanes_t v3 = sample - _ic2;
+		lanes_t v1 = _a1 * _ic1 + _a2 * v3;
+		lanes_t d2 = _a2 * _ic1 + _a3 * v3;
+		lanes_t v2 = _ic2 + d2;
+		_ic1 = 2.0f * v1 - _ic1;
+		_ic2 = v2 + d2;
+		return v2;
 	}
 };
 
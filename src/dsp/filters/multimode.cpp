@@ -182,8 +182,8 @@ template<int N> float MultimodeDesigner<N>::effectiveMinimumFrequency() {
 	return minFrequency * std::max(1.0f, roundf(_sampleRate / 44100.0f));
 }
 
-template<int N> void MultimodeDesigner<N>::setParams(
-	BiquadBank<T, N>& biquads,
+template<int N> template<typename BANK> bool MultimodeDesigner<N>::setParams(
+	BANK& biquads,
 	float& outGain,
 	float sampleRate,
 	Type type,
@@ -474,12 +474,18 @@ template<int N> void MultimodeDesigner<N>::setParams(
 			}
 		}
 	}
+	return redesign;
 }
 
 template struct MultimodeDesigner<4>;
 template struct MultimodeDesigner<8>;
 template struct MultimodeDesigner<16>;
 
+template bool MultimodeDesigner<4>::setParams(BiquadBank<MultimodeTypes::T, 4>&, float&, float, Type, int, Mode, float, float, BandwidthMode, DelayMode);
+template bool MultimodeDesigner<8>::setParams(BiquadBank<MultimodeTypes::T, 8>&, float&, float, Type, int, Mode, float, float, BandwidthMode, DelayMode);
+template bool MultimodeDesigner<16>::setParams(BiquadBank<MultimodeTypes::T, 16>&, float&, float, Type, int, Mode, float, float, BandwidthMode, DelayMode);
+template bool MultimodeDesigner<MultimodeBankLanes::maxStages>::setParams(MultimodeBankLanes::LaneBiquads&, float&, float, Type, int, Mode, float, float, BandwidthMode, DelayMode);
+
 
 template<int N> void MultimodeBase<N>::setParams(
 	float sampleRate,
@@ -517,5 +523,259 @@ template struct MultimodeBase<4>;
 template struct MultimodeBase<8>;
 template struct MultimodeBase<16>;
 
+
+constexpr int MultimodeBankLanes::maxStages;
+
+MultimodeBankLanes::Band::Band() {
+	for (int i = 0; i < maxStages; ++i) {
+		a0[i] = 1.0f;
+		a1[i] = a2[i] = b1[i] = b2[i] = 0.0f;
+	}
+	reset();
+}
+
+void MultimodeBankLanes::Band::reset() {
+	for (int i = 0; i < maxStages; ++i) {
+		s1[i] = s2[i] = 0.0f;
+	}
+}
+
+void MultimodeBankLanes::Band::reset(int lane) {
+	for (int i = 0; i < maxStages; ++i) {
+		lanes::set(s1[i], lane, 0.0f);
+		lanes::set(s2[i], lane, 0.0f);
+	}
+}
+
+void MultimodeBankLanes::LaneBiquads::setN(int n, bool _minDelay) {
+	assert(n > 0 && n <= maxStages);
+	for (int i = n; i < _band.laneN[_lane]; ++i) {
+		setParams(i, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f);
+	}
+	_band.laneN[_lane] = n;
+	_band.n = *std::max_element(_band.laneN, _band.laneN + laneWidth);
+}
+
+void MultimodeBankLanes::LaneBiquads::setParams(int i, T a0, T a1, T a2, T b0, T b1, T b2) {
+	assert(i >= 0 && i < maxStages);
+	T ib0 = 1.0f / b0;
+	lanes::set(_band.a0[i], _lane, a0 * ib0);
+	lanes::set(_band.a1[i], _lane, a1 * ib0);
+	lanes::set(_band.a2[i], _lane, a2 * ib0);
+	lanes::set(_band.b1[i], _lane, b1 * ib0);
+	lanes::set(_band.b2[i], _lane, b2 * ib0);
+}
+
+MultimodeBankLanes::MultimodeBankLanes(int bands) : _bandsN(bands) {
+	assert(bands > 0);
+	_bands = new Band[_bandsN];
+	_designers = new MultimodeDesigner<maxStages>[_bandsN * laneWidth];
+}
+
+MultimodeBankLanes::~MultimodeBankLanes() {
+	delete[] _bands;
+	delete[] _designers;
+}
+
+bool MultimodeBankLanes::setParams(
+	int band,
+	int lane,
+	float sampleRate,
+	Type type,
+	int poles,
+	Mode mode,
+	float frequency,
+	float qbw,
+	BandwidthMode bwm
+) {
+	assert(band >= 0 && band < _bandsN);
+	assert(lane >= 0 && lane < laneWidth);
+	LaneBiquads biquads(_bands[band], lane);
+	float outGain = lanes::get(_bands[band].outGain, lane);
+	bool redesigned = _designers[band * laneWidth + lane].setParams(
+		biquads,
+		outGain,
+		sampleRate,
+		type,
+		poles,
+		mode,
+		frequency,
+		qbw,
+		bwm
+	);
+	lanes::set(_bands[band].outGain, lane, outGain);
+	return redesigned;
+}
+
+void MultimodeBankLanes::getDesign(int band, Design& design) const {
+	assert(band >= 0 && band < _bandsN);
+	const Band& b = _bands[band];
+	std::copy(b.laneN, b.laneN + laneWidth, design.laneN);
+	design.outGain = b.outGain;
+	std::copy(b.a0, b.a0 + maxStages, design.a0);
+	std::copy(b.a1, b.a1 + maxStages, design.a1);
+	std::copy(b.a2, b.a2 + maxStages, design.a2);
+	std::copy(b.b1, b.b1 + maxStages, design.b1);
+	std::copy(b.b2, b.b2 + maxStages, design.b2);
+}
+
+// stages past a lane's count are always left as pass-throughs, so copying
+// all of them leaves none of the lane's old design behind.
+void MultimodeBankLanes::setDesign(int band, int lane, const Design& design) {
+	assert(band >= 0 && band < _bandsN);
+	assert(lane >= 0 && lane < laneWidth);
+	Band& b = _bands[band];
+	for (int i = 0; i < maxStages; ++i) {
+		lanes::set(b.a0[i], lane, lanes::get(design.a0[i], lane));
+		lanes::set(b.a1[i], lane, lanes::get(design.a1[i], lane));
+		lanes::set(b.a2[i], lane, lanes::get(design.a2[i], lane));
+		lanes::set(b.b1[i], lane, lanes::get(design.b1[i], lane));
+		lanes::set(b.b2[i], lane, lanes::get(design.b2[i], lane));
+	}
+	lanes::set(b.outGain, lane, lanes::get(design.outGain, lane));
+	b.laneN[lane] = design.laneN[lane];
+	b.n = *std::max_element(b.laneN, b.laneN + laneWidth);
+	_designers[band * laneWidth + lane] = MultimodeDesigner<maxStages>();
+}
+
+void MultimodeBankLanes::reset() {
+	for (int i = 0; i < _bandsN; ++i) {
+		_bands[i].reset();
+	}
+}
+
+void MultimodeBankLanes::reset(int band, int lane) {
+	assert(band >= 0 && band < _bandsN);
+	assert(lane >= 0 && lane < laneWidth);
+	_bands[band].reset(lane);
+}
+
+lanes_t MultimodeBankLanes::next(int band, const lanes_t& sample) {
+	Band& b = _bands[band];
+	lanes_t x = sample;
+	for (int i = 0; i < b.n; ++i) {
+		lanes_t y = b.a0[i] * x + b.s1[i];
+		b.s1[i] = b.a1[i] * x - b.b1[i] * y + b.s2[i];
+		b.s2[i] = b.a2[i] * x - b.b2[i] * y;
+		x = y;
+	}
+	return b.outGain * x;
+}
+
+void MultimodeBankLanes::next(const lanes_t& sample, lanes_t* outs) {
+	for (int i = 0; i < _bandsN; ++i) {
+		outs[i] = next(i, sample);
+	}
+}
+
+
+constexpr int ButterworthLanes::maxSections;
+
+ButterworthLanes::ButterworthLanes() {
+	for (int i = 0; i < maxSections; ++i) {
+		_a0[i] = 1.0f;
+		_a1[i] = _a2[i] = _b1[i] = _b2[i] = 0.0f;
+	}
+	reset();
+}
+
+// the poles are as MultimodeDesigner's, its middle section's included:
+// a first-order section leads an odd count.
+void ButterworthLanes::setType(float sampleRate, int poles, Mode mode) {
+	assert(sampleRate > 0.0f);
+	assert(poles >= 1 && poles <= 2 * maxSections);
+	assert(mode == LOWPASS_MODE || mode == HIGHPASS_MODE);
+	if (_sampleRate == sampleRate && _poles == poles && _mode == mode) {
+		return;
+	}
+	_sampleRate = sampleRate;
+	_half2PiST = M_PI * (1.0f / sampleRate);
+	_minFrequency = minFrequency * std::max(1.0f, roundf(sampleRate / 44100.0f));
+	_poles = poles;
+	_mode = mode;
+	_firstOrder = poles % 2 == 1;
+	_biquadsN = poles / 2;
+
+	const T iq = 0.8f; // MultimodeDesigner's, for qbw 0.
+	int np = poles / 2 + _firstOrder;
+	for (int k = 1, j = np - 1; k <= np; ++k, --j) {
+		T a = (T)(2 * k + poles - 1) * M_PI / (T)(2 * poles);
+		T re = std::cos(a);
+		T im = std::sin(a);
+		if (_firstOrder && j == 0) {
+			_realPole = -re;
+		}
+		else {
+			int i = j - _firstOrder;
+			_poleX[i] = ((i == _biquadsN / 2) ? iq : 1.0f) * (re + re);
+			_poleY[i] = re * re + im * im;
+		}
+	}
+	for (int i = _firstOrder + _biquadsN; i < maxSections; ++i) {
+		_a0[i] = 1.0f;
+		_a1[i] = _a2[i] = _b1[i] = _b2[i] = 0.0f;
+	}
+}
+
+void ButterworthLanes::setFrequency(const lanes_t& frequency) {
+	assert(_poles > 0);
+	lanes_t f = lanes::fmin(lanes::fmax(frequency, _minFrequency), 0.49f * _sampleRate);
+	lanes_t wa = 0.0f;
+	for (int l = 0; l < laneWidth; ++l) {
+		lanes::set(wa, l, std::tan(lanes::get(f, l) * _half2PiST));
+	}
+	lanes_t wa2 = wa * wa;
+
+	int s = 0;
+	if (_firstOrder) {
+		if (_mode == LOWPASS_MODE) {
+			lanes_t ib0 = 1.0f / (wa * _realPole + 1.0f);
+			_a0[0] = _a1[0] = wa * ib0;
+			_b1[0] = (wa * _realPole - 1.0f) * ib0;
+		}
+		else {
+			lanes_t ib0 = 1.0f / (wa + _realPole);
+			_a0[0] = ib0;
+			_a1[0] = -ib0;
+			_b1[0] = (wa - _realPole) * ib0;
+		}
+		_a2[0] = _b2[0] = 0.0f;
+		++s;
+	}
+	for (int i = 0; i < _biquadsN; ++i, ++s) {
+		lanes_t xwa = _poleX[i] * wa;
+		if (_mode == LOWPASS_MODE) {
+			lanes_t ywa21 = _poleY[i] * wa2 + 1.0f;
+			lanes_t ib0 = 1.0f / (ywa21 - xwa);
+			_a0[s] = _a2[s] = wa2 * ib0;
+			_a1[s] = 2.0f * _a0[s];
+			_b1[s] = (2.0f * _poleY[i] * wa2 - 2.0f) * ib0;
+			_b2[s] = (ywa21 + xwa) * ib0;
+		}
+		else {
+			lanes_t wa2y = wa2 + _poleY[i];
+			lanes_t ib0 = 1.0f / (wa2y - xwa);
+			_a0[s] = _a2[s] = ib0;
+			_a1[s] = -2.0f * ib0;
+			_b1[s] = (2.0f * wa2 - 2.0f * _poleY[i]) * ib0;
+			_b2[s] = (wa2y + xwa) * ib0;
+		}
+	}
+}
+
+void ButterworthLanes::reset() {
+	for (int i = 0; i < maxSections; ++i) {
+		_s1[i] = _s2[i] = 0.0f;
+	}
+}
+
+void ButterworthLanes::reset(int lane) {
+	assert(lane >= 0 && lane < laneWidth);
+	for (int i = 0; i < maxSections; ++i) {
+		lanes::set(_s1[i], lane, 0.0f);
+		lanes::set(_s2[i], lane, 0.0f);
+	}
+}
+
 } // namespace dsp
 } // namespace bogaudio
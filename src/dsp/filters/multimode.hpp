@@ -3,6 +3,7 @@
 #include <complex>
 
 #include "filters/filter.hpp"
+#include "lanes.hpp"
 
 #ifdef RACK_SIMD
 #include "simd/Vector.hpp"
@@ -125,8 +126,10 @@ struct MultimodeDesigner : MultimodeTypes {
 	int _nBiquads = 0;
 
 	float effectiveMinimumFrequency();
-	void setParams(
-		BiquadBank<T, N>& biquads,
+	// returns whether the filter was redesigned.
+	template<typename BANK>
+	bool setParams(
+		BANK& biquads,
 		float& outGain,
 		float sampleRate,
 		Type type,
@@ -177,6 +180,130 @@ typedef MultimodeBase<16> MultimodeFilter16;
 typedef MultimodeBase<8> MultimodeFilter8;
 typedef MultimodeBase<4> MultimodeFilter4;
 
+// A bank of multimode filters (bands), each run on laneWidth channels at once.
+// Each band/lane is designed as a MultimodeFilter8 would be, but the cascade
+// runs as transposed direct form II biquads across lanes, with coefficients and state
+// stored per stage for all bands together.  Lanes of a band can differ in
+// parameters and even in stage count (extra stages pass through).  Design is
+// skipped for a band/lane whose parameters haven't changed.
+struct MultimodeBankLanes : MultimodeTypes {
+	static constexpr int maxStages = 8;
+
+	struct Band {
+		int n = 0;
+		int laneN[laneWidth] {};
+		lanes_t outGain = 1.0f;
+		lanes_t a0[maxStages];
+		lanes_t a1[maxStages];
+		lanes_t a2[maxStages];
+		lanes_t b1[maxStages];
+		lanes_t b2[maxStages];
+		lanes_t s1[maxStages];
+		lanes_t s2[maxStages];
+
+		Band();
+		void reset();
+		void reset(int lane);
+	};
+
+	// the biquad bank interface MultimodeDesigner designs into, for one lane
+	// of a band.
+	struct LaneBiquads {
+		Band& _band;
+		int _lane;
+
+		LaneBiquads(Band& band, int lane) : _band(band), _lane(lane) {}
+
+		void setN(int n, bool minDelay = false);
+		void setParams(int i, T a0, T a1, T a2, T b0, T b1, T b2);
+	};
+
+	// a band's coefficients without its state, so a bank running the same
+	// bands elsewhere can take a design rather than repeat it.
+	struct Design {
+		int laneN[laneWidth];
+		lanes_t outGain;
+		lanes_t a0[maxStages];
+		lanes_t a1[maxStages];
+		lanes_t a2[maxStages];
+		lanes_t b1[maxStages];
+		lanes_t b2[maxStages];
+	};
+
+	int _bandsN;
+	Band* _bands;
+	MultimodeDesigner<maxStages>* _designers;
+
+	MultimodeBankLanes(int bands);
+	~MultimodeBankLanes();
+
+	// returns whether the lane's filter was redesigned.
+	bool setParams(
+		int band,
+		int lane,
+		float sampleRate,
+		Type type,
+		int poles,
+		Mode mode,
+		float frequency,
+		float qbw,
+		BandwidthMode bwm = PITCH_BANDWIDTH_MODE
+	);
+	void getDesign(int band, Design& design) const;
+	// takes the lane's part of a design; the lane's next setParams() designs.
+	void setDesign(int band, int lane, const Design& design);
+	void reset();
+	void reset(int band, int lane);
+	lanes_t next(int band, const lanes_t& sample);
+	// runs every band on the same input.
+	void next(const lanes_t& sample, lanes_t* outs);
+};
+
+// A Butterworth lowpass or highpass of 1 to 4 poles, as MultimodeFilter4 with
+// BUTTERWORTH_TYPE and a qbw of 0 designs it, for laneWidth channels at once
+// with per-lane cutoffs.  The poles are worked out once per pole count; a
+// cutoff change then takes a tan per lane, and some arithmetic on all lanes
+// together, so the cutoff can be moved every few samples.
+struct ButterworthLanes : MultimodeTypes {
+	static constexpr int maxSections = 2;
+
+	float _sampleRate = 0.0f;
+	float _half2PiST = 0.0f;
+	float _minFrequency = minFrequency;
+	int _poles = 0;
+	Mode _mode = UNKNOWN_MODE;
+	bool _firstOrder = false;
+	int _biquadsN = 0;
+	float _realPole = 0.0f;
+	float _poleX[maxSections] {};
+	float _poleY[maxSections] {};
+	lanes_t _a0[maxSections];
+	lanes_t _a1[maxSections];
+	lanes_t _a2[maxSections];
+	lanes_t _b1[maxSections];
+	lanes_t _b2[maxSections];
+	lanes_t _s1[maxSections];
+	lanes_t _s2[maxSections];
+
+	ButterworthLanes();
+
+	void setType(float sampleRate, int poles, Mode mode);
+	void setFrequency(const lanes_t& frequency);
+	void reset();
+	void reset(int lane);
+
+	inline lanes_t next(const lanes_t& sample) {
+		lanes_t x = sample;
+		for (int i = 0, n = _firstOrder + _biquadsN; i < n; ++i) {
+			lanes_t y = _a0[i] * x + _s1[i];
+			_s1[i] = _a1[i] * x - _b1[i] * y + _s2[i];
+			_s2[i] = _a2[i] * x - _b2[i] * y;
+			x = y;
+		}
+		return x;
+	}
+};
+
 struct FourPoleButtworthLowpassFilter {
 	MultimodeFilter4 _filter;
 
@@ -66,6 +66,60 @@ float CICDecimator::next(const float* buf) {
 }
 
 
+constexpr float CICDecimatorLanes::maxInput;
+constexpr int CICDecimatorLanes::maxFactor;
+
+CICDecimatorLanes::CICDecimatorLanes(int stages, int factor) {
+	assert(stages > 0);
+	_stages = stages;
+	_integrators = new ilanes_t[_stages];
+	_combs = new ilanes_t[_stages];
+	std::fill(_integrators, _integrators + _stages, ilanes_t(0));
+	std::fill(_combs, _combs + _stages, ilanes_t(0));
+	setParams(0.0f, factor);
+}
+
+CICDecimatorLanes::~CICDecimatorLanes() {
+	delete[] _integrators;
+	delete[] _combs;
+}
+
+void CICDecimatorLanes::setParams(float _sampleRate, int factor) {
+	assert(factor > 0);
+	assert(factor <= maxFactor);
+	if (_factor != factor) {
+		_factor = factor;
+		float gain = pow(_factor, _stages);
+		_scale = (float)(1u << 31) / (gain * maxInput);
+		_outputScale = 1.0f / (gain * _scale);
+	}
+}
+
+// Integrates a stage at a time across the block, so each stage's running sum
+// stays in a register.
+lanes_t CICDecimatorLanes::next(const lanes_t* buf) {
+	assert(_factor <= maxFactor);
+	ilanes_t block[maxFactor];
+	for (int i = 0; i < _factor; ++i) {
+		block[i] = ilanes_t(buf[i] * _scale);
+	}
+	for (int j = 0; j < _stages; ++j) {
+		ilanes_t sum = _integrators[j];
+		for (int i = 0; i < _factor; ++i) {
+			block[i] = sum = lanes::wrappingAdd(sum, block[i]);
+		}
+		_integrators[j] = sum;
+	}
+	ilanes_t s = block[_factor - 1];
+	for (int i = 0; i < _stages; ++i) {
+		ilanes_t t = s;
+		s = lanes::wrappingSub(s, _combs[i]);
+		_combs[i] = t;
+	}
+	return lanes_t(s) * _outputScale;
+}
+
+
 CICInterpolator::CICInterpolator(int stages, int factor) {
 	assert(stages > 0);
 	_stages = stages;
@@ -2,6 +2,7 @@
 
 #include "filters/filter.hpp"
 #include "filters/experiments.hpp"
+#include "lanes.hpp"
 
 namespace bogaudio {
 namespace dsp {
@@ -41,6 +42,27 @@ struct CICDecimator : Decimator {
 	float next(const float* buf) override;
 };
 
+// CICDecimator for lanes_t groups of channels.  The integrators and combs are
+// 32-bit; a CIC filter works in wrapping arithmetic as long as its output fits,
+// so the fixed point scale is set from the filter's gain to leave headroom for
+// inputs within +/-maxInput.
+struct CICDecimatorLanes {
+	static constexpr float maxInput = 2.0f;
+	static constexpr int maxFactor = 16;
+	int _stages;
+	ilanes_t* _integrators;
+	ilanes_t* _combs;
+	int _factor = 0;
+	float _scale = 0.0f;
+	float _outputScale = 0.0f;
+
+	CICDecimatorLanes(int stages = 4, int factor = 8);
+	virtual ~CICDecimatorLanes();
+
+	void setParams(float sampleRate, int factor);
+	lanes_t next(const lanes_t* buf);
+};
+
 struct Interpolator {
 	Interpolator() {}
 	virtual ~Interpolator() {}
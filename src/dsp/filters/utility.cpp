@@ -42,3 +42,19 @@ void PucketteEnvelopeFollower::setParams(float sampleRate, float sensitivity) {
 float PucketteEnvelopeFollower::next(float sample) {
 	return _filter.next(fabsf(_dcBlocker.next(sample)));
 }
+
+
+void EnvelopeFollowerLanes::setParams(int lane, float sampleRate, float sensitivity) {
+	const float maxCutoff = 10000.0f;
+	const float minCutoff = 100.0f;
+	assert(sensitivity >= 0.0f && sensitivity <= 1.0f);
+	float cutoff = minCutoff + sensitivity * (maxCutoff - minCutoff);
+	_filter.setParams(lane, sampleRate, cutoff);
+}
+
+void EnvelopeFollowerLanes::reset(int lane) {
+	assert(lane >= 0 && lane < laneWidth);
+	lanes::set(_dcLastIn, lane, 0.0f);
+	lanes::set(_dcLastOut, lane, 0.0f);
+	_filter.reset(lane);
+}
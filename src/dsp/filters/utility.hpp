@@ -55,5 +55,21 @@ struct PucketteEnvelopeFollower {
 
 typedef PucketteEnvelopeFollower EnvelopeFollower;
 
+// EnvelopeFollower for laneWidth channels at once.
+struct EnvelopeFollowerLanes {
+	lanes_t _dcLastIn = 0.0f;
+	lanes_t _dcLastOut = 0.0f;
+	LowPassFilterLanes _filter;
+
+	void setParams(int lane, float sampleRate, float sensitivity);
+	void reset(int lane);
+	inline lanes_t next(const lanes_t& sample) {
+		const float r = 0.999f;
+		_dcLastOut = sample - _dcLastIn + r * _dcLastOut;
+		_dcLastIn = sample;
+		return _filter.next(lanes::abs(_dcLastOut));
+	}
+};
+
 } // namespace dsp
 } // namespace bogaudio
@@ -0,0 +1,59 @@
+
+#include <assert.h>
+
+#include "fm.hpp"
+
+using namespace bogaudio::dsp;
+
+constexpr int FMOperatorVoices::oversample;
+
+void FMOperatorVoices::setSampleRate(float sampleRate) {
+	assert(sampleRate > 0.0f);
+	_sampleRate = sampleRate;
+	for (Group& g : _groups) {
+		g.decimator.setParams(sampleRate, oversample);
+	}
+}
+
+void FMOperatorVoices::setFrequency(int c, float frequency) {
+	Group& g = _groups[c / laneWidth];
+	int64_t delta = (frequency / (float)(oversample * _sampleRate)) * (float)Phasor::cyclePhase;
+	lanes::set(g.delta, c % laneWidth, (int32_t)(uint32_t)delta);
+	lanes::set(g.sampleDelta, c % laneWidth, (int32_t)(uint32_t)(delta * oversample));
+}
+
+void FMOperatorVoices::resetPhase(int c) {
+	lanes::set(_groups[c / laneWidth].phase, c % laneWidth, 0);
+}
+
+void FMOperatorVoices::syncPhase(int c, int from) {
+	int32_t phase = lanes::get(_groups[from / laneWidth].phase, from % laneWidth);
+	lanes::set(_groups[c / laneWidth].phase, c % laneWidth, phase);
+}
+
+lanes_t FMOperatorVoices::next(int gi, const lanes_t& offset, const lanes_t& oversampleMix) {
+	const float phaseToCycles = 1.0f / (float)Phasor::cyclePhase;
+	Group& g = _groups[gi];
+	lanes_t offsetCycles = offset * (1.0f / Phasor::twoPI);
+
+	lanes_t sample = 0.0f;
+	if (lanes::any(oversampleMix > 0.0f)) {
+		for (int i = 0; i < oversample; ++i) {
+			g.phase = lanes::wrappingAdd(g.phase, g.delta);
+			g.buffer[i] = sineLanes(lanes_t(g.phase) * phaseToCycles + offsetCycles);
+		}
+		sample = oversampleMix * g.decimator.next(g.buffer);
+	}
+	else {
+		g.phase = lanes::wrappingAdd(g.phase, g.sampleDelta);
+	}
+	if (lanes::any(oversampleMix < 1.0f)) {
+		sample = sample + (1.0f - oversampleMix) * sineLanes(lanes_t(g.phase) * phaseToCycles + offsetCycles);
+	}
+	return sample;
+}
+
+void FMOperatorVoices::advance(int gi) {
+	Group& g = _groups[gi];
+	g.phase = lanes::wrappingAdd(g.phase, g.sampleDelta);
+}
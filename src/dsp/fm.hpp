@@ -0,0 +1,52 @@
+#pragma once
+
+#include "filters/resample.hpp"
+#include "oscillator.hpp"
+
+namespace bogaudio {
+namespace dsp {
+
+// The oscillator core of an FM operator (as FMOp) for up to maxChannels
+// voices, laneWidth voices at a time.  Each sample, a group runs oversample
+// steps of its phase, each through sineLanes with the group's phase offset
+// (FM and feedback, in radians), and decimates the result; that's blended
+// per voice with the plain sample at the final phase by oversampleMix, so
+// oversampling can be faded in and out per voice as in FMOp.  Phases are
+// 32-bit fixed point cycles, wrapping on overflow.
+struct FMOperatorVoices {
+	static constexpr int maxChannels = 16;
+	static constexpr int maxGroups = maxChannels / laneWidth;
+	static constexpr int oversample = 8;
+
+	struct Group {
+		ilanes_t phase = 0;
+		ilanes_t delta = 0;
+		ilanes_t sampleDelta = 0;
+		lanes_t buffer[oversample];
+		CICDecimatorLanes decimator;
+
+		Group() : decimator(4, oversample) {}
+	};
+
+	float _sampleRate = 1000.0f;
+	Group _groups[maxGroups];
+
+	FMOperatorVoices(float sampleRate = 1000.0f) {
+		setSampleRate(sampleRate);
+	}
+
+	void setSampleRate(float sampleRate);
+	void setFrequency(int c, float frequency);
+	void resetPhase(int c);
+	void syncPhase(int c, int from);
+
+	// advances group g's phases by one sample, returning its signal; offset
+	// and oversampleMix are per voice.  The oversampling loop is skipped if no
+	// voice in the group is oversampling.
+	lanes_t next(int g, const lanes_t& offset, const lanes_t& oversampleMix);
+	// advances group g's phases by one sample without generating anything.
+	void advance(int g);
+};
+
+} // namespace dsp
+} // namespace bogaudio
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <math.h>
+#include <cmath>
+#include <algorithm>
+#include <stdint.h>
+
+#ifdef RACK_SIMD
+#include "simd/Vector.hpp"
+#include "simd/functions.hpp"
+#endif
+
+namespace bogaudio {
+namespace dsp {
+
+// Lane-parallel processing of polyphonic channels.  With RACK_SIMD, channels
+// are packed into the lanes of a float_4, channel c living in lane
+// c % laneWidth of group c / laneWidth; otherwise lanes_t is a plain float and
+// each channel is its own one-lane group, so the same code serves both builds.
+// ilanes_t is the matching integer type, for phase accumulators and the like;
+// its addition wraps.  A comparison gives a mask, which any() tests and bits()
+// packs into an int, a bit per lane.
+#ifdef RACK_SIMD
+typedef rack::simd::float_4 lanes_t;
+typedef rack::simd::int32_4 ilanes_t;
+static constexpr int laneWidth = 4;
+
+namespace lanes {
+	using namespace rack::simd;
+
+	inline float get(const lanes_t& v, int i) { return v[i]; }
+	inline void set(lanes_t& v, int i, float x) { v[i] = x; }
+	inline lanes_t load(const float* p) { return lanes_t::load(p); }
+	inline void store(float* p, lanes_t v) { v.store(p); }
+	inline float sum(const lanes_t& v) { return (v[0] + v[1]) + (v[2] + v[3]); }
+	inline int32_t get(const ilanes_t& v, int i) { return v[i]; }
+	inline void set(ilanes_t& v, int i, int32_t x) { v[i] = x; }
+	inline ilanes_t wrappingAdd(const ilanes_t& a, const ilanes_t& b) { return a + b; }
+	inline ilanes_t wrappingSub(const ilanes_t& a, const ilanes_t& b) { return a - b; }
+	inline ilanes_t wrappingMul(const ilanes_t& a, const ilanes_t& b) { return a * b; }
+	inline bool any(const lanes_t& mask) { return movemask(mask) != 0; }
+	inline int bits(const lanes_t& mask) { return movemask(mask); }
+} // namespace lanes
+
+#else
+typedef float lanes_t;
+typedef int32_t ilanes_t;
+static constexpr int laneWidth = 1;
+
+namespace lanes {
+	inline float ifelse(bool cond, float a, float b) { return cond ? a : b; }
+	using std::fmax;
+	using std::fmin;
+	using std::abs;
+	using std::sqrt;
+	using std::floor;
+	using std::exp;
+	using std::log;
+	using std::pow;
+	using std::tan;
+	using std::tanh;
+
+	inline float get(const lanes_t& v, int i) { return v; }
+	inline void set(lanes_t& v, int i, float x) { v = x; }
+	inline lanes_t load(const float* p) { return *p; }
+	inline void store(float* p, lanes_t v) { *p = v; }
+	inline float sum(lanes_t v) { return v; }
+	inline int32_t get(const ilanes_t& v, int i) { return v; }
+	inline void set(ilanes_t& v, int i, int32_t x) { v = x; }
+	inline ilanes_t wrappingAdd(ilanes_t a, ilanes_t b) { return (int32_t)((uint32_t)a + (uint32_t)b); }
+	inline ilanes_t wrappingSub(ilanes_t a, ilanes_t b) { return (int32_t)((uint32_t)a - (uint32_t)b); }
+	inline ilanes_t wrappingMul(ilanes_t a, ilanes_t b) { return (int32_t)((uint32_t)a * (uint32_t)b); }
+	inline bool any(bool mask) { return mask; }
+	inline int bits(bool mask) { return mask; }
+} // namespace lanes
+
+#endif
+
+inline int laneGroups(int channels) {
+	return (channels + laneWidth - 1) / laneWidth;
+}
+
+} // namespace dsp
+} // namespace bogaudio
@@ -0,0 +1,131 @@
+
+#include <assert.h>
+
+#include "lpg.hpp"
+
+using namespace bogaudio::dsp;
+
+constexpr int LowPassGateVoices::cutoffSteps;
+constexpr float LowPassGateVoices::maxCutoff;
+constexpr float LowPassGateVoices::levelSlewMS;
+constexpr float LowPassGateVoices::finalHighpassCutoff;
+
+void LowPassGateVoices::setSampleRate(float sampleRate) {
+	assert(sampleRate > 0.0f);
+	if (_sampleRate == sampleRate) {
+		return;
+	}
+	_sampleRate = sampleRate;
+	_levelDelta = 1.0f / ((levelSlewMS / 1000.0f) * sampleRate);
+	for (Group& g : _groups) {
+		g.step = 0;
+		g.finalHighpass.setType(sampleRate, 2, MultimodeFilter::HIGHPASS_MODE);
+		g.finalHighpass.setFrequency(finalHighpassCutoff);
+	}
+	int lowpassPoles = _lowpassPoles;
+	_lowpassPoles = -1;
+	setFilters(lowpassPoles, _highpassPoles, _serial);
+}
+
+void LowPassGateVoices::setFilters(int lowpassPoles, int highpassPoles, bool serial) {
+	assert(lowpassPoles >= 0 && lowpassPoles <= 2 * ButterworthLanes::maxSections);
+	assert(highpassPoles >= 0 && highpassPoles <= 2 * ButterworthLanes::maxSections);
+	assert(lowpassPoles > 0 || highpassPoles > 0);
+	_serial = serial;
+	if (_lowpassPoles == lowpassPoles && _highpassPoles == highpassPoles) {
+		return;
+	}
+	_lowpassPoles = lowpassPoles;
+	_highpassPoles = highpassPoles;
+	for (Group& g : _groups) {
+		g.step = 0;
+		if (_lowpassPoles > 0) {
+			g.lowpass.setType(_sampleRate, _lowpassPoles, MultimodeFilter::LOWPASS_MODE);
+		}
+		if (_highpassPoles > 0) {
+			g.highpass.setType(_sampleRate, _highpassPoles, MultimodeFilter::HIGHPASS_MODE);
+		}
+	}
+}
+
+void LowPassGateVoices::setVCA(bool linear, bool slewLevel) {
+	_linear = linear;
+	_slewLevel = slewLevel;
+}
+
+void LowPassGateVoices::setLowpass(int c, float bias, float amount) {
+	assert(c >= 0 && c < maxChannels);
+	Group& g = _groups[c / laneWidth];
+	lanes::set(g.lowpassBias, c % laneWidth, bias);
+	lanes::set(g.lowpassAmount, c % laneWidth, amount);
+}
+
+void LowPassGateVoices::setHighpass(int c, float bias, float amount) {
+	assert(c >= 0 && c < maxChannels);
+	Group& g = _groups[c / laneWidth];
+	lanes::set(g.highpassBias, c % laneWidth, bias);
+	lanes::set(g.highpassAmount, c % laneWidth, amount);
+}
+
+void LowPassGateVoices::setLevel(int c, float bias, float amount) {
+	assert(c >= 0 && c < maxChannels);
+	Group& g = _groups[c / laneWidth];
+	lanes::set(g.levelBias, c % laneWidth, bias);
+	lanes::set(g.levelAmount, c % laneWidth, amount);
+}
+
+void LowPassGateVoices::reset(int c) {
+	assert(c >= 0 && c < maxChannels);
+	Group& g = _groups[c / laneWidth];
+	int l = c % laneWidth;
+	lanes::set(g.level, l, 0.0f);
+	g.lowpass.reset(l);
+	g.highpass.reset(l);
+	g.finalHighpass.reset(l);
+}
+
+lanes_t LowPassGateVoices::next(int gi, const lanes_t& sample, const lanes_t& envelope) {
+	Group& g = _groups[gi];
+
+	if (g.step == 0) {
+		if (_lowpassPoles > 0) {
+			lanes_t f = lanes::fmin(lanes::fmax(g.lowpassBias + envelope * g.lowpassAmount, 0.0f), 1.0f);
+			g.lowpass.setFrequency(maxCutoff * f);
+		}
+		if (_highpassPoles > 0) {
+			lanes_t f = lanes::fmin(lanes::fmax(g.highpassBias + envelope * g.highpassAmount, 0.0f), 1.0f);
+			g.highpass.setFrequency(maxCutoff * f);
+		}
+	}
+	if (++g.step >= cutoffSteps) {
+		g.step = 0;
+	}
+
+	lanes_t level = lanes::fmin(lanes::fmax(g.levelBias + envelope * g.levelAmount, 0.0f), 1.0f);
+	if (_slewLevel) {
+		level = g.level + lanes::fmin(lanes::fmax(level - g.level, -_levelDelta), _levelDelta);
+	}
+	g.level = level;
+
+	lanes_t out = sample;
+	if (_lowpassPoles > 0 && _highpassPoles > 0) {
+		if (_serial) {
+			out = g.highpass.next(g.lowpass.next(out));
+		}
+		else {
+			out = g.lowpass.next(out) + g.highpass.next(out);
+		}
+	}
+	else if (_lowpassPoles > 0) {
+		out = g.lowpass.next(out);
+	}
+	else {
+		out = g.highpass.next(out);
+	}
+	out = g.finalHighpass.next(out);
+
+	if (_linear) {
+		return out * level;
+	}
+	return out * Amplifier::levels(Amplifier::minDecibels * (1.0f - level));
+}
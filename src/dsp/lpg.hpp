@@ -0,0 +1,69 @@
+#pragma once
+
+#include "filters/multimode.hpp"
+#include "signal.hpp"
+
+namespace bogaudio {
+namespace dsp {
+
+// The signal path of a low-pass gate (as LPG, LLPG and MegaGate) for up to
+// maxChannels voices, laneWidth voices at a time.  A voice's envelope (0-1,
+// already shaped) moves the cutoffs of a Butterworth lowpass and/or highpass
+// and the level of a VCA, each from a per-voice bias by a per-voice amount;
+// the filters are followed by a fixed 80Hz highpass, as in the modules.  A
+// group's cutoffs follow its envelope every cutoffSteps samples, designed for
+// all of its lanes together (see ButterworthLanes); its level follows every
+// sample, through a 5ms slew unless that's turned off.  Filter pole counts,
+// serial or parallel filters, and a linear or decibel VCA are shared.
+struct LowPassGateVoices {
+	static constexpr int maxChannels = 16;
+	static constexpr int maxGroups = maxChannels / laneWidth;
+	static constexpr int cutoffSteps = 8;
+	static constexpr float maxCutoff = 20000.0f;
+	static constexpr float levelSlewMS = 5.0f;
+	static constexpr float finalHighpassCutoff = 80.0f;
+
+	struct Group {
+		int step = 0;
+		lanes_t lowpassBias = 0.0f;
+		lanes_t lowpassAmount = 0.0f;
+		lanes_t highpassBias = 0.0f;
+		lanes_t highpassAmount = 0.0f;
+		lanes_t levelBias = 0.0f;
+		lanes_t levelAmount = 0.0f;
+		lanes_t level = 0.0f;
+		ButterworthLanes lowpass;
+		ButterworthLanes highpass;
+		ButterworthLanes finalHighpass;
+	};
+
+	float _sampleRate = 0.0f;
+	float _levelDelta = 1.0f;
+	int _lowpassPoles = 2;
+	int _highpassPoles = 0;
+	bool _serial = true;
+	bool _linear = false;
+	bool _slewLevel = true;
+	Group _groups[maxGroups];
+
+	LowPassGateVoices(float sampleRate = 1000.0f) {
+		setSampleRate(sampleRate);
+	}
+
+	void setSampleRate(float sampleRate);
+	// 0 poles leaves a filter out; with both, serial runs the lowpass into the
+	// highpass, and otherwise their outputs are summed.
+	void setFilters(int lowpassPoles, int highpassPoles = 0, bool serial = true);
+	void setVCA(bool linear, bool slewLevel = true);
+	// the lowpass's cutoff is maxCutoff * clamp(bias + envelope * amount, 0, 1),
+	// and likewise the highpass's and the VCA's level (without maxCutoff).
+	void setLowpass(int c, float bias, float amount);
+	void setHighpass(int c, float bias, float amount);
+	void setLevel(int c, float bias, float amount);
+	void reset(int c);
+
+	lanes_t next(int g, const lanes_t& sample, const lanes_t& envelope);
+};
+
+} // namespace dsp
+} // namespace bogaudio
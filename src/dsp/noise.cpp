@@ -31,6 +31,10 @@ unsigned int Seeds::next() {
   return getInstance()._next();
 };
 
+void Seeds::seed(unsigned int seed) {
+  getInstance()._generator.seed(seed);
+}
+
 
 void RandomWalk::setParams(float sampleRate, float change) {
 	assert(sampleRate > 0.0f);
@@ -67,3 +71,41 @@ float RandomWalk::_next() {
 	_bias *= _biasDamp;
 	return _lastOut = std::min(std::max(_bias + _filter.next(_last), _min), _max);
 }
+
+
+void RandomWalkLanes::setParams(int lane, float sampleRate, float change, int stride) {
+	assert(lane >= 0 && lane < laneWidth);
+	assert(sampleRate > 0.0f);
+	assert(change >= 0.0f);
+	assert(change <= 1.0f);
+	assert(stride >= 1);
+
+	float rate = sampleRate / (float)stride;
+	float cutoff = change * 0.49f * std::min(44100.0f, sampleRate);
+	_filter.setParams(lane, rate, std::max(2.0f, std::min(cutoff, 0.49f * rate)));
+
+	// as RandomWalk, per sample; over a stride, the damping compounds, and the
+	// steps' variance sums, damped.
+	const float maxDamp = 0.98;
+	const float minDamp = 0.9999;
+	float damp = maxDamp + (1.0f - change)*(minDamp - maxDamp);
+	float strideDamp = powf(damp, stride);
+	lanes::set(_damp, lane, strideDamp);
+	lanes::set(_stepScale, lane, sqrtf((1.0f - strideDamp * strideDamp) / (1.0f - damp * damp)));
+
+	lanes::set(_biasDamp, lane, 1.0f - change*(2.0f / rate));
+}
+
+float RandomWalkLanes::jump(int lane) {
+	float x = fabsf(_noise.next(lane)) * (_max - _min);
+	x += _min;
+	tell(lane, x);
+	return x;
+}
+
+void RandomWalkLanes::tell(int lane, float v) {
+	assert(v >= _min && v <= _max);
+	lanes::set(_last, lane, v);
+	lanes::set(_bias, lane, v);
+	_filter.reset(lane);
+}
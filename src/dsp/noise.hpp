@@ -20,6 +20,9 @@ public:
 	static Seeds& getInstance();
 
 	static unsigned int next();
+	// reseeds the sequence, so generators constructed afterwards (in the same
+	// order) produce the same output; for offline rendering and tests.
+	static void seed(unsigned int seed);
 };
 
 struct NoiseGenerator : Generator {
@@ -116,5 +119,76 @@ struct RandomWalk : Generator {
 	float _next() override;
 };
 
+// White noise, uniform on [-1, 1], for laneWidth channels at once: a linear
+// congruential generator per lane (with Numerical Recipes' constants), read
+// from its high bits.  Much cheaper than WhiteNoiseGenerator, and plenty
+// for modulation.
+struct WhiteNoiseLanes {
+	ilanes_t _state = 0;
+
+	WhiteNoiseLanes() {
+		for (int l = 0; l < laneWidth; ++l) {
+			lanes::set(_state, l, (int32_t)Seeds::next());
+		}
+	}
+
+	inline lanes_t next() {
+		_state = lanes::wrappingAdd(lanes::wrappingMul(_state, ilanes_t(1664525)), ilanes_t(1013904223));
+		return lanes_t(_state) * (1.0f / 2147483648.0f);
+	}
+
+	// advances just the given lane.
+	inline float next(int lane) {
+		uint32_t x = (uint32_t)lanes::get(_state, lane) * 1664525u + 1013904223u;
+		lanes::set(_state, lane, (int32_t)x);
+		return (float)(int32_t)x * (1.0f / 2147483648.0f);
+	}
+};
+
+// RandomWalk for laneWidth channels at once, with per-lane parameters and a
+// shared range.  The walk may be stepped once every stride samples (at
+// control rate, say, with the caller interpolating), its damping and step
+// size scaled to wander about as it would stepping every sample.
+struct RandomWalkLanes {
+	float _min;
+	float _max;
+	lanes_t _last = 0.0f;
+	lanes_t _lastOut = 0.0f;
+	lanes_t _damp = 0.0f;
+	lanes_t _stepScale = 1.0f;
+	lanes_t _bias = 0.0f;
+	lanes_t _biasDamp = 1.0f;
+	WhiteNoiseLanes _noise;
+	LowPassFilterLanes _filter;
+
+	RandomWalkLanes(
+		float min = -5.0f,
+		float max = 5.0f,
+		float sampleRate = 1000.0f,
+		float change = 0.5f
+	)
+	: _min(min)
+	, _max(max)
+	{
+		assert(_min < _max);
+		for (int l = 0; l < laneWidth; ++l) {
+			setParams(l, sampleRate, change);
+		}
+	}
+
+	void setParams(int lane, float sampleRate = 1000.0f, float change = 0.5f, int stride = 1);
+	float jump(int lane);
+	void tell(int lane, float v);
+
+	inline lanes_t next() {
+		lanes_t delta = _stepScale * _noise.next();
+		lanes_t reflect = ((_lastOut >= _max) & (delta > 0.0f)) | ((_lastOut <= _min) & (delta < 0.0f));
+		delta = lanes::ifelse(reflect, -delta, delta);
+		_last = _damp * _last + delta;
+		_bias *= _biasDamp;
+		return _lastOut = lanes::fmin(lanes::fmax(_bias + _filter.next(_last), _min), _max);
+	}
+};
+
 } // namespace dsp
 } // namespace bogaudio
@@ -1,4 +1,6 @@
 
+#include "ffft/FFTReal.h"
+
 #include "oscillator.hpp"
 #include "noise.hpp"
 
@@ -60,19 +62,16 @@ float Phasor::nextForPhase(phase_t phase) {
 
 
 float TablePhasor::nextForPhase(phase_t phase) {
-	phase %= cyclePhase;
-	if (_tableLength >= 1024) {
-		int i = (((((uint64_t)phase) << 16) / cyclePhase) * _tableLength) >> 16;
-		i %= _tableLength;
-		return _table.value(i);
+	if (!_interpolate) {
+		return _table.value(cyclePosition(phase) >> _tableShift);
 	}
 
-	float fi = phase / (float)cyclePhase;
+	float fi = cycleFraction(phase);
 	assert(fi >= 0.0f && fi < 1.0f);
 	fi *= _tableLength;
 	int i = fi;
 	float v1 = _table.value(i);
-	float v2 = _table.value(i + 1 == _tableLength ? 0 : i + 1);
+	float v2 = _table.value((i + 1) & (_tableLength - 1));
 	return v1 + (fi - i)*(v2 - v1);
 }
 
@@ -98,7 +97,7 @@ float SineOscillator::_next() {
 
 
 float SawOscillator::nextForPhase(phase_t phase) {
-	return ((phase % cyclePhase) / (float)cyclePhase) * 2.0f - 1.0f;
+	return cycleFraction(phase) * 2.0f - 1.0f;
 }
 
 
@@ -138,19 +137,20 @@ void BandLimitedSawOscillator::_update() {
 	Phasor::_update();
 	int q = std::min(_quality, (int)(0.5f * (_sampleRate / _frequency)));
 	_qd = q * _delta;
+	_invQd = _qd > 0 ? 1.0f / (float)_qd : 0.0f;
 }
 
 float BandLimitedSawOscillator::nextForPhase(phase_t phase) {
-	phase %= cyclePhase;
+	phase = cyclePosition(phase);
 
 	float sample = SaturatingSawOscillator::nextForPhase(phase);
 	if (phase > cyclePhase - _qd) {
-		float i = (cyclePhase - phase) / (float)_qd;
+		float i = (cyclePhase - phase) * _invQd;
 		i = (1.0f - i) * _halfTableLen;
 		sample -= _table.value((int)i);
 	}
 	else if (phase < _qd) {
-		float i = phase / (float)_qd;
+		float i = phase * _invQd;
 		i *= _halfTableLen - 1;
 		i += _halfTableLen;
 		sample -= _table.value((int)i);
@@ -159,6 +159,9 @@ float BandLimitedSawOscillator::nextForPhase(phase_t phase) {
 }
 
 
+constexpr float SquareOscillator::minPulseWidth;
+constexpr float SquareOscillator::maxPulseWidth;
+
 void SquareOscillator::setPulseWidth(float pw) {
 	if (_pulseWidthInput == pw) {
 		return;
@@ -175,12 +178,12 @@ void SquareOscillator::setPulseWidth(float pw) {
 }
 
 float SquareOscillator::nextForPhase(phase_t phase) {
-	phase_t cycle = phase / cyclePhase;
+	phase_t cycle = cycleIndex(phase);
 	if (_lastCycle != cycle) {
 		_lastCycle = cycle;
 		_pulseWidth = _nextPulseWidth;
 	}
-	phase %= cyclePhase;
+	phase = cyclePosition(phase);
 
 	if (positive) {
 		if (phase >= _pulseWidth) {
@@ -223,7 +226,7 @@ void BandLimitedSquareOscillator::setPulseWidth(float pw, bool dcCorrection) {
 }
 
 float BandLimitedSquareOscillator::nextForPhase(phase_t phase) {
-	phase_t cycle = phase / cyclePhase;
+	phase_t cycle = cycleIndex(phase);
 	if (_lastCycle != cycle) {
 		_lastCycle = cycle;
 		_pulseWidth = _nextPulseWidth;
@@ -238,9 +241,9 @@ float BandLimitedSquareOscillator::nextForPhase(phase_t phase) {
 
 
 float TriangleOscillator::nextForPhase(phase_t phase) {
-	phase %= cyclePhase;
+	phase = cyclePosition(phase);
 
-	float p = (phase / (float)cyclePhase) * 4.0f;
+	float p = cycleFraction(phase) * 4.0f;
 	if (phase < quarterCyclePhase) {
 		return p;
 	}
@@ -279,13 +282,229 @@ SteppedRandomOscillator::~SteppedRandomOscillator() {
 }
 
 void SteppedRandomOscillator::resetPhase() {
-	_phase -= _phase % cyclePhase;
+	_phase -= cyclePosition(_phase);
 	_phase += cyclePhase;
 }
 
 float SteppedRandomOscillator::nextForPhase(phase_t phase) {
-	phase_t i = phase / cyclePhase;
-	return _t[(_seed + i + (_seed + i) % _k) % _n];
+	phase_t i = cycleIndex(phase);
+	if (i != _cycle) {
+		_cycle = i;
+		_cycleValue = valueForCycle(i);
+	}
+	return _cycleValue;
+}
+
+
+constexpr int PhaseTaps::maxTaps;
+
+PhaseTaps::PhaseTaps(int taps)
+: _taps(taps)
+, _groups(laneGroups(taps))
+, _sine(StaticSineTable::table())
+, _sineShift(Phasor::cycleBits)
+{
+	assert(_taps >= 1 && _taps <= maxTaps);
+	for (int n = _sine.length(); n > 1; n >>= 1) {
+		--_sineShift;
+	}
+	for (int t = 0; t < maxTaps; ++t) {
+		setOffset(t, 0);
+	}
+}
+
+void PhaseTaps::setOffset(int tap, Phasor::phase_delta_t offset) {
+	assert(tap >= 0 && tap < maxTaps);
+	_offsets[tap] = offset;
+	lanes::set(_positions[tap / laneWidth], tap % laneWidth, (int32_t)(Phasor::cyclePosition(offset) ^ 0x80000000));
+}
+
+void PhaseTaps::setPulseWidth(float pw) {
+	if (_pulseWidthInput != pw) {
+		_pulseWidthInput = pw;
+		_nextPulseWidth = std::max(SquareOscillator::minPulseWidth, std::min(SquareOscillator::maxPulseWidth, pw));
+	}
+}
+
+bool PhaseTaps::crosses(int tap, Phasor::phase_t from, Phasor::phase_t to, int bits) {
+	return ((from + _offsets[tap]) >> bits) != ((to + _offsets[tap]) >> bits);
+}
+
+void PhaseTaps::next(Wave wave, Phasor::phase_t phase, float* out) {
+	if (wave == STEPPED_WAVE) {
+		for (int t = 0; t < _taps; ++t) {
+			out[t] = _stepped.valueForCycle(Phasor::cycleIndex(phase + _offsets[t]));
+		}
+		return;
+	}
+
+	Phasor::phase_t cycle = Phasor::cycleIndex(phase);
+	if (_lastCycle != cycle) {
+		_lastCycle = cycle;
+		_pulseWidth = _nextPulseWidth;
+	}
+
+	ilanes_t base = (int32_t)Phasor::cyclePosition(phase);
+	for (int g = 0; g < _groups; ++g) {
+		ilanes_t flipped = lanes::wrappingAdd(base, _positions[g]);
+		lanes_t v;
+		if (wave == SINE_WAVE) {
+			for (int l = 0; l < laneWidth; ++l) {
+				uint32_t position = (uint32_t)lanes::get(flipped, l) ^ 0x80000000;
+				lanes::set(v, l, _sine.value(position >> _sineShift));
+			}
+		}
+		else {
+			lanes_t fraction = lanes_t(flipped) * (1.0f / (float)Phasor::cyclePhase) + 0.5f;
+			switch (wave) {
+				case TRIANGLE_WAVE: {
+					lanes_t p = fraction * 4.0f;
+					v = lanes::ifelse(fraction < 0.25f, p, lanes::ifelse(fraction < 0.75f, 2.0f - p, p - 4.0f));
+					break;
+				}
+				case RAMP_UP_WAVE: {
+					v = fraction * 2.0f - 1.0f;
+					break;
+				}
+				case RAMP_DOWN_WAVE: {
+					v = 1.0f - fraction * 2.0f;
+					break;
+				}
+				default: {
+					v = lanes::ifelse(fraction < _pulseWidth, lanes_t(1.0f), lanes_t(-1.0f));
+				}
+			}
+		}
+		lanes::store(out + g * laneWidth, v);
+	}
+}
+
+
+constexpr int Wavetable::guardSamples;
+
+void Wavetable::generate() {
+	if (_tables) {
+		return;
+	}
+	_tables = new float[_levels * _stride] {};
+
+	ffft::FFTReal<float> fft(_length);
+	float* spectrum = new float[_length];
+	for (int level = 0; level < _levels; ++level) {
+		std::fill_n(spectrum, _length, 0.0f);
+		for (int h = 1, n = std::min(maxHarmonic(level), _length / 2 - 1); h <= n; ++h) {
+			spectrum[_length / 2 + h] = 0.5f * _harmonic(h);
+		}
+		float* t = _tables + level * _stride;
+		fft.do_ifft(spectrum, t + 1);
+		t[0] = t[_length];
+		t[_length + 1] = t[1];
+		t[_length + 2] = t[2];
+	}
+	delete[] spectrum;
+}
+
+int Wavetable::level(float frequency, float sampleRate) const {
+	// the lowest level whose top harmonic is under Nyquist: (length / 2) >> level harmonics at ratio f/sr.
+	float harmonics = 0.5f * sampleRate / std::max(fabsf(frequency), 0.001f);
+	int level = 0;
+	while (level < _levels - 1 && maxHarmonic(level) > harmonics) {
+		++level;
+	}
+	return level;
+}
+
+float Wavetable::value(int level, float fraction, Interpolation interpolation) const {
+	// cycleFraction() can round up to exactly 1.0 at the very end of a cycle;
+	// masking wraps that index back to the start of the table.
+	float fi = fraction * _length;
+	int i = fi;
+	float t = fi - i;
+	const float* p = table(level) + (i & (_length - 1));
+	if (interpolation == LINEAR_INTERPOLATION) {
+		return p[0] + t * (p[1] - p[0]);
+	}
+
+	// 4-point, 3rd-order Hermite.
+	float c1 = 0.5f * (p[1] - p[-1]);
+	float c2 = p[-1] - 2.5f * p[0] + 2.0f * p[1] - 0.5f * p[2];
+	float c3 = 0.5f * (p[2] - p[-1]) + 1.5f * (p[0] - p[1]);
+	return ((c3 * t + c2) * t + c1) * t + p[0];
+}
+
+lanes_t Wavetable::value(const int* levels, const lanes_t& fractions, Interpolation interpolation) const {
+	lanes_t fi = fractions * (float)_length;
+	lanes_t t, ym1, y0, y1, y2;
+	for (int l = 0; l < laneWidth; ++l) {
+		float f = lanes::get(fi, l);
+		int i = f;
+		const float* p = table(levels[l]) + (i & (_length - 1));
+		lanes::set(t, l, f - i);
+		lanes::set(ym1, l, p[-1]);
+		lanes::set(y0, l, p[0]);
+		lanes::set(y1, l, p[1]);
+		lanes::set(y2, l, p[2]);
+	}
+	if (interpolation == LINEAR_INTERPOLATION) {
+		return y0 + t * (y1 - y0);
+	}
+
+	lanes_t c1 = 0.5f * (y1 - ym1);
+	lanes_t c2 = ym1 - 2.5f * y0 + 2.0f * y1 - 0.5f * y2;
+	lanes_t c3 = 0.5f * (y2 - ym1) + 1.5f * (y0 - y1);
+	return ((c3 * t + c2) * t + c1) * t + y0;
+}
+
+
+// harmonic series match the phase alignment of SawOscillator, SquareOscillator and TriangleOscillator.
+float SawWavetable::_harmonic(int h) {
+	return -2.0f / (M_PI * h);
+}
+
+float SquareWavetable::_harmonic(int h) {
+	return h % 2 ? 4.0f / (M_PI * h) : 0.0f;
+}
+
+float TriangleWavetable::_harmonic(int h) {
+	if (h % 2) {
+		return ((h / 2) % 2 ? -8.0f : 8.0f) / (M_PI * M_PI * h * h);
+	}
+	return 0.0f;
+}
+
+
+void WavetableOscillator::_update() {
+	Phasor::_update();
+	_level = _wavetable.level(_frequency, _sampleRate);
+}
+
+float WavetableOscillator::nextForPhase(phase_t phase) {
+	return _wavetable.value(_level, cycleFraction(phase), _interpolation);
+}
+
+
+void WavetableVoices::setSampleRate(float sampleRate) {
+	assert(sampleRate > 0.0f);
+	_sampleRate = sampleRate;
+	for (int l = 0; l < laneWidth; ++l) {
+		setFrequency(l, _frequency[l]);
+	}
+}
+
+void WavetableVoices::setFrequency(int lane, float frequency) {
+	assert(lane >= 0 && lane < laneWidth);
+	_frequency[lane] = frequency;
+	_delta[lane] = (Phasor::phase_delta_t)((frequency / _sampleRate) * Phasor::cyclePhase);
+	_level[lane] = _wavetable.level(frequency, _sampleRate);
+}
+
+lanes_t WavetableVoices::next() {
+	lanes_t fractions;
+	for (int l = 0; l < laneWidth; ++l) {
+		_phase[l] += _delta[l];
+		lanes::set(fractions, l, Phasor::cycleFraction(_phase[l]));
+	}
+	return _wavetable.value(_level, fractions, _interpolation);
 }
 
 
@@ -3,9 +3,12 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <math.h>
+#include <algorithm>
+#include <mutex>
 #include <vector>
 
 #include "base.hpp"
+#include "lanes.hpp"
 #include "math.hpp"
 #include "table.hpp"
 
@@ -55,10 +58,17 @@ struct OscillatorGenerator : Oscillator, Generator {
 	}
 };
 
+// Phase is fixed-point with a power-of-two cycle: the low cycleBits bits are
+// position within the cycle, and wrap by plain integer overflow, so reducing
+// a phase to its cycle position is a truncation rather than a modulo.  The
+// high bits count cycles, for waveforms that change per cycle (stepped
+// random, square pulse width latching).
 struct Phasor : OscillatorGenerator {
 	typedef uint64_t phase_t;
 	typedef int64_t phase_delta_t;
-	static constexpr phase_t cyclePhase = UINT32_MAX;
+	typedef uint32_t cycle_phase_t;
+	static constexpr int cycleBits = 32;
+	static constexpr phase_t cyclePhase = (phase_t)1 << cycleBits;
 	static constexpr float twoPI = 2.0f * M_PI;
 	static constexpr float maxSampleWidth = 0.25f;
 
@@ -98,12 +108,17 @@ struct Phasor : OscillatorGenerator {
 	float _next() override final;
 
 	inline static phase_delta_t radiansToPhase(float radians) { return (radians / twoPI) * cyclePhase; }
-	inline static float phaseToRadians(phase_t phase) { return (phase / (float)cyclePhase) * twoPI; }
+	inline static float phaseToRadians(phase_t phase) { return phase * (twoPI / (float)cyclePhase); }
+	inline static cycle_phase_t cyclePosition(phase_t phase) { return (cycle_phase_t)phase; }
+	inline static float cycleFraction(phase_t phase) { return cyclePosition(phase) * (1.0f / (float)cyclePhase); }
+	inline static phase_t cycleIndex(phase_t phase) { return phase >> cycleBits; }
 };
 
 struct TablePhasor : Phasor {
 	const Table& _table;
 	int _tableLength;
+	int _tableShift;
+	bool _interpolate;
 
 	TablePhasor(
 		const Table& table,
@@ -113,9 +128,15 @@ struct TablePhasor : Phasor {
 	: Phasor(sampleRate, frequency)
 	, _table(table)
 	, _tableLength(table.length())
+	, _tableShift(cycleBits)
+	, _interpolate(_tableLength < 1024)
 	{
+		for (int n = _tableLength; n > 1; n >>= 1) {
+			--_tableShift;
+		}
 	}
 
+	inline void setInterpolate(bool interpolate) { _interpolate = interpolate; } // defaults off (nearest sample) for tables of 1024 or more.
 	float nextForPhase(phase_t phase) override;
 };
 
@@ -193,6 +214,7 @@ struct BandLimitedSawOscillator : SaturatingSawOscillator {
 	int _quality;
 	const Table& _table;
 	phase_t _qd = 0;
+	float _invQd = 0.0f;
 	float _halfTableLen;
 
 	BandLimitedSawOscillator(
@@ -280,6 +302,8 @@ struct SteppedRandomOscillator : Phasor {
 	const phase_t _k;
 	float* _t = NULL;
 	phase_t _seed;
+	phase_t _cycle = -1;
+	float _cycleValue = 0.0f;
 
 	SteppedRandomOscillator(
 		float sampleRate = 1000.0f,
@@ -290,8 +314,210 @@ struct SteppedRandomOscillator : Phasor {
 
 	void resetPhase() override;
 	float nextForPhase(phase_t phase) override;
+	inline float valueForCycle(phase_t cycle) const { return _t[(_seed + cycle + (_seed + cycle) % _k) % _n]; }
+};
+
+// The simple waves of SineTableOscillator, TriangleOscillator, SawOscillator,
+// SquareOscillator and SteppedRandomOscillator, evaluated at up to maxTaps
+// fixed offsets (taps) from one phase, laneWidth taps at a time: the same
+// values as nextFromPhasor with each tap's offset, without a virtual call and
+// a 64-bit cycle reduction per tap.  Tap cycle positions are 32-bit lanes,
+// kept sign-flipped so a signed conversion to float can give the fraction.
+// The square's pulse width latches at cycle boundaries of the phase given,
+// rather than of each tap; the sine is nearest-sample, as TablePhasor is for
+// a table of its size.
+struct PhaseTaps {
+	enum Wave {
+		SINE_WAVE,
+		TRIANGLE_WAVE,
+		RAMP_UP_WAVE,
+		RAMP_DOWN_WAVE,
+		SQUARE_WAVE,
+		STEPPED_WAVE
+	};
+
+	static constexpr int maxTaps = 8;
+	static constexpr int maxGroups = maxTaps / laneWidth;
+
+	int _taps;
+	int _groups;
+	Phasor::phase_delta_t _offsets[maxTaps] {};
+	ilanes_t _positions[maxGroups];
+	const Table& _sine;
+	int _sineShift;
+	float _pulseWidthInput = -1.0f;
+	float _pulseWidth = SquareOscillator::defaultPulseWidth;
+	float _nextPulseWidth = SquareOscillator::defaultPulseWidth;
+	Phasor::phase_t _lastCycle = -1;
+	SteppedRandomOscillator _stepped;
+
+	PhaseTaps(int taps = maxTaps);
+
+	void setOffset(int tap, Phasor::phase_delta_t offset);
+	void setPulseWidth(float pw);
+	bool crosses(int tap, Phasor::phase_t from, Phasor::phase_t to, int bits); // passes a multiple of 2^bits?
+	void next(Wave wave, Phasor::phase_t phase, float* out); // out has room for maxTaps.
+};
+
+// Mip-mapped band-limited wavetable: one table per octave, each holding only
+// the harmonics that stay under Nyquist for the fundamentals it's used for.
+// The tables are built once, by inverse FFT of the waveform's harmonic
+// series, and are read-only afterwards, so one instance (see
+// StaticWavetable) is shared by every oscillator using the waveform.  Each
+// level is stored with one wrapped sample before and two after, so cubic
+// interpolation never needs to wrap an index.
+struct Wavetable {
+	enum Interpolation {
+		LINEAR_INTERPOLATION,
+		CUBIC_INTERPOLATION
+	};
+
+	static constexpr int guardSamples = 3;
+
+	int _length;
+	int _levels;
+	int _stride;
+	float* _tables = NULL;
+
+	Wavetable(int n = 11) {
+		assert(n >= 4);
+		assert(n <= 16);
+		_length = 1 << n;
+		_levels = n;
+		_stride = _length + guardSamples;
+	}
+	virtual ~Wavetable() {
+		if (_tables) {
+			delete[] _tables;
+		}
+	}
+
+	inline int length() const { return _length; }
+	inline int levels() const { return _levels; }
+	inline int maxHarmonic(int level) const { return std::max(1, (_length / 2) >> level); }
+	inline const float* table(int level) const {
+		assert(level >= 0 && level < _levels);
+		assert(_tables);
+		return _tables + level * _stride + 1;
+	}
+
+	int level(float frequency, float sampleRate) const;
+	float value(int level, float fraction, Interpolation interpolation) const;
+	lanes_t value(const int* levels, const lanes_t& fractions, Interpolation interpolation) const;
+	void generate();
+
+protected:
+	virtual float _harmonic(int h) = 0; // amplitude of sine harmonic h (1-based).
+};
+
+template<class T> class StaticWavetable {
+private:
+	Wavetable* _wavetable = NULL;
+	std::mutex _lock;
+
+	StaticWavetable() {
+	}
+	~StaticWavetable() {
+		if (_wavetable) {
+			delete _wavetable;
+		}
+	}
+
+public:
+	StaticWavetable(const StaticWavetable&) = delete;
+	void operator=(const StaticWavetable&) = delete;
+
+	static const Wavetable& wavetable() {
+		static StaticWavetable<T> instance;
+		std::lock_guard<std::mutex> lock(instance._lock);
+		if (!instance._wavetable) {
+			instance._wavetable = new T();
+			instance._wavetable->generate();
+		}
+		return *instance._wavetable;
+	}
+};
+
+struct SawWavetable : Wavetable {
+	float _harmonic(int h) override;
+};
+struct StaticSawWavetable : StaticWavetable<SawWavetable> {};
+
+struct SquareWavetable : Wavetable {
+	float _harmonic(int h) override;
+};
+struct StaticSquareWavetable : StaticWavetable<SquareWavetable> {};
+
+struct TriangleWavetable : Wavetable {
+	float _harmonic(int h) override;
+};
+struct StaticTriangleWavetable : StaticWavetable<TriangleWavetable> {};
+
+struct WavetableOscillator : Phasor {
+	const Wavetable& _wavetable;
+	Wavetable::Interpolation _interpolation;
+	int _level = 0;
+
+	WavetableOscillator(
+		const Wavetable& wavetable = StaticSawWavetable::wavetable(),
+		float sampleRate = 1000.0f,
+		float frequency = 100.0f,
+		Wavetable::Interpolation interpolation = Wavetable::CUBIC_INTERPOLATION
+	)
+	: Phasor(sampleRate, frequency)
+	, _wavetable(wavetable)
+	, _interpolation(interpolation)
+	{
+		_update();
+	}
+
+	inline void setInterpolation(Wavetable::Interpolation interpolation) { _interpolation = interpolation; }
+	void _update() override;
+	float nextForPhase(phase_t phase) override;
 };
 
+// laneWidth independent voices of one wavetable, advanced together; the
+// per-voice phase and table level are scalar, the interpolation is done
+// across lanes.
+struct WavetableVoices {
+	const Wavetable& _wavetable;
+	Wavetable::Interpolation _interpolation;
+	float _sampleRate = 1000.0f;
+	Phasor::cycle_phase_t _phase[laneWidth] {};
+	Phasor::cycle_phase_t _delta[laneWidth] {};
+	float _frequency[laneWidth] {};
+	int _level[laneWidth] {};
+
+	WavetableVoices(
+		const Wavetable& wavetable = StaticSawWavetable::wavetable(),
+		float sampleRate = 1000.0f,
+		Wavetable::Interpolation interpolation = Wavetable::CUBIC_INTERPOLATION
+	)
+	: _wavetable(wavetable)
+	, _interpolation(interpolation)
+	{
+		setSampleRate(sampleRate);
+	}
+
+	void setSampleRate(float sampleRate);
+	void setFrequency(int lane, float frequency);
+	inline void resetPhase(int lane) { _phase[lane] = 0; }
+	lanes_t next();
+};
+
+// sin(2 * pi * x) with x in cycles (any value; it's reduced to the nearest
+// cycle first), as a polynomial, for lanes where a table gather would be
+// scalar.  The input is folded onto a quarter cycle either side of zero, where
+// the series to the ninth power is accurate to a few parts per million.
+inline lanes_t sineLanes(const lanes_t& cycles) {
+	lanes_t x = cycles - lanes::floor(cycles + 0.5f);
+	x = lanes::ifelse(x > 0.25f, 0.5f - x, x);
+	x = lanes::ifelse(x < -0.25f, -0.5f - x, x);
+	x = x * Phasor::twoPI;
+	lanes_t x2 = x * x;
+	return x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f + x2 * (1.0f / 362880.0f)))));
+}
+
 struct SineBankOscillator : Oscillator {
 	struct Partial {
 		float frequency;
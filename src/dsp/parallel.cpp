@@ -0,0 +1,106 @@
+#if defined(__x86_64__) || defined(__i386__)
+#include <xmmintrin.h>
+#define PAUSE() _mm_pause()
+#else
+#define PAUSE()
+#endif
+
+#include <assert.h>
+
+#include "parallel.hpp"
+
+using namespace bogaudio::dsp;
+
+constexpr int ChannelWorkers::spinPeriods;
+
+ChannelWorkers::ChannelWorkers(int threads) {
+	for (int i = 0; i < threads; ++i) {
+		_threads.push_back(std::thread(&ChannelWorkers::workerLoop, this));
+	}
+}
+
+ChannelWorkers::~ChannelWorkers() {
+	_stop = true;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_wake.notify_all();
+	}
+	for (std::thread& t : _threads) {
+		t.join();
+	}
+}
+
+bool ChannelWorkers::run(Work work, void* context, int n, float sampleTime) {
+	assert(n < (1 << 16));
+	if (_threads.empty() || n < 2 || _busy.exchange(true, std::memory_order_acquire)) {
+		return false;
+	}
+
+	Clock::duration spin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(spinPeriods * sampleTime));
+	_spinUntil.store((Clock::now() + spin).time_since_epoch().count(), std::memory_order_relaxed);
+	_work.store(work, std::memory_order_release);
+	_context.store(context, std::memory_order_release);
+	uint64_t generation = ((_claims.load(std::memory_order_relaxed) >> 32) + 1) & 0xffffffff;
+	_done.store(generation << 32, std::memory_order_relaxed);
+	_claims.store(generation << 32 | (uint64_t)n << 16, std::memory_order_release);
+	if (_sleepers.load() > 0) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_wake.notify_all();
+	}
+
+	claimAndWork(generation);
+	uint64_t done = generation << 32 | (uint64_t)n;
+	while (_done.load(std::memory_order_acquire) != done) {
+		PAUSE();
+	}
+	_busy.store(false, std::memory_order_release);
+	return true;
+}
+
+// A claim is a CAS on the whole word, so it fails if another job has been
+// published since the word was read; a successful one holds the job's
+// channel, and run() doesn't return, or publish another job, until it's done.
+void ChannelWorkers::claimAndWork(uint64_t generation) {
+	uint64_t claims = _claims.load(std::memory_order_acquire);
+	while ((claims >> 32) == generation && (claims & 0xffff) < ((claims >> 16) & 0xffff)) {
+		if (_claims.compare_exchange_weak(claims, claims + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			Work work = _work.load(std::memory_order_acquire);
+			work(_context.load(std::memory_order_acquire), (int)(claims & 0xffff));
+			_done.fetch_add(1, std::memory_order_release);
+			claims = _claims.load(std::memory_order_acquire);
+		}
+	}
+}
+
+void ChannelWorkers::workerLoop() {
+#if defined(__x86_64__) || defined(__i386__)
+	_mm_setcsr(_mm_getcsr() | 0x8040); // flush denormals to zero, as Rack's engine threads do.
+#endif
+
+	uint64_t seen = 0;
+	int idle = 0;
+	while (!_stop) {
+		uint64_t generation = _claims.load(std::memory_order_acquire) >> 32;
+		if (generation != seen) {
+			seen = generation;
+			claimAndWork(generation);
+			idle = 0;
+		}
+		else if (++idle % 16 != 0 || Clock::now().time_since_epoch().count() < _spinUntil.load(std::memory_order_relaxed)) { // check the clock every few spins.
+			PAUSE();
+		}
+		else {
+			// pairs with run()'s store to _claims and load of _sleepers: at
+			// least one of us sees the other.
+			_sleepers.fetch_add(1);
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				while (!_stop && (_claims.load() >> 32) == seen) {
+					_wake.wait(lock);
+				}
+			}
+			_sleepers.fetch_sub(1);
+			idle = 0;
+		}
+	}
+}
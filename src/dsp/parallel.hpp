@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bogaudio {
+namespace dsp {
+
+// A small pool of threads to share out independent per-channel work, one
+// sample's worth at a time.  run() publishes a job of n channels; the caller
+// and any awake workers claim channels from a shared counter until none are
+// left, then the caller waits for the claimed ones to finish.  Each channel is
+// run exactly once, by whichever thread claimed it, so for work that touches
+// only its own channel's state the output doesn't depend on the scheduling.
+// The job's generation and size are in the same word as the counter, so a
+// claim can only succeed against the job it was read from.
+//
+// One job runs at a time: run() returns false, having done nothing, if the
+// pool is busy with another caller's job (or has no threads), and the caller
+// should then do the work inline.  Each job keeps the workers spinning for
+// spinPeriods of the caller's sample time, so they're awake for the next
+// sample's job while one arrives every sample; after that (between audio
+// blocks, or once no module is running jobs) they sleep until woken.
+struct ChannelWorkers {
+	typedef void (*Work)(void* context, int c);
+	typedef std::chrono::steady_clock Clock;
+	static constexpr int spinPeriods = 2;
+
+	std::vector<std::thread> _threads;
+	std::atomic<bool> _busy { false };
+	std::atomic<uint64_t> _claims { 0 }; // generation << 32 | n << 16 | next unclaimed channel.
+	std::atomic<Work> _work { NULL };
+	std::atomic<void*> _context { NULL };
+	std::atomic<uint64_t> _done { 0 }; // generation << 32 | channels done.
+	std::atomic<int64_t> _spinUntil { 0 }; // in Clock ticks.
+	std::atomic<int> _sleepers { 0 };
+	std::atomic<bool> _stop { false };
+	std::mutex _mutex;
+	std::condition_variable _wake;
+
+	ChannelWorkers(int threads);
+	~ChannelWorkers();
+
+	inline int threads() { return _threads.size(); }
+	bool run(Work work, void* context, int n, float sampleTime);
+	void claimAndWork(uint64_t generation);
+	void workerLoop();
+};
+
+} // namespace dsp
+} // namespace bogaudio
@@ -48,19 +48,26 @@ float Amplifier::next(float s) {
 	return _level * s;
 }
 
+// as LevelTable: linear over the bottom rdb decibels, down to 0 at minDecibels.
+lanes_t Amplifier::levels(const lanes_t& db) {
+	const float rdb = 6.0f;
+	const float tdb = minDecibels + rdb;
+	const float ta = decibelsToAmplitude(tdb);
+	lanes_t linear = lanes::fmax(db - minDecibels, 0.0f) * (ta / rdb);
+	return lanes::ifelse(db > tdb, lanes::exp(db * (float)(M_LN10 / 20.0)), linear);
+}
+
 
 void RunningAverage::setSampleRate(float sampleRate) {
 	assert(sampleRate > 0.0f);
 	if (_sampleRate != sampleRate) {
 		_sampleRate = sampleRate;
-		if (_buffer) {
-			delete[] _buffer;
-		}
 		_bufferN = (_maxDelayMS / 1000.0f) * _sampleRate;
-		_buffer = new float[_bufferN] {};
-		if (_initialized) {
-			_initialized = false;
-			setSensitivity(_sensitivity);
+		_buffer.reserve(_bufferN + 1);
+		reset();
+		if (_sensitivity >= 0.0f) {
+			_sumN = std::max(_sensitivity * _bufferN, 1.0f);
+			_invSumN = 1.0f / (float)_sumN;
 		}
 	}
 }
@@ -68,51 +75,28 @@ void RunningAverage::setSampleRate(float sampleRate) {
 void RunningAverage::setSensitivity(float sensitivity) {
 	assert(sensitivity >= 0.0f);
 	assert(sensitivity <= 1.0f);
-	if (_initialized) {
-		if (_sensitivity != sensitivity) {
-			_sensitivity = sensitivity;
-			int newSumN = std::max(_sensitivity * _bufferN, 1.0f);
-			int i = newSumN;
-			while (i > _sumN) {
-				--_trailI;
-				if (_trailI < 0) {
-					_trailI = _bufferN - 1;
-				}
-				_sum += _buffer[_trailI];
-				--i;
-			}
-			while (i < _sumN) {
-				_sum -= _buffer[_trailI];
-				++_trailI;
-				_trailI %= _bufferN;
-				++i;
-			}
-			_sumN = newSumN;
-		}
-	}
-	else {
-		_initialized = true;
+	if (_sensitivity != sensitivity) {
 		_sensitivity = sensitivity;
-		_sumN = std::max(_sensitivity * _bufferN, 1.0f);
-		_leadI = 0;
-		_trailI = _bufferN - _sumN;
-		_sum = 0.0;
+		int newSumN = std::max(_sensitivity * _bufferN, 1.0f);
+		for (int i = _sumN; i < newSumN; ++i) {
+			_sum += _buffer.value(i);
+		}
+		for (int i = newSumN; i < _sumN; ++i) {
+			_sum -= _buffer.value(i);
+		}
+		_sumN = newSumN;
+		_invSumN = 1.0f / (float)_sumN;
 	}
-	_invSumN = 1.0f / (float)_sumN;
 }
 
 void RunningAverage::reset() {
 	_sum = 0.0;
-	std::fill(_buffer, _buffer + _bufferN, 0.0);
+	_buffer.clear();
 }
 
 float RunningAverage::next(float sample) {
-	_sum -= _buffer[_trailI];
-	++_trailI;
-	_trailI %= _bufferN;
-	_sum += _buffer[_leadI] = sample;
-	++_leadI;
-	_leadI %= _bufferN;
+	_buffer.push(sample);
+	_sum += sample - _buffer.value(_sumN);
 	return (float)_sum * _invSumN;
 }
 
@@ -178,30 +162,120 @@ void ShapedSlewLimiter::setParams(float sampleRate, float milliseconds, float sh
 	assert(shape <= maxShape);
 	_sampleTime = 1.0f / sampleRate;
 	_time = milliseconds / 1000.0f;
-	_shapeExponent = (shape > -0.05f && shape < 0.05f) ? 0.0f : shape;
-	_inverseShapeExponent = 1.0f / _shapeExponent;
+	_step = _time > 0.0f ? _sampleTime / (double)_time : 0.0;
+	float shapeExponent = (shape > -0.05f && shape < 0.05f) ? 0.0f : shape;
+	if (_shapeExponent != shapeExponent) {
+		_shapeExponent = shapeExponent;
+		_inverseShapeExponent = 1.0f / _shapeExponent;
+		_linear = _shapeExponent == 0.0f || _shapeExponent == 1.0f;
+		_haveTimeToGo = false;
+	}
 }
 
 float ShapedSlewLimiter::next(float sample) {
-	double difference = sample - _last;
-	double ttg = fabs(difference) / range;
 	if (_time < 0.0001f) {
 		return _last = sample;
 	}
-	if (_shapeExponent != 0.0f) {
-		ttg = pow(ttg, _shapeExponent);
+	double difference = sample - _last;
+	if (difference == 0.0) {
+		return _last;
+	}
+
+	// the time to go (as a fraction of _time) from where we are is kept from
+	// the last step, unless the input, or _last, has since been changed.
+	double ttg = _timeToGo;
+	if (!_haveTimeToGo || sample != _target || _last != _targetFrom) {
+		ttg = fabs(difference) / range;
+		if (!_linear) {
+			ttg = powf(ttg, _shapeExponent);
+		}
+	}
+	ttg -= _step;
+	if (ttg <= 0.0) {
+		_haveTimeToGo = false;
+		return _last = sample;
+	}
+
+	double remaining = ttg;
+	if (!_linear) {
+		remaining = powf(ttg, _inverseShapeExponent);
+	}
+	double y = fabs(difference) - remaining * range;
+	if (difference < 0.0) {
+		_last = std::max(_last - y, (double)sample);
+	}
+	else {
+		_last = std::min(_last + y, (double)sample);
+	}
+	_haveTimeToGo = true;
+	_target = sample;
+	_targetFrom = _last;
+	_timeToGo = ttg;
+	return _last;
+}
+
+
+constexpr float ShapedSlewLimiterLanes::range;
+constexpr float ShapedSlewLimiterLanes::rebaseSteps;
+
+void ShapedSlewLimiterLanes::setParams(int lane, float sampleRate, float milliseconds, float shape) {
+	assert(lane >= 0 && lane < laneWidth);
+	assert(sampleRate > 0.0f);
+	assert(milliseconds >= 0.0f);
+	assert(shape >= 0.1f);
+	assert(shape <= 5.0f);
+
+	// the steps so far were taken at the old step size.
+	float elapsed = lanes::get(_elapsed, lane);
+	if (elapsed > 0.0f) {
+		lanes::set(_timeToGo, lane, std::max(0.0f, lanes::get(_timeToGo, lane) - elapsed * lanes::get(_step, lane)));
+		lanes::set(_elapsed, lane, 0.0f);
+	}
+
+	// as ShapedSlewLimiter, very short times pass the input through: a step
+	// that always covers the full time to go.
+	float time = milliseconds / 1000.0f;
+	lanes::set(_step, lane, time < 0.0001f ? 1e30f : 1.0f / (sampleRate * time));
+	if (lanes::get(_shapeExponent, lane) != shape) {
+		lanes::set(_shapeExponent, lane, shape);
+		lanes::set(_inverseShapeExponent, lane, 1.0f / shape);
+		lanes::set(_elapsed, lane, -1.0f);
 	}
-	ttg *= _time;
-	ttg = std::max(0.0, ttg - _sampleTime);
-	ttg /= _time;
-	if (_shapeExponent != 0.0f) {
-		ttg = pow(ttg, _inverseShapeExponent);
+}
+
+
+void RiseFallShapedSlewLimiterLanes::setParams(int lane, float sampleRate, float riseMS, float riseShape, float fallMS, float fallShape) {
+	assert(lane >= 0 && lane < laneWidth);
+	_sampleRate = sampleRate;
+	_riseMS[lane] = riseMS;
+	_riseShape[lane] = riseShape;
+	_fallMS[lane] = fallMS;
+	_fallShape[lane] = fallShape;
+	if (_rising & (1 << lane)) {
+		_slew.setParams(lane, sampleRate, riseMS, riseShape);
+	}
+	else {
+		_slew.setParams(lane, sampleRate, fallMS, fallShape);
 	}
-	double y = fabs(difference) - ttg * range;
-	if (difference < 0.0f) {
-		return _last = std::max(_last - y, (double)sample);
+}
+
+void RiseFallShapedSlewLimiterLanes::reset(int lane) {
+	assert(lane >= 0 && lane < laneWidth);
+	lanes::set(_slew._last, lane, 0.0f);
+	lanes::set(_slew._target, lane, 0.0f);
+	lanes::set(_slew._targetFrom, lane, 0.0f);
+	lanes::set(_slew._elapsed, lane, -1.0f);
+}
+
+void RiseFallShapedSlewLimiterLanes::changeDirection(int rising) {
+	int changed = rising ^ _rising;
+	_rising = rising;
+	for (int l = 0; l < laneWidth; ++l) {
+		if (changed & (1 << l)) {
+			setParams(l, _sampleRate, _riseMS[l], _riseShape[l], _fallMS[l], _fallShape[l]);
+			lanes::set(_slew._elapsed, l, -1.0f);
+		}
 	}
-	return _last = std::min(_last + y, (double)sample);
 }
 
 
@@ -275,6 +349,15 @@ float CrossFader::next(float a, float b) {
 	return _aAmp.next(a) + _bAmp.next(b);
 }
 
+#ifdef RACK_SIMD
+lanes_t CrossFader::next(const lanes_t& a, const lanes_t& b) {
+	if (_linear) {
+		return _aMix * a + _bMix * b;
+	}
+	return _aAmp._level * a + _bAmp._level * b;
+}
+#endif
+
 
 void Panner::setPan(float pan) {
 	assert(pan >= -1.0f);
@@ -296,14 +379,11 @@ void DelayLine::setSampleRate(float sampleRate) {
 	assert(sampleRate > 0.0f);
 	if (_sampleRate != sampleRate) {
 		_sampleRate = sampleRate;
-		if (_buffer) {
-			delete[] _buffer;
-		}
 		_bufferN = ceil((_maxTimeMS / 1000.0f) * _sampleRate);
-		_buffer = new float[_bufferN] {};
-		if (_initialized) {
-			_initialized = false;
-			setTime(_time);
+		_buffer.reserve(_bufferN);
+		_buffer.clear();
+		if (_time >= 0.0f) {
+			_delaySamples = delaySamples();
 		}
 	}
 }
@@ -311,42 +391,15 @@ void DelayLine::setSampleRate(float sampleRate) {
 void DelayLine::setTime(float time) {
 	assert(time >= 0.0f);
 	assert(time <= 1.0f);
-	if (_initialized) {
-		if (_time != time) {
-			_time = time;
-			int newDelaySamples = delaySamples();
-			int i = newDelaySamples;
-			while (i > _delaySamples) {
-				--_trailI;
-				if (_trailI < 0) {
-					_trailI = _bufferN - 1;
-				}
-				--i;
-			}
-			while (i < _delaySamples) {
-				++_trailI;
-				_trailI %= _bufferN;
-				++i;
-			}
-			_delaySamples = newDelaySamples;
-		}
-	}
-	else {
-		_initialized = true;
+	if (_time != time) {
 		_time = time;
 		_delaySamples = delaySamples();
-		_leadI = 0;
-		_trailI = _bufferN - _delaySamples;
 	}
 }
 
 float DelayLine::next(float sample) {
-	float delayed = _buffer[_trailI];
-	++_trailI;
-	_trailI %= _bufferN;
-	_buffer[_leadI] = sample;
-	++_leadI;
-	_leadI %= _bufferN;
+	float delayed = _buffer.value(_delaySamples - 1);
+	_buffer.push(sample);
 	return delayed;
 }
 
@@ -406,11 +459,12 @@ float Limiter::next(float sample) {
 const float Saturator::limit = 12.0f;
 
 // Zavalishin 2018, "The Art of VA Filter Design", http://www.native-instruments.com/fileadmin/ni_media/downloads/pdf/VAFilterDesign_2.0.0a.pdf
-static inline float saturation(float x) {
+template<typename T>
+static inline T saturation(const T& x) {
 	const float y1 = 0.98765f; // (2*x - 1)/x**2 where x is 0.9.
 	const float offset = 0.075f / Saturator::limit; // magic.
-	float x1 = (x + 1.0f) * 0.5f;
-	return Saturator::limit * (offset + x1 - sqrtf(x1 * x1 - y1 * x) * (1.0f / y1));
+	T x1 = (x + 1.0f) * 0.5f;
+	return Saturator::limit * (offset + x1 - lanes::sqrt(x1 * x1 - y1 * x) * (1.0f / y1));
 }
 
 float Saturator::next(float sample) {
@@ -421,6 +475,13 @@ float Saturator::next(float sample) {
 	return saturation(x);
 }
 
+#ifdef RACK_SIMD
+lanes_t Saturator::next(const lanes_t& sample) {
+	lanes_t y = saturation(lanes::abs(sample) * (1.0f / limit));
+	return lanes::ifelse(sample < 0.0f, -y, y);
+}
+#endif
+
 
 const float Compressor::maxEffectiveRatio = 1000.0f;
 
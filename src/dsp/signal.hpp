@@ -2,6 +2,8 @@
 
 #include <math.h>
 
+#include "buffer.hpp"
+#include "lanes.hpp"
 #include "math.hpp"
 #include "table.hpp"
 
@@ -40,6 +42,10 @@ struct Amplifier {
 
 	void setLevel(float db);
 	float next(float s);
+
+	// the levels setLevel would give, for laneWidth channels at once, computed
+	// rather than looked up.
+	static lanes_t levels(const lanes_t& db);
 };
 
 struct RunningAverage {
@@ -47,24 +53,17 @@ struct RunningAverage {
 	float _sampleRate = -1.0f;
 	float _sensitivity = -1.0f;
 
-	bool _initialized = false;
-	float* _buffer = NULL;
+	RingBuffer<float> _buffer;
 	int _bufferN = 0;
 	int _sumN = 0;
 	float _invSumN = 0.0f;
-	int _leadI = 0;
-	int _trailI = 0;
 	double _sum = 0;
 
 	RunningAverage(float sampleRate = 1000.0f, float sensitivity = 1.0f, float maxDelayMS = 300.0f) : _maxDelayMS(maxDelayMS) {
 		setSampleRate(sampleRate);
 		setSensitivity(sensitivity);
 	}
-	virtual ~RunningAverage() {
-		if (_buffer) {
-			delete[] _buffer;
-		}
-	}
+	virtual ~RunningAverage() {}
 
 	void setSampleRate(float sampleRate);
 	void setSensitivity(float sensitivity);
@@ -113,15 +112,25 @@ struct SlewLimiter {
 	float next(float sample, float last);
 };
 
+// Slews toward the input over a time that grows as the distance, over range,
+// raised to the shape.  That time, as a fraction of the full slew time, just
+// counts down while the input holds still, so it's kept between samples,
+// and a step takes one pow rather than two (or none, for a linear shape).
 struct ShapedSlewLimiter {
 	const float range = 10.0f;
 	const float minShape = 0.1f;
 	const float maxShape = 5.0f;
 	float _sampleTime;
 	float _time;
-	float _shapeExponent;
-	float _inverseShapeExponent;
+	float _shapeExponent = 1.0f;
+	float _inverseShapeExponent = 1.0f;
+	bool _linear = true;
+	double _step = 0.0;
 	double _last = 0.0;
+	bool _haveTimeToGo = false;
+	float _target = 0.0f;
+	double _targetFrom = 0.0;
+	double _timeToGo = 0.0;
 
 	ShapedSlewLimiter(float sampleRate = 1000.0f, float milliseconds = 1.0f, float shape = 1.0f) {
 		setParams(sampleRate, milliseconds, shape);
@@ -131,6 +140,91 @@ struct ShapedSlewLimiter {
 	float next(float sample);
 };
 
+// ShapedSlewLimiter for laneWidth channels at once, with per-lane times and
+// shapes, in float.  Powers are taken as exp(log(x) * e), for all lanes of a
+// group together; the time-to-go's pow is skipped when no lane's input has
+// moved.  So that float rounding doesn't pile up over a long slew, the time to
+// go is kept as where it stood and a count of steps since, and rebased now and
+// then.  _last may be set directly, as with ShapedSlewLimiter.
+struct ShapedSlewLimiterLanes {
+	static constexpr float range = 10.0f;
+	static constexpr float rebaseSteps = 4096.0f;
+	lanes_t _step = 0.0f;
+	lanes_t _shapeExponent = 1.0f;
+	lanes_t _inverseShapeExponent = 1.0f;
+	lanes_t _last = 0.0f;
+	lanes_t _target = 0.0f;
+	lanes_t _targetFrom = 0.0f;
+	lanes_t _timeToGo = 0.0f;
+	lanes_t _elapsed = -1.0f; // negative until the time to go is known.
+
+	ShapedSlewLimiterLanes(float sampleRate = 1000.0f, float milliseconds = 1.0f, float shape = 1.0f) {
+		for (int l = 0; l < laneWidth; ++l) {
+			setParams(l, sampleRate, milliseconds, shape);
+		}
+	}
+
+	void setParams(int lane, float sampleRate, float milliseconds, float shape);
+
+	inline lanes_t next(const lanes_t& sample) {
+		const float minPower = 1e-30f;
+		lanes_t difference = sample - _last;
+		auto moved = (sample != _target) | (_last != _targetFrom) | (_elapsed < 0.0f);
+		if (lanes::any(moved)) {
+			lanes_t distance = lanes::fmax(lanes::abs(difference) * (1.0f / range), minPower);
+			_timeToGo = lanes::ifelse(moved, lanes::exp(lanes::log(distance) * _shapeExponent), _timeToGo);
+			_elapsed = lanes::ifelse(moved, lanes_t(0.0f), _elapsed);
+		}
+		else if (lanes::any(_elapsed >= rebaseSteps)) {
+			_timeToGo = lanes::fmax(_timeToGo - _elapsed * _step, 0.0f);
+			_elapsed = 0.0f;
+		}
+		_elapsed += lanes_t(1.0f);
+		_target = sample;
+
+		lanes_t ttg = lanes::fmax(_timeToGo - _elapsed * _step, 0.0f);
+		if (!lanes::any(ttg > 0.0f)) {
+			return _targetFrom = _last = sample;
+		}
+		lanes_t remaining = range * lanes::exp(lanes::log(lanes::fmax(ttg, minPower)) * _inverseShapeExponent);
+		remaining = lanes::ifelse(ttg > 0.0f, remaining, lanes_t(0.0f));
+		_last = lanes::ifelse(difference < 0.0f, sample + remaining, sample - remaining);
+		return _targetFrom = _last;
+	}
+};
+
+// RiseFallShapedSlewLimiter (see slew_common.hpp) for laneWidth channels at
+// once: a lane slews with its rise parameters while its input is above its
+// output, and with its fall parameters otherwise.  One ShapedSlewLimiterLanes
+// does both, a lane's parameters being swapped when it changes direction.
+struct RiseFallShapedSlewLimiterLanes {
+	float _sampleRate = 1000.0f;
+	float _riseMS[laneWidth] {};
+	float _riseShape[laneWidth] {};
+	float _fallMS[laneWidth] {};
+	float _fallShape[laneWidth] {};
+	int _rising = 0; // a bit per lane.
+	ShapedSlewLimiterLanes _slew;
+
+	RiseFallShapedSlewLimiterLanes() {
+		for (int l = 0; l < laneWidth; ++l) {
+			setParams(l, 1000.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+		}
+	}
+
+	void setParams(int lane, float sampleRate, float riseMS, float riseShape, float fallMS, float fallShape);
+	void reset(int lane);
+	void changeDirection(int rising);
+
+	inline lanes_t next(const lanes_t& sample) {
+		int rising = lanes::bits(sample > _slew._last);
+		if (rising != _rising) {
+			changeDirection(rising);
+		}
+		return _slew.next(sample);
+	}
+};
+
 struct Integrator {
 	float _alpha = 0.0f;
 	float _last = 0.0f;
@@ -162,6 +256,9 @@ struct CrossFader {
 		bool linear = true// cut is linear in amplitude if true; linear in decibels otherwise.
 	);
 	float next(float a, float b);
+#ifdef RACK_SIMD
+	lanes_t next(const lanes_t& a, const lanes_t& b);
+#endif
 };
 
 struct Panner {
@@ -182,20 +279,14 @@ struct DelayLine {
 	const float _maxTimeMS;
 	float _sampleRate = -1.0f;
 	int _bufferN;
-	float* _buffer = NULL;
+	RingBuffer<float> _buffer;
 	float _time = -1.0f;
-	bool _initialized = false;
-	int _delaySamples;
-	int _leadI;
-	int _trailI;
+	int _delaySamples = 1;
 
 	DelayLine(float sampleRate = 1000.0f, float maxTimeMS = 1000.0f, float time = 1.0f) : _maxTimeMS(maxTimeMS) {
 		setSampleRate(sampleRate);
 		setTime(time);
 	}
-	~DelayLine() {
-		delete[] _buffer;
-	}
 
 	void setSampleRate(float sampleRate);
 	void setTime(float time);
@@ -221,6 +312,9 @@ struct Saturator {
 	static const float limit;
 
 	float next(float sample);
+#ifdef RACK_SIMD
+	lanes_t next(const lanes_t& sample);
+#endif
 };
 
 struct Compressor {
@@ -0,0 +1,106 @@
+#include <assert.h>
+
+#include "waveshaping.hpp"
+
+using namespace bogaudio::dsp;
+
+double HardClipCurve::f2(double x) {
+	double u = std::abs(x);
+	double m = std::min(u, 1.0);
+	double e = u - m;
+	double y = m * m * m * (1.0 / 6.0) + 0.5 * m * m * e + 0.5 * e * e;
+	return x < 0.0 ? -y : y;
+}
+
+
+// Li2(-w), for w in [0, 1], by Landen's identity, which leaves a series in
+// w / (1 + w) <= 1/2, so convergence is quick.
+static double negativeDilogarithm(double w) {
+	double z = w / (1.0 + w);
+	double l = log1p(w);
+	double sum = 0.0;
+	double zk = z;
+	for (int k = 1; k < 64 && zk > 1e-17; ++k) {
+		sum += zk / (double)(k * k);
+		zk *= z;
+	}
+	return -0.5 * l * l - sum;
+}
+
+// For u = |x|: u^2/2 - u*ln(2) + (Li2(-e^-2u) - Li2(-1)) / 2.
+double TanhCurve::f2(double x) {
+	double u = std::abs(x);
+	double y = 0.5 * u * u - u * M_LN2 + 0.5 * (negativeDilogarithm(exp(-2.0 * u)) + M_PI * M_PI / 12.0);
+	return x < 0.0 ? -y : y;
+}
+
+
+// F1 is periodic and averages 1/2, so F2 is 2 per period plus the integral of
+// F1 into the current period.
+double FoldCurve::f2(double x) {
+	double k = std::floor((x + 1.0) * 0.25);
+	double p = x + 1.0 - 4.0 * k;
+	double r;
+	if (p <= 2.0) {
+		double d = p - 1.0;
+		r = (d * d * d + 1.0) * (1.0 / 6.0);
+	}
+	else {
+		double d = 3.0 - p;
+		r = 1.0 / 3.0 + (p - 2.0) + (d * d * d - 1.0) * (1.0 / 6.0);
+	}
+	return 2.0 * k + r - 1.0 / 6.0;
+}
+
+
+const float SaturatorCurve::y1 = 0.98765f; // as in Saturator.
+const float SaturatorCurve::offset = 0.075f / 12.0f; // as in Saturator.
+const double SaturatorCurve::b = 2.0 - 4.0 * (double)SaturatorCurve::y1;
+const double SaturatorCurve::c = 1.0 - 0.25 * SaturatorCurve::b * SaturatorCurve::b;
+
+// A and B are the first and second antiderivatives in v of sqrt(v^2 + c);
+// a0 and b0 are their values at u = 0.
+static double saturatorA(double v) {
+	double s = std::sqrt(v * v + SaturatorCurve::c);
+	return 0.5 * (v * s + SaturatorCurve::c * std::log(v + s));
+}
+
+static double saturatorB(double v) {
+	double s = std::sqrt(v * v + SaturatorCurve::c);
+	return 0.5 * (s * s * s * (1.0 / 3.0) + SaturatorCurve::c * (v * std::log(v + s) - s));
+}
+
+const double SaturatorCurve::a0 = saturatorA(0.5 * SaturatorCurve::b);
+const double SaturatorCurve::b0 = saturatorB(0.5 * SaturatorCurve::b);
+
+double SaturatorCurve::f2(double x) {
+	double u = std::abs(x);
+	double v = u + 0.5 * b;
+	double y = offset * 0.5 * u * u + u * u * (u + 3.0) * (1.0 / 12.0);
+	y -= (saturatorB(v) - b0 - a0 * u) * (0.5 / y1);
+	return x < 0.0 ? -y : y;
+}
+
+
+void AntialiasedSaturator::setOrder(int order) {
+	assert(order >= 0 && order <= 2);
+	if (_order != order) {
+		_order = order;
+		_firstOrder.reset();
+		_secondOrder.reset();
+	}
+}
+
+float AntialiasedSaturator::next(float sample) {
+	switch (_order) {
+		case 1: {
+			return Saturator::limit * _firstOrder.next(sample * (1.0f / Saturator::limit));
+		}
+		case 2: {
+			return Saturator::limit * _secondOrder.next(sample * (1.0f / Saturator::limit));
+		}
+		default: {
+			return _saturator.next(sample);
+		}
+	}
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "signal.hpp"
+
+namespace bogaudio {
+namespace dsp {
+
+// Antiderivative antialiasing (ADAA) of memoryless nonlinearities, per
+// Parker et al. 2016, "Reducing the aliasing of nonlinear waveshaping using
+// continuous-time convolution", and Bilbao et al. 2017, "Antiderivative
+// antialiasing for memoryless nonlinearities".  Rather than evaluate f at each
+// sample, the shaper outputs the mean of f over the straight line between
+// successive samples, computed from f's antiderivatives; that's a continuous
+// time lowpass applied before sampling, so most of the aliasing never
+// happens, at 1x.
+//
+// Curves give f and its first two antiderivatives F1 and F2, which are zero at
+// zero, for a unit input range (scale on the way in and out for others).  f
+// and F1 are templates, for float, double and lanes_t; F2 is double only, as
+// the second order's nested difference quotients need its precision.
+
+namespace waveshaping {
+	inline float select(bool cond, float a, float b) { return cond ? a : b; }
+	inline double select(bool cond, double a, double b) { return cond ? a : b; }
+	inline bool any(bool cond) { return cond; }
+#ifdef RACK_SIMD
+	inline lanes_t select(const lanes_t& mask, const lanes_t& a, const lanes_t& b) { return lanes::ifelse(mask, a, b); }
+	inline bool any(const lanes_t& mask) { return lanes::any(mask); }
+#endif
+} // namespace waveshaping
+
+// Clamps to [-1, 1].
+struct HardClipCurve {
+	template<typename T>
+	static inline T f(const T& x) {
+		return lanes::fmin(lanes::fmax(x, T(-1.0f)), T(1.0f));
+	}
+
+	template<typename T>
+	static inline T f1(const T& x) {
+		T u = lanes::abs(x);
+		T m = lanes::fmin(u, T(1.0f));
+		return 0.5f * m * m + (u - m);
+	}
+
+	static double f2(double x);
+};
+
+struct TanhCurve {
+	template<typename T>
+	static inline T f(const T& x) {
+		T e = lanes::exp(-2.0f * lanes::abs(x));
+		T y = (1.0f - e) / (1.0f + e);
+		return waveshaping::select(x < 0.0f, -y, y);
+	}
+
+	// ln(cosh(x)), arranged not to overflow.
+	template<typename T>
+	static inline T f1(const T& x) {
+		T u = lanes::abs(x);
+		return u + lanes::log(1.0f + lanes::exp(-2.0f * u)) - (float)M_LN2;
+	}
+
+	static double f2(double x);
+};
+
+// Triangle folding: the input reflects off of +/-1, as often as it must.
+struct FoldCurve {
+	template<typename T>
+	static inline T f(const T& x) {
+		return 1.0f - lanes::abs(phase(x));
+	}
+
+	template<typename T>
+	static inline T f1(const T& x) {
+		T d = phase(x);
+		T a = 1.0f - lanes::abs(d);
+		T h = 0.5f * a * a;
+		return waveshaping::select(d < 0.0f, h, 1.0f - h);
+	}
+
+	static double f2(double x);
+
+	// position in the fold's 4-unit period, from -2 to 2, with x = 0 at -1.
+	template<typename T>
+	static inline T phase(const T& x) {
+		T p = x + 1.0f;
+		return p - 4.0f * lanes::floor(p * 0.25f) - 2.0f;
+	}
+};
+
+// Saturator's curve, for input scaled by 1 / Saturator::limit.  The square
+// root in Saturator's curve is of the quadratic u^2 + b*u + 1, whose
+// antiderivatives have closed forms (with logs) in v = u + b/2.
+struct SaturatorCurve {
+	static const float y1;
+	static const float offset;
+	static const double b;
+	static const double c;
+	static const double a0;
+	static const double b0;
+
+	template<typename T>
+	static inline T f(const T& x) {
+		T u = lanes::abs(x);
+		T s = lanes::sqrt(u * u + (float)b * u + 1.0f);
+		T y = offset + 0.5f * (u + 1.0f) - s * (0.5f / y1);
+		return waveshaping::select(x < 0.0f, -y, y);
+	}
+
+	template<typename T>
+	static inline T f1(const T& x) {
+		T u = lanes::abs(x);
+		T v = u + (float)(0.5 * b);
+		T s = lanes::sqrt(v * v + (float)c);
+		T a = 0.5f * (v * s + (float)c * lanes::log(v + s));
+		return offset * u + 0.25f * u * (u + 2.0f) - (a - (float)a0) * (0.5f / y1);
+	}
+
+	static double f2(double x);
+};
+
+// First-order ADAA: y[n] = (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1]), or f at
+// the midpoint where successive inputs are too close for the quotient.  Adds
+// half a sample of latency.  T may be lanes_t, for a group of channels.
+template<class CURVE, typename T = float>
+struct FirstOrderADAA {
+	T _lastX = 0.0f;
+	T _lastF1 = 0.0f;
+
+	void reset() {
+		_lastX = 0.0f;
+		_lastF1 = 0.0f;
+	}
+
+	inline T next(const T& x) {
+		const float tolerance = 1e-3f;
+		T f1 = CURVE::f1(x);
+		T dx = x - _lastX;
+		T y = (f1 - _lastF1) / dx;
+		auto close = lanes::abs(dx) < tolerance;
+		if (waveshaping::any(close)) {
+			y = waveshaping::select(close, CURVE::f(0.5f * (x + _lastX)), y);
+		}
+		_lastX = x;
+		_lastF1 = f1;
+		return y;
+	}
+};
+
+// Second-order ADAA: the difference of successive first-order quotients of
+// F2, over x[n] - x[n-2], with fallbacks where any of those are too close.
+// Suppresses aliasing further at high drive, at one sample of latency, and
+// rolls off the top octave a bit more.  Scalar, in double.
+template<class CURVE>
+struct SecondOrderADAA {
+	double _x1 = 0.0;
+	double _x2 = 0.0;
+	double _f2x1 = 0.0;
+	double _d1 = 0.0;
+
+	void reset() {
+		_x1 = _x2 = _f2x1 = _d1 = 0.0;
+	}
+
+	float next(float sample) {
+		const double tolerance = 1e-3;
+		double x = sample;
+		double f2 = CURVE::f2(x);
+		double d0;
+		if (std::abs(x - _x1) < tolerance) {
+			d0 = CURVE::f1(0.5 * (x + _x1));
+		}
+		else {
+			d0 = (f2 - _f2x1) / (x - _x1);
+		}
+
+		double y;
+		if (std::abs(x - _x2) < tolerance) {
+			double xBar = 0.5 * (x + _x2);
+			double delta = xBar - _x1;
+			if (std::abs(delta) < tolerance) {
+				y = CURVE::f(0.5 * (xBar + _x1));
+			}
+			else {
+				y = (2.0 / delta) * (CURVE::f1(xBar) + (_f2x1 - CURVE::f2(xBar)) / delta);
+			}
+		}
+		else {
+			y = 2.0 * (d0 - _d1) / (x - _x2);
+		}
+
+		_x2 = _x1;
+		_x1 = x;
+		_f2x1 = f2;
+		_d1 = d0;
+		return y;
+	}
+};
+
+// Saturator, optionally antialiased to the given ADAA order (0 is plain
+// Saturator); see above.
+struct AntialiasedSaturator {
+	int _order = 0;
+	Saturator _saturator;
+	FirstOrderADAA<SaturatorCurve> _firstOrder;
+	SecondOrderADAA<SaturatorCurve> _secondOrder;
+
+	void setOrder(int order);
+	float next(float sample);
+};
+
+} // namespace dsp
+} // namespace bogaudio
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <type_traits>
 
 #include "rack.hpp"
@@ -11,8 +12,6 @@ namespace bogaudio {
 
 struct ExpanderMessage {
 	int channels = 0;
-
-	virtual ~ExpanderMessage() {}
 };
 
 template<class MSG, class BASE>
@@ -112,6 +111,60 @@ struct ExpanderModule : BASE {
 	}
 };
 
+// Expansion by direct call rather than messages, for an expander doing part
+// of its base's per-sample processing.  The base calls into the expander (an
+// X) from its own process(), within the same sample, so there's no message
+// to copy or flip, and no sample of latency per hop.  Rack links expanders
+// between frames, so base and expander agree for a whole frame on whether
+// they're connected; while they are, the expander must leave the shared
+// processing to the base, so that only the base's thread touches it.
+template<class X, class BASE>
+struct DirectExpandableModule : BASE {
+	std::function<bool(Model*)> _expanderModel;
+	Module* _expanderModule = NULL;
+	Model* _expanderModuleModel = NULL;
+	X* _expander = NULL;
+
+	DirectExpandableModule() {
+		static_assert(std::is_base_of<BGModule, BASE>::value, "type parameter BASE must derive from BGModule");
+	}
+
+	void setExpanderModelPredicate(std::function<bool(Model*)> p) {
+		_expanderModel = p;
+	}
+
+	// the connected expander, or NULL; only casts when the neighbor changes.
+	X* expander() {
+		Module* m = BGModule::rightExpander.module;
+		if (m != _expanderModule || (m && m->model != _expanderModuleModel)) {
+			_expanderModule = m;
+			_expanderModuleModel = m ? m->model : NULL;
+			_expander = NULL;
+			if (m && _expanderModel && _expanderModel(m->model)) {
+				_expander = dynamic_cast<X*>(m);
+			}
+		}
+		return _expander;
+	}
+};
+
+template<class BASE>
+struct DirectExpanderModule : BASE {
+	std::function<bool(Model*)> _baseModel;
+
+	DirectExpanderModule() {
+		static_assert(std::is_base_of<BGModule, BASE>::value, "type parameter BASE must derive from BGModule");
+	}
+
+	void setBaseModelPredicate(std::function<bool(Model*)> p) {
+		_baseModel = p;
+	}
+
+	bool baseConnected() {
+		return BGModule::leftExpander.module && _baseModel && _baseModel(BGModule::leftExpander.module->model);
+	}
+};
+
 template<class E, int N>
 struct ChainableRegistry {
 public:
@@ -134,17 +187,87 @@ public:
 		}
 	};
 
+	// The chain's elements reach the audio thread as immutable snapshots.
+	// setElements (called under the registry lock) publishes a new one; the
+	// audio thread's next elements() call takes it with a single exchange and
+	// retires the one it was using onto a list that the registry side frees
+	// on its next change.  So the audio thread never waits, allocates or frees.
+	// A base takes its elements once per sample, so a change only shows at the
+	// start of a sample, and an expander leaves the chain from onRemove(),
+	// with the engine stopped: its elements can be freed with it, as no
+	// sample still in progress can be using them.
 	struct ChainableBase : Chainable {
-		SpinLock _elementsLock;
-		std::vector<E*> _elements;
+		struct Elements {
+			std::vector<E*> elements;
+			Elements* nextRetired = NULL;
+		};
+
+		Elements* _elements;
+		std::atomic<Elements*> _pendingElements;
+		std::atomic<Elements*> _retiredElements;
+		std::atomic<int> _elementsN;
+
+		ChainableBase()
+		: _elements(new Elements())
+		, _pendingElements(NULL)
+		, _retiredElements(NULL)
+		, _elementsN(0)
+		{}
+		virtual ~ChainableBase() {
+			reclaimElements();
+			if (_pendingElements.load()) {
+				delete _pendingElements.load();
+			}
+			delete _elements;
+		}
 
 		void setElements(const std::vector<E*>& elements) {
-			std::lock_guard<SpinLock> lock(_elementsLock);
-			_elements = elements;
-			elementsChanged();
+			reclaimElements();
+			Elements* e = new Elements();
+			e->elements = elements;
+			_elementsN = elements.size();
+			Elements* unused = _pendingElements.exchange(e, std::memory_order_acq_rel);
+			if (unused) {
+				delete unused;
+			}
+			elementsChanged(e->elements);
+		}
+
+		// audio thread (or with it stopped) only.
+		inline const std::vector<E*>& elements() {
+			if (_pendingElements.load(std::memory_order_relaxed)) {
+				Elements* e = _pendingElements.exchange(NULL, std::memory_order_acq_rel);
+				if (e) {
+					retireElements(_elements);
+					_elements = e;
+				}
+			}
+			return _elements->elements;
+		}
+
+		// any thread.
+		inline int elementsN() {
+			return _elementsN.load(std::memory_order_relaxed);
+		}
+
+		// the registry side only changes the list by taking all of it, so this
+		// retries at most once per concurrent reclaimElements().
+		void retireElements(Elements* e) {
+			e->nextRetired = _retiredElements.load(std::memory_order_relaxed);
+			while (!_retiredElements.compare_exchange_weak(e->nextRetired, e, std::memory_order_release, std::memory_order_relaxed)) {}
 		}
 
-		virtual void elementsChanged() {}
+		void reclaimElements() {
+			Elements* e = _retiredElements.exchange(NULL, std::memory_order_acquire);
+			while (e) {
+				Elements* next = e->nextRetired;
+				delete e;
+				e = next;
+			}
+		}
+
+		// called from setElements, not on the audio thread.
+		virtual void elementsChanged(const std::vector<E*>& elements) {}
 	};
 
 	typedef Chainable ChainableExpander;
@@ -273,16 +396,26 @@ struct ChainableExpanderModule
 	: _registry(ChainableRegistry<ELEMENT, N>::registry())
 	{}
 	virtual ~ChainableExpanderModule() {
-		_registry.deregisterExpander(_baseID, _position);
+		deregister();
 	}
 
-	void setBaseIDAndPosition(int baseID, int position) {
-		if (_registered && (position <= 0 || position != _position)) {
+	void onRemove() override {
+		deregister();
+	}
+
+	void deregister() {
+		if (_registered) {
 			_registry.deregisterExpander(_baseID, _position);
 			_registered = false;
 			_baseID = 0;
 			_position = 0;
 		}
+	}
+
+	void setBaseIDAndPosition(int baseID, int position) {
+		if (_registered && (position <= 0 || position != _position)) {
+			deregister();
+		}
 		else if (!_registered && position > 0 && _registry.registerExpander(baseID, position, *this)) {
 			_registered = true;
 			_baseID = baseID;
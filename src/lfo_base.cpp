@@ -23,6 +23,89 @@ float LFOBase::Smoother::next(float sample) {
 	return _slewLimiter.next(sample);
 }
 
+constexpr int LFOBase::controlRateSteps;
+constexpr float LFOBase::controlRateMaxFrequency;
+constexpr int LFOBase::rampSegmentBits;
+constexpr int LFOBase::triangleSegmentBits;
+
+void LFOBase::ControlRateBlock::next(bool enabled, const Phasor& phasor, bool restart) {
+	if (!enabled || phasor._frequency > controlRateMaxFrequency) {
+		_active = false;
+	}
+	else if (!_active || restart || ++_step >= controlRateSteps) {
+		_active = true;
+		_step = 0;
+		++_blocks;
+	}
+}
+
+// A wave starting late in a block (just connected or switched, say)
+// interpolates over what's left of it.
+float LFOBase::ControlRateWave::next(Phasor& wave, const Phasor& phasor, Phasor::phase_delta_t offset, const ControlRateBlock& block, int segmentBits) {
+	if (!block._active) {
+		return wave.nextFromPhasor(phasor, offset);
+	}
+
+	if (_block != block._blocks || _wave != &wave) {
+		_wave = &wave;
+		_block = block._blocks;
+		_start = block._step;
+		int steps = controlRateSteps - _start;
+		Phasor::phase_t from = phasor._phase + offset;
+		Phasor::phase_t to = from + steps * phasor._delta;
+		_exact = segmentBits > 0 && (from >> segmentBits) != (to >> segmentBits);
+		if (!_exact) {
+			_from = wave.nextForPhase(from);
+			_slope = (wave.nextForPhase(to) - _from) / (float)steps;
+		}
+	}
+	if (_exact) {
+		return wave.nextFromPhasor(phasor, offset);
+	}
+	return _from + _slope * (block._step - _start);
+}
+
+void LFOBase::ControlRateTaps::next(PhaseTaps& taps, PhaseTaps::Wave wave, const Phasor& phasor, const ControlRateBlock& block, float* out) {
+	if (!block._active || wave == PhaseTaps::SQUARE_WAVE || wave == PhaseTaps::STEPPED_WAVE) {
+		taps.next(wave, phasor._phase, out);
+		return;
+	}
+
+	if (_block != block._blocks || _wave != wave) {
+		_wave = wave;
+		_block = block._blocks;
+		_start = block._step;
+		int steps = controlRateSteps - _start;
+		Phasor::phase_t to = phasor._phase + steps * phasor._delta;
+		float toValues[PhaseTaps::maxTaps];
+		taps.next(wave, phasor._phase, _from);
+		taps.next(wave, to, toValues);
+		int segmentBits = 0;
+		if (wave == PhaseTaps::RAMP_UP_WAVE || wave == PhaseTaps::RAMP_DOWN_WAVE) {
+			segmentBits = rampSegmentBits;
+		}
+		else if (wave == PhaseTaps::TRIANGLE_WAVE) {
+			segmentBits = triangleSegmentBits;
+		}
+		_anyExact = false;
+		for (int t = 0; t < taps._taps; ++t) {
+			_exact[t] = segmentBits > 0 && taps.crosses(t, phasor._phase, to, segmentBits);
+			_anyExact = _anyExact || _exact[t];
+			_slope[t] = (toValues[t] - _from[t]) / (float)steps;
+		}
+	}
+
+	if (_anyExact) {
+		taps.next(wave, phasor._phase, out);
+	}
+	int step = block._step - _start;
+	for (int t = 0; t < taps._taps; ++t) {
+		if (!_exact[t]) {
+			out[t] = _from[t] + _slope[t] * step;
+		}
+	}
+}
+
 float LFOBase::LFOFrequencyParamQuantity::offset() {
 	auto lfo = dynamic_cast<LFOBase*>(module);
 	return lfo->getPitchOffset();
@@ -54,9 +137,11 @@ void LFOBase::setFrequency(Param& frequency, Input& pitch, Phasor& phasor, int c
 }
 
 #define OFFSET_SCALE "offset_scale"
+#define CONTROL_RATE "control_rate"
 
 json_t* LFOBase::saveToJson(json_t* root) {
 	json_object_set_new(root, OFFSET_SCALE, json_real(_offsetScale));
+	json_object_set_new(root, CONTROL_RATE, json_boolean(_controlRate));
 	return root;
 }
 
@@ -65,6 +150,11 @@ void LFOBase::loadFromJson(json_t* root) {
 	if (os) {
 		_offsetScale = clamp(json_real_value(os), 1.0f, 2.0f);
 	}
+
+	json_t* cr = json_object_get(root, CONTROL_RATE);
+	if (cr) {
+		_controlRate = json_is_true(cr);
+	}
 }
 
 
@@ -76,4 +166,6 @@ void LFOBaseModuleWidget::contextMenu(Menu* menu) {
 	o->addItem(OptionMenuItem("+/-5V", [m]() { return (int)m->_offsetScale == 1; }, [m]() { m->_offsetScale = 1.0f; }));
 	o->addItem(OptionMenuItem("+/-10V", [m]() { return (int)m->_offsetScale == 2; }, [m]() { m->_offsetScale = 2.0f; }));
 	OptionsMenuItem::addToMenu(o, menu);
+
+	menu->addChild(new BoolOptionMenuItem("Control rate below 20Hz", [m]() { return &m->_controlRate; }));
 }
@@ -43,8 +43,57 @@ struct LFOBase : BGModule {
 		float next(float sample);
 	};
 
+	// Optional control rate: while a channel runs at or below
+	// controlRateMaxFrequency, its smooth waves are evaluated once per block of
+	// controlRateSteps samples, at the block's ends, and interpolated linearly
+	// between.  The phasor still advances, and resets land, every sample.
+	static constexpr int controlRateSteps = 16;
+	static constexpr float controlRateMaxFrequency = 20.0f;
+
+	// per channel; next() once per sample, after the phasor advances.
+	struct ControlRateBlock {
+		uint32_t _blocks = 0;
+		int _step = 0;
+		bool _active = false;
+
+		void next(bool enabled, const Phasor& phasor, bool restart);
+	};
+
+	// per output.  A piecewise-linear wave passes segmentBits, the log2 of its
+	// segments' phase length, and is evaluated every sample over a block
+	// spanning two segments: the ramps' jumps and the triangle's corners stay
+	// sharp, and elsewhere the interpolation is exact.
+	static constexpr int rampSegmentBits = Phasor::cycleBits;
+	static constexpr int triangleSegmentBits = Phasor::cycleBits - 2;
+
+	struct ControlRateWave {
+		const Phasor* _wave = NULL;
+		uint32_t _block = 0;
+		int _start = 0;
+		bool _exact = true;
+		float _from = 0.0f;
+		float _slope = 0.0f;
+
+		float next(Phasor& wave, const Phasor& phasor, Phasor::phase_delta_t offset, const ControlRateBlock& block, int segmentBits = 0);
+	};
+
+	// ControlRateWave for all of a PhaseTaps' taps; the square and stepped
+	// waves are evaluated every sample.
+	struct ControlRateTaps {
+		int _wave = -1;
+		uint32_t _block = 0;
+		int _start = 0;
+		bool _anyExact = false;
+		bool _exact[PhaseTaps::maxTaps] {};
+		float _from[PhaseTaps::maxTaps] {};
+		float _slope[PhaseTaps::maxTaps] {};
+
+		void next(PhaseTaps& taps, PhaseTaps::Wave wave, const Phasor& phasor, const ControlRateBlock& block, float* out);
+	};
+
 	bool _slowMode = false;
 	float _offsetScale = 1.0f;
+	bool _controlRate = false;
 	PitchModeListener* _pitchModeListener = NULL;
 
 	struct LFOFrequencyParamQuantity : FrequencyParamQuantity {
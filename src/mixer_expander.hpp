@@ -6,14 +6,25 @@
 
 namespace bogaudio {
 
+// One sample of a mixer's channel strips, handed to its expander and back
+// by direct call (see DirectExpandableModule).  A plain aggregate; the mixer
+// value-initializes its one instance.
 template<int N>
-struct MixerExpanderMessage : ExpanderMessage {
-	bool active[N] {};
-	float preFader[N] {};
-	float postFader[N] {};
-	float postEQ[N] {};
-	float returnA[2] {};
-	float returnB[2] {};
+struct MixerExpanderStrips {
+	bool active[N];
+	float preFader[N];
+	float postFader[N];
+	float postEQ[N];
+	float returnA[2];
+	float returnB[2];
+};
+
+template<int N>
+struct MixerExpander {
+	virtual ~MixerExpander() {}
+
+	// called from the mixer's process(): sets postEQ and the returns.
+	virtual void processStrips(MixerExpanderStrips<N>& strips) = 0;
 };
 
 struct MixerExpanderChannel {
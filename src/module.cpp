@@ -5,6 +5,8 @@
 using namespace bogaudio;
 
 #define SKIN "skin"
+#define PARALLEL_CHANNELS "parallel_channels"
+#define CHANNELS "channels"
 
 void BGModule::onReset() {
 	_steps = _modulationSteps;
@@ -17,11 +19,58 @@ void BGModule::onSampleRateChange() {
 	sampleRateChange();
 }
 
+void BGModule::onAdd() {
+	if (!_initialized) {
+		initialize();
+	}
+	if (_parallelizable) {
+		channelWorkers(); // start the workers here, not on the audio thread.
+	}
+}
+
+// Runs the reset and sample rate setup process() would otherwise run first
+// thing, and builds the channels (as many as when the module was saved, if
+// it's being loaded), while the engine isn't yet processing the module, so
+// none of it lands on the audio thread.
+void BGModule::initialize() {
+	_initialized = true;
+	onReset();
+	onSampleRateChange();
+	updateChannels(std::max(std::max(1, channels()), _savedChannels));
+}
+
+void BGModule::updateChannels(int channelsNow) {
+	int channelsBefore = _channels;
+	if (channelsBefore != channelsNow) {
+		_channels = channelsNow;
+		_inverseChannels = 1.0f / (float)_channels;
+		channelsChanged(channelsBefore, channelsNow);
+		if (channelsBefore < channelsNow) {
+			while (channelsBefore < channelsNow) {
+				addChannel(channelsBefore);
+				++channelsBefore;
+			}
+		}
+		else {
+			while (channelsNow < channelsBefore) {
+				removeChannel(channelsBefore - 1);
+				--channelsBefore;
+			}
+		}
+	}
+}
+
 json_t* BGModule::dataToJson() {
 	json_t* root = json_object();
 	if (_skinnable && _skin != "default") {
 		json_object_set_new(root, SKIN, json_string(_skin.c_str()));
 	}
+	if (_parallelizable && _parallelChannels) {
+		json_object_set_new(root, PARALLEL_CHANNELS, json_true());
+	}
+	if (_channels > 1) {
+		json_object_set_new(root, CHANNELS, json_integer(_channels));
+	}
 	return saveToJson(root);
 }
 
@@ -36,14 +85,28 @@ void BGModule::dataFromJson(json_t* root) {
 		}
 	}
 
+	if (_parallelizable) {
+		json_t* pc = json_object_get(root, PARALLEL_CHANNELS);
+		_parallelChannels = pc && json_is_true(pc);
+	}
+
+	json_t* c = json_object_get(root, CHANNELS);
+	if (c) {
+		_savedChannels = clamp((int)json_integer_value(c), 1, maxChannels);
+	}
+
 	loadFromJson(root);
+
+	// the engine holds its lock while loading a module, so if it's already
+	// running this one, channels can still be added here rather than in process().
+	if (_initialized && _channels < _savedChannels) {
+		updateChannels(_savedChannels);
+	}
 }
 
 void BGModule::process(const ProcessArgs& args) {
 	if (!_initialized) {
-		_initialized = true;
-		onReset();
-		onSampleRateChange();
+		initialize();
 	}
 
 	bool modulateNow = false;
@@ -57,26 +120,7 @@ void BGModule::process(const ProcessArgs& args) {
 	processAlways(args);
 	if (active()) {
 		if (modulateNow) {
-			int channelsBefore = _channels;
-			int channelsNow = std::max(1, channels());
-			if (channelsBefore != channelsNow) {
-				_channels = channelsNow;
-				_inverseChannels = 1.0f / (float)_channels;
-				channelsChanged(channelsBefore, channelsNow);
-				if (channelsBefore < channelsNow) {
-					while (channelsBefore < channelsNow) {
-						addChannel(channelsBefore);
-						++channelsBefore;
-					}
-				}
-				else {
-					while (channelsNow < channelsBefore) {
-						removeChannel(channelsBefore - 1);
-						--channelsBefore;
-					}
-				}
-			}
-
+			updateChannels(std::max(1, channels()));
 			modulate();
 			for (int i = 0; i < _channels; ++i) {
 				modulateChannel(i);
@@ -84,8 +128,10 @@ void BGModule::process(const ProcessArgs& args) {
 		}
 
 		processAll(args);
-		for (int i = 0; i < _channels; ++i) {
-			processChannel(args, i);
+		if (!(_parallelChannels && processChannelsInParallel(args))) {
+			for (int i = 0; i < _channels; ++i) {
+				processChannel(args, i);
+			}
 		}
 		postProcess(args);
 	}
@@ -106,13 +152,44 @@ void BGModule::addSkinChangeListener(SkinChangeListener* listener) {
 	listener->skinChanged(_skin);
 }
 
+namespace {
+	struct ParallelChannels {
+		BGModule* module;
+		const Module::ProcessArgs* args;
+
+		static void processChannel(void* context, int c) {
+			ParallelChannels* pc = (ParallelChannels*)context;
+			pc->module->processChannel(*pc->args, c);
+		}
+	};
+}
+
+// False if the workers are busy with another module's channels, or there
+// aren't any (the engine's threads have the cores), in which case the caller
+// processes its channels inline.
+bool BGModule::processChannelsInParallel(const ProcessArgs& args) {
+	ParallelChannels pc { this, &args };
+	return channelWorkers().run(ParallelChannels::processChannel, &pc, _channels, args.sampleTime);
+}
+
+bogaudio::dsp::ChannelWorkers& BGModule::channelWorkers() {
+	static bogaudio::dsp::ChannelWorkers workers(clamp((int)std::thread::hardware_concurrency() - settings::threadCount, 0, maxChannelWorkers));
+	return workers;
+}
+
 
 BGModuleWidget::BGModuleWidget() {
-	Skins::skins().registerDefaultSkinChangeListener(this);
+	_defaultSkinGeneration = Skins::skins().defaultSkinGeneration();
 }
 
-BGModuleWidget::~BGModuleWidget() {
-	Skins::skins().deregisterDefaultSkinChangeListener(this);
+void BGModuleWidget::step() {
+	Skins& skins = Skins::skins();
+	int generation = skins.defaultSkinGeneration();
+	if (_defaultSkinGeneration != generation && skins.claimDefaultSkinChange()) {
+		_defaultSkinGeneration = generation;
+		defaultSkinChanged(skins.defaultKey());
+	}
+	ModuleWidget::step();
 }
 
 void BGModuleWidget::addParam(ParamWidget* param) {
@@ -185,6 +262,11 @@ void BGModuleWidget::appendContextMenu(Menu* menu) {
 	}
 
 	contextMenu(menu);
+
+	if (m->_parallelizable) {
+		menu->addChild(new MenuLabel());
+		menu->addChild(new BoolOptionMenuItem("Process channels in parallel", [m]() { return &m->_parallelChannels; }));
+	}
 }
 
 void BGModuleWidget::skinChanged(const std::string& skin) {
@@ -217,7 +299,7 @@ void BGModuleWidget::setPanel(Vec size, std::string slug, bool skinnable) {
 }
 
 void BGModuleWidget::updatePanel() {
-	const Skins& skins = Skins::skins();
+	Skins& skins = Skins::skins();
 	std::string skin = skins.defaultKey();
 	if (!_skinnable) {
 		skin = "light";
@@ -240,16 +322,10 @@ void BGModuleWidget::updatePanel() {
 		_panel = NULL;
 	}
 
-	std::string svg = "res/" + _slug;
-	if (skin != "light") {
-		svg += "-";
-		svg += skin;
-	}
-	svg += ".svg";
 	_panel = new SvgPanel();
 	_panel->box.size = _size;
 	addChildBottom(_panel);
-	_panel->setBackground(APP->window->loadSvg(asset::plugin(pluginInstance, svg)));
+	_panel->setBackground(skins.panelSvg(_slug, skin));
 }
 
 void BGModuleWidget::createScrews() {
@@ -2,6 +2,8 @@
 
 #include "rack.hpp"
 #include "skins.hpp"
+#include "dsp/lanes.hpp"
+#include "dsp/parallel.hpp"
 #include <string>
 #include <vector>
 
@@ -13,6 +15,24 @@ struct SkinChangeListener {
 	virtual void skinChanged(const std::string& skin) = 0;
 };
 
+// Port access a lane group at a time, for modules processing channels in
+// bogaudio::dsp::lanes_t groups; c is the group's first channel.
+inline bogaudio::dsp::lanes_t getPolyLanes(Input& input, int c) {
+#ifdef RACK_SIMD
+	return input.getPolyVoltageSimd<bogaudio::dsp::lanes_t>(c);
+#else
+	return input.getPolyVoltage(c);
+#endif
+}
+
+inline void setLanes(Output& output, const bogaudio::dsp::lanes_t& v, int c) {
+#ifdef RACK_SIMD
+	output.setVoltageSimd(v, c);
+#else
+	output.setVoltage(v, c);
+#endif
+}
+
 struct BGModule : Module {
 	int _modulationSteps = 100;
 	int _steps = -1;
@@ -21,6 +41,14 @@ struct BGModule : Module {
 	static constexpr int maxChannels = PORT_MAX_CHANNELS;
 	int _channels = 0;
 	float _inverseChannels = 0.0f;
+	int _savedChannels = 1;
+
+	// A module whose processChannel(args, c) touches only channel c's state,
+	// and channel c of its ports, may set _parallelizable, offering (on the
+	// context menu) to share its channels out to worker threads each sample.
+	static constexpr int maxChannelWorkers = 3;
+	bool _parallelizable = false;
+	bool _parallelChannels = false;
 
 	bool _skinnable = true;
 	std::string _skin = "default";
@@ -37,6 +65,7 @@ struct BGModule : Module {
 
 	void onReset() override;
 	void onSampleRateChange() override;
+	void onAdd() override;
 	json_t* dataToJson() override;
 	void dataFromJson(json_t* root) override;
 	void process(const ProcessArgs& args) override;
@@ -59,19 +88,26 @@ struct BGModule : Module {
 	virtual void postProcess(const ProcessArgs& args) {}
 	virtual void postProcessAlways(const ProcessArgs& args) {} // modulate() may not have been called.
 
+	void initialize();
+	void updateChannels(int channelsNow);
 	void setSkin(std::string skin);
 	void addSkinChangeListener(SkinChangeListener* listener);
+
+	bool processChannelsInParallel(const ProcessArgs& args);
+	static bogaudio::dsp::ChannelWorkers& channelWorkers();
 };
 
-struct BGModuleWidget : ModuleWidget, SkinChangeListener, DefaultSkinChangeListener {
+struct BGModuleWidget : ModuleWidget, SkinChangeListener {
 	bool _skinnable = true;
 	SvgPanel* _panel = NULL;
 	Vec _size;
 	std::string _slug;
 	std::string _loadedSkin;
+	int _defaultSkinGeneration;
 
 	BGModuleWidget();
-	virtual ~BGModuleWidget();
+
+	void step() override;
 
 	void appendContextMenu(Menu* menu) override;
 	void addParam(ParamWidget* param);
@@ -81,7 +117,7 @@ struct BGModuleWidget : ModuleWidget, SkinChangeListener, DefaultSkinChangeListe
 	virtual void contextMenu(Menu* menu) {}
 
 	void skinChanged(const std::string& skin) override;
-	void defaultSkinChanged(const std::string& skin) override;
+	void defaultSkinChanged(const std::string& skin);
 	void setPanel(Vec size, const std::string slug, bool skinnable = true);
 	void updatePanel();
 	void createScrews();
@@ -2,117 +2,182 @@
 #include "parametric_eq.hpp"
 #include "dsp/pitch.hpp"
 
-const float PEQChannel::maxDecibels = 6.0f;
-const float PEQChannel::minDecibels = Amplifier::minDecibels;
-constexpr float PEQChannel::maxFrequency;
-constexpr float PEQChannel::minFrequency;
-const float PEQChannel::maxFrequencySemitone = frequencyToSemitone(PEQChannel::maxFrequency);
-const float PEQChannel::minFrequencySemitone = frequencyToSemitone(PEQChannel::minFrequency);
-
-void PEQChannel::setSampleRate(float sampleRate) {
-	_sampleRate = sampleRate;
-	_levelSL.setParams(sampleRate, 0.05f, maxDecibels - minDecibels);
-	_frequencySL.setParams(sampleRate, 0.5f, frequencyToSemitone(maxFrequency - minFrequency));
-	_bandwidthSL.setParams(sampleRate, 0.05f, MultimodeFilter::maxQbw - MultimodeFilter::minQbw);
-	_rms.setSampleRate(sampleRate);
+const float PEQEngine::maxDecibels = 6.0f;
+const float PEQEngine::minDecibels = Amplifier::minDecibels;
+constexpr float PEQEngine::maxFrequency;
+constexpr float PEQEngine::minFrequency;
+const float PEQEngine::maxFrequencySemitone = frequencyToSemitone(PEQEngine::maxFrequency);
+const float PEQEngine::minFrequencySemitone = frequencyToSemitone(PEQEngine::minFrequency);
+constexpr int PEQEngine::maxBands;
+constexpr int PEQEngine::maxGroups;
+constexpr float PEQEngine::rmsWindowMS;
+
+PEQEngine::PEQEngine(int bands) : _n(bands), _filters(maxGroups * bands) {
+	assert(bands >= 3 && bands <= maxBands);
 }
 
-void PEQChannel::setFilterMode(MultimodeFilter::Mode mode) {
-	_mode = mode;
-	_poles = _mode == MultimodeFilter::BANDPASS_MODE ? 4 : 12;
+void PEQEngine::configBand(
+	int i,
+	Param& levelParam,
+	Param& frequencyParam,
+	Param& frequencyCv1Param,
+	Param* frequencyCv2Param,
+	Param& bandwidthParam,
+	Input& levelCvInput,
+	Input& frequencyCv1Input,
+	Input& frequencyCv2Input,
+	Input* bandwidthCvInput
+) {
+	assert(i >= 0 && i < _n);
+	Band& b = _bands[i];
+	b.levelParam = &levelParam;
+	b.frequencyParam = &frequencyParam;
+	b.frequencyCv1Param = &frequencyCv1Param;
+	b.frequencyCv2Param = frequencyCv2Param;
+	b.bandwidthParam = &bandwidthParam;
+	b.levelInput = &levelCvInput;
+	b.frequency1Input = &frequencyCv1Input;
+	b.frequency2Input = &frequencyCv2Input;
+	b.bandwidthInput = bandwidthCvInput;
 }
 
-void PEQChannel::modulate() {
-	float level = clamp(_levelParam.getValue(), 0.0f, 1.0f);
-	if (_levelInput.isConnected()) {
-		level *= clamp(_levelInput.getPolyVoltage(_c) / 10.0f, 0.0f, 1.0f);
+void PEQEngine::setFilterMode(int i, MultimodeFilter::Mode mode) {
+	assert(i >= 0 && i < _n);
+	_bands[i].mode = mode;
+	_bands[i].poles = mode == MultimodeFilter::BANDPASS_MODE ? 4 : 12;
+}
+
+// the level and frequency slews step once per modulate().
+void PEQEngine::setSampleRate(float sr) {
+	_sampleRate = sr;
+	_levelDelta = (maxDecibels - minDecibels) / ((0.05f / 1000.0f) * sr);
+	_frequencyDelta = frequencyToSemitone(maxFrequency - minFrequency) / ((0.5f / 1000.0f) * sr);
+	for (int i = 0; i < _n; ++i) {
+		_bands[i].rms.setSampleRate(sr);
+	}
+}
+
+void PEQEngine::reset(int c) {
+	assert(c >= 0 && c < BGModule::maxChannels);
+	int g = c / laneWidth;
+	int l = c % laneWidth;
+	for (int i = 0, b = g * _n; i < _n; ++i, ++b) {
+		lanes::set(_levelDbs[b], l, 0.0f);
+		lanes::set(_semitones[b], l, 0.0f);
+		lanes::set(_dcLastIns[b], l, 0.0f);
+		lanes::set(_dcLastOuts[b], l, 0.0f);
+		_filters.reset(b, l);
+	}
+}
+
+void PEQEngine::modulate(int channels) {
+	assert(channels >= 1 && channels <= BGModule::maxChannels);
+	_channels = channels;
+	for (int g = 0, groups = laneGroups(_channels); g < groups; ++g) {
+		float active[laneWidth];
+		for (int l = 0; l < laneWidth; ++l) {
+			active[l] = (float)(g * laneWidth + l < _channels);
+		}
+		_activeLanes[g] = lanes::load(active);
+
+		_designsChanged[g] = 0;
+		for (int i = 0; i < _n; ++i) {
+			modulateBand(g, i);
+		}
+	}
+}
+
+void PEQEngine::modulateBand(int g, int i) {
+	Band& band = _bands[i];
+	int b = g * _n + i;
+	int c = g * laneWidth;
+
+	lanes_t level = clamp(band.levelParam->getValue(), 0.0f, 1.0f);
+	if (band.levelInput->isConnected()) {
+		level *= lanes::fmin(lanes::fmax(getPolyLanes(*band.levelInput, c) * 0.1f, 0.0f), 1.0f);
 	}
-	level *= maxDecibels - minDecibels;
-	level += minDecibels;
-	_amplifier.setLevel(_levelSL.next(level));
+	level = minDecibels + level * (maxDecibels - minDecibels);
+	_levelDbs[b] += lanes::fmin(lanes::fmax(level - _levelDbs[b], -_levelDelta), _levelDelta);
+	_levels[b] = Amplifier::levels(_levelDbs[b]);
 
-	float fcv = 0.0f;
-	if (_frequency1Input.isConnected()) {
-		fcv += clamp(_frequency1Input.getPolyVoltage(_c) / 5.0f, -1.0f, 1.0f);
+	lanes_t fcv = 0.0f;
+	if (band.frequency1Input->isConnected()) {
+		fcv += lanes::fmin(lanes::fmax(getPolyLanes(*band.frequency1Input, c) * 0.2f, -1.0f), 1.0f);
 	}
-	if (_frequency2Input.isConnected()) {
-		float cv = clamp(_frequency2Input.getPolyVoltage(_c) / 5.0f, -1.0f, 1.0f);
-		if (_frequencyCv2Param) {
-			cv *= _frequencyCv2Param->getValue();
+	if (band.frequency2Input->isConnected()) {
+		lanes_t cv = lanes::fmin(lanes::fmax(getPolyLanes(*band.frequency2Input, c) * 0.2f, -1.0f), 1.0f);
+		if (band.frequencyCv2Param) {
+			cv = cv * band.frequencyCv2Param->getValue();
 		}
 		fcv += cv;
 	}
-	fcv *= _frequencyCv1Param.getValue();
+	float fcvScale = band.frequencyCv1Param->getValue();
 	if (_fullFrequencyMode) {
-		fcv *= maxFrequencySemitone - minFrequencySemitone;
+		fcvScale *= maxFrequencySemitone - minFrequencySemitone;
 	}
 	else {
-		fcv *= 12.0f;
+		fcvScale *= 12.0f;
 	}
-
-	frequency = _frequencyParam.getValue();
-	frequency *= frequency;
-	frequency *= maxFrequency;
-	frequency = clamp(frequency, minFrequency, maxFrequency);
-	frequency = frequencyToSemitone(frequency);
-	frequency += fcv;
-	frequency = clamp(frequency, minFrequencySemitone, maxFrequencySemitone);
-	frequency = semitoneToFrequency(_frequencySL.next(frequency));
-
-	bandwidth = MultimodeFilter::minQbw;
-	if (_mode == MultimodeFilter::BANDPASS_MODE) {
-		bandwidth = clamp(_bandwidthParam.getValue(), 0.0f, 1.0f);
-		if (_bandwidthInput && _bandwidthInput->isConnected()) {
-			bandwidth *= clamp(_bandwidthInput->getPolyVoltage(_c) / 10.0f, 0.0f, 1.0f);
+	fcv = fcv * fcvScale;
+
+	float f = band.frequencyParam->getValue();
+	f *= f;
+	f *= maxFrequency;
+	f = clamp(f, minFrequency, maxFrequency);
+	lanes_t semitone = lanes::fmin(lanes::fmax(frequencyToSemitone(f) + fcv, minFrequencySemitone), maxFrequencySemitone);
+	_semitones[b] += lanes::fmin(lanes::fmax(semitone - _semitones[b], -_frequencyDelta), _frequencyDelta);
+	_frequencies[b] = referenceFrequency * lanes::exp((_semitones[b] - referenceSemitone) * logTwelfthRootTwo);
+
+	lanes_t bandwidth = MultimodeFilter::minQbw;
+	if (band.mode == MultimodeFilter::BANDPASS_MODE) {
+		bandwidth = clamp(band.bandwidthParam->getValue(), 0.0f, 1.0f);
+		if (band.bandwidthInput && band.bandwidthInput->isConnected()) {
+			bandwidth *= lanes::fmin(lanes::fmax(getPolyLanes(*band.bandwidthInput, c) * 0.1f, 0.0f), 1.0f);
 		}
 		bandwidth = MultimodeFilter::minQbw + bandwidth * (MultimodeFilter::maxQbw - MultimodeFilter::minQbw);
 	}
-	_filter->setParams(
-		_sampleRate,
-		MultimodeFilter::BUTTERWORTH_TYPE,
-		_poles,
-		_mode,
-		frequency,
-		bandwidth,
-		MultimodeFilter::PITCH_BANDWIDTH_MODE
-	);
-}
-
-void PEQChannel::next(float sample) {
-	out = _amplifier.next(_filter->next(sample));
-	rms = _rms.next(out / 5.0f);
-}
-
-
- void PEQEngine::setFrequencyMode(bool full) {
-	 for (int i = 0; i < _n; ++i) {
-		 _channels[i]->setFrequencyMode(full);
-	 }
- }
-
- void PEQEngine::setSampleRate(float sr) {
-	for (int i = 0; i < _n; ++i) {
-		_channels[i]->setSampleRate(sr);
+	_bandwidths[b] = bandwidth;
+
+	bool redesigned = false;
+	for (int l = 0; l < laneWidth && c + l < _channels; ++l) {
+		redesigned |= _filters.setParams(
+			b,
+			l,
+			_sampleRate,
+			MultimodeFilter::BUTTERWORTH_TYPE,
+			band.poles,
+			band.mode,
+			lanes::get(_frequencies[b], l),
+			lanes::get(_bandwidths[b], l),
+			MultimodeFilter::PITCH_BANDWIDTH_MODE
+		);
+	}
+	if (redesigned) {
+		_designsChanged[g] |= 1 << i;
 	}
 }
 
-void PEQEngine::modulate() {
-	for (int i = 0; i < _n; ++i) {
-		_channels[i]->modulate();
+lanes_t PEQEngine::next(int g, const lanes_t& sample) {
+	const float r = 0.999f; // as DCBlocker's.
+	lanes_t out = 0.0f;
+	for (int i = 0, b = g * _n; i < _n; ++i, ++b) {
+		lanes_t o = _levels[b] * _filters.next(b, sample);
+		_outs[b] = o;
+		out += o;
+
+		_dcLastOuts[b] = o - _dcLastIns[b] + r * _dcLastOuts[b];
+		_dcLastIns[b] = o;
+		_rectified[i] += _activeLanes[g] * lanes::abs(_dcLastOuts[b]);
 	}
+	return _saturator.next(out);
 }
 
-float PEQEngine::next(float sample, float* rmsSums) {
-	bandwidth = _channels[1]->bandwidth; // take from any bandpass-only channel.
-	float out = 0.0f;
+// on a 5V scale, as each channel's RMS was.
+void PEQEngine::nextRms(float* rmsSums) {
 	for (int i = 0; i < _n; ++i) {
-		PEQChannel& c = *_channels[i];
-		c.next(sample);
-		out += outs[i] = c.out;
-		frequencies[i] = c.frequency;
-		rmsSums[i] += c.rms;
+		rmsSums[i] += _bands[i].rms.next(0.2f * lanes::sum(_rectified[i]));
+		_rectified[i] = 0.0f;
 	}
-	return _saturator.next(out);
 }
 
 
@@ -120,8 +185,8 @@ float PEQXFBase::scaleEF(float ef, float frequency, float bandwidth) {
 	bandwidth = (bandwidth - MultimodeFilter::minQbw) / (MultimodeFilter::maxQbw - MultimodeFilter::minQbw);
 	bandwidth *= MultimodeFilter::maxBWPitch;
 	float minf = std::max(0.0f, powf(2.0f, -bandwidth) * frequency);
-	float maxf = std::min(PEQChannel::maxFrequency, powf(2.0f, bandwidth) * frequency);
-	float scale = (2.0f * (maxf - minf)) / PEQChannel::maxFrequency;
+	float maxf = std::min(PEQEngine::maxFrequency, powf(2.0f, bandwidth) * frequency);
+	float scale = (2.0f * (maxf - minf)) / PEQEngine::maxFrequency;
 	scale = 1.0f / scale;
 	scale = sqrtf(scale); // FIXME: someday prove this is correct.
 	return 2.0f * scale * ef;
@@ -11,108 +11,69 @@ using namespace bogaudio::dsp;
 
 namespace bogaudio {
 
-struct PEQChannel {
+// The bands of PEQ, PEQ6 or PEQ14, for all of the module's channels, run
+// laneWidth channels at a time.  Band state is kept flat, by lane group and
+// then band, a field to an array (the filters' in one MultimodeBankLanes).
+// modulate() works out every band's level, frequency and bandwidth for a
+// group of channels together; the filter of a band and channel is redesigned
+// only when its frequency or bandwidth has moved.  The edge bands may be set
+// to lowpass and highpass (12 poles); otherwise bands are 4-pole bandpasses.
+struct PEQEngine {
 	static const float maxDecibels;
 	static const float minDecibels;
 	static constexpr float maxFrequency = 20000.0f;
 	static constexpr float minFrequency = MultimodeFilter::minFrequency;
 	static const float maxFrequencySemitone;
 	static const float minFrequencySemitone;
+	static constexpr int maxBands = 14;
+	static constexpr int maxGroups = BGModule::maxChannels / laneWidth;
+	static constexpr float rmsWindowMS = 15.0f;
+
+	// a band's controls, its filter mode, and the running average of its
+	// rectified output summed over channels, which is the sum of what each
+	// channel's RMS would be.
+	struct Band {
+		Param* levelParam = NULL;
+		Param* frequencyParam = NULL;
+		Param* frequencyCv1Param = NULL;
+		Param* frequencyCv2Param = NULL;
+		Param* bandwidthParam = NULL;
+		Input* levelInput = NULL;
+		Input* frequency1Input = NULL;
+		Input* frequency2Input = NULL;
+		Input* bandwidthInput = NULL;
+		MultimodeFilter::Mode mode = MultimodeFilter::BANDPASS_MODE;
+		int poles = 4;
+		RunningAverage rms;
+
+		Band() : rms(1000.0f, 1.0f, rmsWindowMS) {}
+	};
 
-	float _sampleRate;
-	Amplifier _amplifier;
-	bogaudio::dsp::SlewLimiter _levelSL;
-	MultimodeFilter* _filter = NULL;
-	bogaudio::dsp::SlewLimiter _frequencySL;
-	bogaudio::dsp::SlewLimiter _bandwidthSL;
-	RootMeanSquare _rms;
-
-	int _c;
-	MultimodeFilter::Mode _mode;
-	bool _fullFrequencyMode = true;
-	int _poles;
-	Param& _levelParam;
-	Param& _frequencyParam;
-	Param& _frequencyCv1Param;
-	Param* _frequencyCv2Param;
-	Param& _bandwidthParam;
-	Input& _levelInput;
-	Input& _frequency1Input;
-	Input& _frequency2Input;
-	Input* _bandwidthInput;
-
-	float out = 0.0f;
-	float rms = 0.0f;
-	float frequency = 0.0f;
-	float bandwidth = 0.0f;
-
-	PEQChannel(
-		MultimodeFilter* filter,
-		int polyChannel,
-		Param& levelParam,
-		Param& frequencyParam,
-		Param& frequencyCv1Param,
-		Param* frequencyCv2Param,
-		Param& bandwidthParam,
-		Input& levelCvInput,
-		Input& frequencyCv1Input,
-		Input& frequencyCv2Input,
-		Input* bandwidthCvInput,
-		float sampleRate = 1000.0f
-	)
-	: _filter(filter)
-	, _c(polyChannel)
-	, _levelParam(levelParam)
-	, _frequencyParam(frequencyParam)
-	, _frequencyCv1Param(frequencyCv1Param)
-	, _frequencyCv2Param(frequencyCv2Param)
-	, _bandwidthParam(bandwidthParam)
-	, _levelInput(levelCvInput)
-	, _frequency1Input(frequencyCv1Input)
-	, _frequency2Input(frequencyCv2Input)
-	, _bandwidthInput(bandwidthCvInput)
-	{
-		setSampleRate(sampleRate);
-		setFilterMode(MultimodeFilter::BANDPASS_MODE);
-		_rms.setSensitivity(0.05f);
-	}
-	virtual ~PEQChannel() {
-		delete _filter;
-	}
-
-	void setSampleRate(float sampleRate);
-	void setFilterMode(MultimodeFilter::Mode mode);
-	inline void setFrequencyMode(bool full) { _fullFrequencyMode = full; }
-	void modulate();
-	void next(float sample); // outputs on members out, rms.
-};
-
-struct PEQEngine {
 	int _n;
-	PEQChannel** _channels;
+	int _channels = 0;
+	float _sampleRate = 1000.0f;
+	bool _fullFrequencyMode = true;
+	float _levelDelta = 1.0f;
+	float _frequencyDelta = 1.0f;
+	Band _bands[maxBands];
+	MultimodeBankLanes _filters;
+	lanes_t _activeLanes[maxGroups] {};
+	uint32_t _designsChanged[maxGroups] {}; // by group, a bit per band redesigned at the last modulate().
+	lanes_t _levelDbs[maxGroups * maxBands] {};
+	lanes_t _levels[maxGroups * maxBands] {};
+	lanes_t _semitones[maxGroups * maxBands] {};
+	lanes_t _frequencies[maxGroups * maxBands] {};
+	lanes_t _bandwidths[maxGroups * maxBands] {};
+	lanes_t _dcLastIns[maxGroups * maxBands] {};
+	lanes_t _dcLastOuts[maxGroups * maxBands] {};
+	lanes_t _outs[maxGroups * maxBands] {};
+	lanes_t _rectified[maxBands] {};
 	Saturator _saturator;
 
-	float* outs = NULL;
-	float* frequencies = NULL;
-	float bandwidth = 0.0f;
-
-	PEQEngine(int channels) : _n(channels) {
-		_channels = new PEQChannel*[_n] {};
-		outs = new float[_n] {};
-		frequencies = new float[_n] {};
-	}
-	~PEQEngine() {
-		for (int i = 0; i < _n; ++i) {
-			delete _channels[i];
-		}
-		delete[] _channels;
-		delete[] outs;
-		delete[] frequencies;
-	}
-
-	inline void configChannel(
+	PEQEngine(int bands);
+
+	void configBand(
 		int i,
-		int polyChannel,
 		Param& levelParam,
 		Param& frequencyParam,
 		Param& frequencyCv1Param,
@@ -122,27 +83,27 @@ struct PEQEngine {
 		Input& frequencyCv1Input,
 		Input& frequencyCv2Input,
 		Input* bandwidthCvInput
-	) {
-		_channels[i] = new PEQChannel(
-			i == 0 || i == _n - 1 ? (MultimodeFilter*)(new MultimodeFilter8()) : (MultimodeFilter*)(new MultimodeFilter4()),
-			polyChannel,
-			levelParam,
-			frequencyParam,
-			frequencyCv1Param,
-			frequencyCv2Param,
-			bandwidthParam,
-			levelCvInput,
-			frequencyCv1Input,
-			frequencyCv2Input,
-			bandwidthCvInput
-		);
-	}
-	inline void setLowFilterMode(MultimodeFilter::Mode mode) { _channels[0]->setFilterMode(mode); }
-	inline void setHighFilterMode(MultimodeFilter::Mode mode) { _channels[_n - 1]->setFilterMode(mode); }
-	void setFrequencyMode(bool full);
+	);
+	inline void setLowFilterMode(MultimodeFilter::Mode mode) { setFilterMode(0, mode); }
+	inline void setHighFilterMode(MultimodeFilter::Mode mode) { setFilterMode(_n - 1, mode); }
+	void setFilterMode(int i, MultimodeFilter::Mode mode);
+	inline void setFrequencyMode(bool full) { _fullFrequencyMode = full; }
 	void setSampleRate(float sr);
-	void modulate();
-	float next(float sample, float* rmsSums);
+	void reset(int c);
+	void modulate(int channels);
+	void modulateBand(int g, int i);
+
+	// runs the bands of group g; returns the saturated mix, with each band's
+	// output on out().  nextRms() then follows up for all groups, adding each
+	// band's RMS, summed over channels, to rmsSums.
+	lanes_t next(int g, const lanes_t& sample);
+	void nextRms(float* rmsSums);
+
+	inline const lanes_t& out(int g, int i) { return _outs[g * _n + i]; }
+	inline const lanes_t& frequency(int g, int i) { return _frequencies[g * _n + i]; }
+	inline const lanes_t& bandwidth(int g) { return _bandwidths[g * _n + 1]; } // take from any bandpass-only band.
+	inline void filterDesign(int g, int i, MultimodeBankLanes::Design& design) const { _filters.getDesign(g * _n + i, design); }
+	inline uint32_t designsChanged(int g) const { return _designsChanged[g]; }
 };
 
 struct PEQXFBase : FollowerBase {
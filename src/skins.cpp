@@ -3,29 +3,21 @@
 #include "bogaudio.hpp"
 #include <unistd.h>
 #include <fstream>
+#include <sstream>
 #include <cstdio>
 
 Skins globalSkins;
 std::mutex globalSkinsLock;
 
+// Loaded once, under the lock; after that, reads don't lock.
 Skins& Skins::skins() {
-	// Hacky/blind attempt to fix https://github.com/bogaudio/BogaudioModules/issues/195.
-	// Replace this totally correct scoped static instance with a global,
-	// on the chance it will be handled more simply by the compiler.
-	// static Skins instance;
-	// std::lock_guard<std::mutex> lock(instance._instanceLock);
-	// if (!instance._loaded) {
-	// 	instance.loadSkins();
-	// 	instance.loadCssValues();
-	// 	instance._loaded = true;
-	// }
-	// return instance;
-
-	std::lock_guard<std::mutex> lock(globalSkins._instanceLock);
-	if (!globalSkins._loaded) {
-		globalSkins.loadSkins();
-		globalSkins.loadCssValues();
-		globalSkins._loaded = true;
+	if (!globalSkins._loaded.load(std::memory_order_acquire)) {
+		std::lock_guard<std::mutex> lock(globalSkins._instanceLock);
+		if (!globalSkins._loaded.load(std::memory_order_relaxed)) {
+			globalSkins.loadSkins();
+			globalSkins.loadCssValues();
+			globalSkins._loaded.store(true, std::memory_order_release);
+		}
 	}
 	return globalSkins;
 }
@@ -111,6 +103,252 @@ NVGcolor Skins::cssColorToNVGColor(const char* color, const NVGcolor& ifError) {
 	return ifError;
 }
 
+std::shared_ptr<rack::window::Svg> Skins::panelSvg(const std::string& slug, std::string skinKey) {
+	if (skinKey == "default") {
+		skinKey = defaultKey();
+	}
+	std::string path = rack::asset::plugin(pluginInstance, "res/" + slug + ".svg");
+	if (skinKey == "light" || !validKey(skinKey)) {
+		return APP->window->loadSvg(path);
+	}
+
+	std::lock_guard<std::mutex> lock(_panelSvgsLock);
+	std::string key = slug + "-" + skinKey;
+	auto cached = _panelSvgs.find(key);
+	if (cached != _panelSvgs.end()) {
+		return cached->second;
+	}
+
+	std::ifstream f(path);
+	std::stringstream ss;
+	ss << f.rdbuf();
+	auto svg = std::make_shared<rack::window::Svg>();
+	try {
+		svg->loadString(recolorPanel(ss.str(), skinKey));
+	}
+	catch (rack::Exception& e) {
+		WARN("Bogaudio: error skinning panel %s as %s: %s\n", path.c_str(), skinKey.c_str(), e.what());
+		return APP->window->loadSvg(path);
+	}
+	_panelSvgs.insert(panel_svgs_map::value_type(key, svg));
+	return svg;
+}
+
+// "#abc" or "#aabbcc", in either case, to "#aabbcc"; anything else to "".
+static std::string normalizeCssColor(const std::string& color) {
+	size_t b = color.find_first_not_of(" \t\n");
+	size_t e = color.find_last_not_of(" \t\n");
+	if (b == std::string::npos || color[b] != '#') {
+		return "";
+	}
+	std::string c = color.substr(b, e + 1 - b);
+	if (c.size() == 4) {
+		c = std::string("#") + c[1] + c[1] + c[2] + c[2] + c[3] + c[3];
+	}
+	if (c.size() != 7) {
+		return "";
+	}
+	for (size_t i = 1; i < c.size(); ++i) {
+		if (!isxdigit(c[i])) {
+			return "";
+		}
+		c[i] = tolower(c[i]);
+	}
+	return c;
+}
+
+// Panels are rendered to res/ in the light skin only; the other skins are
+// made from those here.  Each fill and stroke color is looked up in the light
+// skin's values, by the element's class (or its nearest classed ancestor's)
+// and the property, else by the property alone (the rules on bare text and
+// paths); if it's the light value, the same key's value for the skin replaces
+// it.  Colors that didn't come from a skin rule are left alone.  The renders
+// are flat -- Inkscape has inlined all styles -- so a scan of the tags and
+// their attributes will do, rather than an XML parser.
+std::string Skins::recolorPanel(const std::string& svg, const std::string& skinKey) const {
+	auto light = _skinCssValues.find("light");
+	auto skin = _skinCssValues.find(skinKey);
+	if (light == _skinCssValues.end() || skin == _skinCssValues.end()) {
+		return svg;
+	}
+
+	auto recolor = [&](const std::string& classes, const std::string& property, const std::string& value) {
+		std::string color = normalizeCssColor(value);
+		if (color.empty()) {
+			return value;
+		}
+		auto replacement = [&](const std::string& key) {
+			auto l = light->second.find(key);
+			auto s = skin->second.find(key);
+			if (l == light->second.end() || s == skin->second.end() || normalizeCssColor(l->second) != color) {
+				return std::string();
+			}
+			return normalizeCssColor(s->second);
+		};
+		std::istringstream cs(classes);
+		std::string c;
+		while (cs >> c) {
+			std::string r = replacement(c + "." + property);
+			if (!r.empty()) {
+				return r;
+			}
+		}
+		std::string r = replacement(property);
+		return r.empty() ? value : r;
+	};
+
+	auto recolorStyle = [&](const std::string& classes, const std::string& style) {
+		std::string out;
+		size_t p = 0;
+		while (p <= style.size()) {
+			size_t end = style.find(';', p);
+			if (end == std::string::npos) {
+				end = style.size();
+			}
+			std::string declaration = style.substr(p, end - p);
+			size_t colon = declaration.find(':');
+			if (colon != std::string::npos) {
+				std::string property = declaration.substr(0, colon);
+				property.erase(0, property.find_first_not_of(" \t\n"));
+				property.erase(property.find_last_not_of(" \t\n") + 1);
+				if (property == "fill" || property == "stroke") {
+					declaration = declaration.substr(0, colon + 1) + recolor(classes, property, declaration.substr(colon + 1));
+				}
+			}
+			out += declaration;
+			if (end < style.size()) {
+				out += ';';
+			}
+			p = end + 1;
+		}
+		return out;
+	};
+
+	struct Attribute {
+		std::string name;
+		size_t start;
+		size_t end;
+	};
+
+	std::string out;
+	out.reserve(svg.size());
+	std::vector<std::string> classes; // for each open element.
+	std::vector<Attribute> attributes;
+	size_t i = 0;
+	while (i < svg.size()) {
+		size_t lt = svg.find('<', i);
+		if (lt == std::string::npos) {
+			break;
+		}
+		out.append(svg, i, lt - i);
+		i = lt;
+
+		if (svg.compare(lt, 4, "<!--") == 0 || svg.compare(lt, 9, "<![CDATA[") == 0) {
+			size_t end = svg.find(svg[lt + 2] == '-' ? "-->" : "]]>", lt);
+			if (end == std::string::npos) {
+				break;
+			}
+			out.append(svg, lt, end + 3 - lt);
+			i = end + 3;
+			continue;
+		}
+
+		size_t gt = lt + 1;
+		for (char quote = 0; gt < svg.size(); ++gt) {
+			char ch = svg[gt];
+			if (quote) {
+				if (ch == quote) {
+					quote = 0;
+				}
+			}
+			else if (ch == '"' || ch == '\'') {
+				quote = ch;
+			}
+			else if (ch == '>') {
+				break;
+			}
+		}
+		if (gt >= svg.size()) {
+			break;
+		}
+
+		char kind = svg[lt + 1];
+		if (kind == '/') {
+			if (!classes.empty()) {
+				classes.pop_back();
+			}
+			out.append(svg, lt, gt + 1 - lt);
+		}
+		else if (kind == '?' || kind == '!') {
+			out.append(svg, lt, gt + 1 - lt);
+		}
+		else {
+			attributes.clear();
+			size_t p = lt + 1;
+			while (p < gt && !isspace(svg[p]) && svg[p] != '/') {
+				++p;
+			}
+			while (p < gt) {
+				while (p < gt && (isspace(svg[p]) || svg[p] == '/')) {
+					++p;
+				}
+				size_t nameStart = p;
+				while (p < gt && svg[p] != '=' && svg[p] != '/' && !isspace(svg[p])) {
+					++p;
+				}
+				std::string name = svg.substr(nameStart, p - nameStart);
+				while (p < gt && isspace(svg[p])) {
+					++p;
+				}
+				if (p >= gt || svg[p] != '=') {
+					continue;
+				}
+				++p;
+				while (p < gt && isspace(svg[p])) {
+					++p;
+				}
+				if (p >= gt || (svg[p] != '"' && svg[p] != '\'')) {
+					continue;
+				}
+				size_t end = svg.find(svg[p], p + 1);
+				attributes.push_back(Attribute { name, p + 1, end });
+				p = end + 1;
+			}
+
+			std::string cls = classes.empty() ? "" : classes.back();
+			for (const Attribute& a : attributes) {
+				if (a.name == "class" && a.end > a.start) {
+					cls = svg.substr(a.start, a.end - a.start);
+				}
+			}
+			size_t copied = lt;
+			for (const Attribute& a : attributes) {
+				std::string value = svg.substr(a.start, a.end - a.start);
+				std::string recolored = value;
+				if (a.name == "fill" || a.name == "stroke") {
+					recolored = recolor(cls, a.name, value);
+				}
+				else if (a.name == "style") {
+					recolored = recolorStyle(cls, value);
+				}
+				if (recolored != value) {
+					out.append(svg, copied, a.start - copied);
+					out += recolored;
+					copied = a.end;
+				}
+			}
+			out.append(svg, copied, gt + 1 - copied);
+
+			if (svg[gt - 1] != '/') {
+				classes.push_back(cls);
+			}
+		}
+		i = gt + 1;
+	}
+	out.append(svg, i, std::string::npos);
+	return out;
+}
+
 void Skins::setDefaultSkin(std::string skinKey) {
 	if (skinKey == "default") {
 		skinKey = "light";
@@ -135,23 +373,25 @@ void Skins::setDefaultSkin(std::string skinKey) {
 	}
 	else {
 		_default = skinKey;
+		_defaultSkinGeneration.fetch_add(1, std::memory_order_release);
 		INFO("Bogaudio: skin information written to %s\n", path.c_str());
-
-		std::lock_guard<std::mutex> lock(_defaultSkinListenersLock);
-		for (auto listener : _defaultSkinListeners) {
-			listener->defaultSkinChanged(_default);
-		}
 	}
 }
 
-void Skins::registerDefaultSkinChangeListener(DefaultSkinChangeListener* listener) {
-	std::lock_guard<std::mutex> lock(_defaultSkinListenersLock);
-	_defaultSkinListeners.insert(listener);
-}
-
-void Skins::deregisterDefaultSkinChangeListener(DefaultSkinChangeListener* listener) {
-	std::lock_guard<std::mutex> lock(_defaultSkinListenersLock);
-	_defaultSkinListeners.erase(listener);
+// Widgets pick up a default skin change from their step(), as they see
+// defaultSkinGeneration() move; they claim a change here first, so that a big
+// patch reskins a batch of modules per UI frame rather than all in one.
+bool Skins::claimDefaultSkinChange() {
+	double frameTime = APP->window->getFrameTime();
+	if (frameTime != _defaultSkinChangesFrameTime) {
+		_defaultSkinChangesFrameTime = frameTime;
+		_defaultSkinChangesThisFrame = 0;
+	}
+	if (_defaultSkinChangesThisFrame >= maxDefaultSkinChangesPerFrame) {
+		return false;
+	}
+	++_defaultSkinChangesThisFrame;
+	return true;
 }
 
 void Skins::loadSkins() {
@@ -1,16 +1,13 @@
 #pragma once
 
 #include "rack.hpp"
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
-struct DefaultSkinChangeListener {
-	virtual void defaultSkinChanged(const std::string& skin) = 0;
-};
-
 struct Skin {
 	std::string key;
 	std::string display;
@@ -22,16 +19,21 @@ class Skins {
 private:
 	typedef std::unordered_map<std::string, std::string> css_values_map;
 	typedef std::unordered_map<std::string, css_values_map> skin_css_values_map;
-	typedef std::unordered_set<DefaultSkinChangeListener*> default_skin_listeners_set;
+	typedef std::unordered_map<std::string, std::shared_ptr<rack::window::Svg>> panel_svgs_map;
 	std::vector<Skin> _available;
 	std::string _default;
 	skin_css_values_map _skinCssValues;
-	default_skin_listeners_set _defaultSkinListeners;
-	std::mutex _defaultSkinListenersLock;
-	bool _loaded = false;
+	std::atomic<int> _defaultSkinGeneration { 0 };
+	double _defaultSkinChangesFrameTime = -1.0;
+	int _defaultSkinChangesThisFrame = 0;
+	panel_svgs_map _panelSvgs;
+	std::mutex _panelSvgsLock;
+	std::atomic<bool> _loaded { false };
 	std::mutex _instanceLock;
 
 public:
+	static constexpr int maxDefaultSkinChangesPerFrame = 16;
+
 	Skins() {}
 	Skins(const Skins&) = delete;
 	void operator=(const Skins&) = delete;
@@ -42,12 +44,14 @@ public:
 	bool validKey(const std::string& key) const;
 	const char* skinCssValue(const std::string& skinKey, const std::string& valueKey) const;
 	static NVGcolor cssColorToNVGColor(const char* color, const NVGcolor& ifError);
+	std::shared_ptr<rack::window::Svg> panelSvg(const std::string& slug, std::string skinKey);
 
 	void setDefaultSkin(std::string skinKey);
-	void registerDefaultSkinChangeListener(DefaultSkinChangeListener* listener);
-	void deregisterDefaultSkinChangeListener(DefaultSkinChangeListener* listener);
+	inline int defaultSkinGeneration() const { return _defaultSkinGeneration.load(std::memory_order_acquire); }
+	bool claimDefaultSkinChange();
 
 private:
 	void loadSkins();
 	void loadCssValues();
+	std::string recolorPanel(const std::string& svg, const std::string& skinKey) const;
 };
@@ -1,6 +1,8 @@
 
 #include "slew_common.hpp"
 
+constexpr float RiseFallShapedSlewLimiter::minShape;
+
 float RiseFallShapedSlewLimiter::timeMS(int c, Param& param, Input* input, float maxMS) {
 	float time = clamp(param.getValue(), 0.0f, 1.0f);
 	if (input && input->isConnected()) {
@@ -23,7 +25,7 @@ float RiseFallShapedSlewLimiter::shape(int c, Param& param, bool invert, Input*
 	}
 	if (shape < 0.0) {
 		shape = 1.0f + shape;
-		shape = _rise.minShape + shape * (1.0f - _rise.minShape);
+		shape = minShape + shape * (1.0f - minShape);
 	}
 	else {
 		shape += 1.0f;
@@ -59,6 +61,33 @@ void RiseFallShapedSlewLimiter::modulate(
 	);
 }
 
+void RiseFallShapedSlewLimiter::modulate(
+	RiseFallShapedSlewLimiterLanes& slew,
+	float sampleRate,
+	Param& riseParam,
+	Input* riseInput,
+	float riseMaxMS,
+	Param& riseShapeParam,
+	Param& fallParam,
+	Input* fallInput,
+	float fallMaxMS,
+	Param& fallShapeParam,
+	int c,
+	bool invertRiseShape,
+	Input* shapeCV,
+	ShapeCVMode riseShapeMode,
+	ShapeCVMode fallShapeMode
+) {
+	slew.setParams(
+		c % laneWidth,
+		sampleRate,
+		timeMS(c, riseParam, riseInput, riseMaxMS),
+		shape(c, riseShapeParam, invertRiseShape, shapeCV, riseShapeMode),
+		timeMS(c, fallParam, fallInput, fallMaxMS),
+		shape(c, fallShapeParam, false, shapeCV, fallShapeMode)
+	);
+}
+
 float RiseFallShapedSlewLimiter::next(float sample) {
 	if (sample > _last) {
 		if (!_rising) {
@@ -12,13 +12,15 @@ struct RiseFallShapedSlewLimiter {
 		INVERTED_SCVM
 	};
 
+	static constexpr float minShape = 0.1f; // as ShapedSlewLimiter's.
+
 	bool _rising = true;
 	float _last = 0.0f;
 	ShapedSlewLimiter _rise;
 	ShapedSlewLimiter _fall;
 
-	float timeMS(int c, Param& param, Input* input, float maxMS);
-	float shape(int c, Param& param, bool invert = false, Input* cv = NULL, ShapeCVMode mode = OFF_SCVM);
+	static float timeMS(int c, Param& param, Input* input, float maxMS);
+	static float shape(int c, Param& param, bool invert = false, Input* cv = NULL, ShapeCVMode mode = OFF_SCVM);
 	void modulate(
 		float sampleRate,
 		Param& riseParam,
@@ -36,4 +38,23 @@ struct RiseFallShapedSlewLimiter {
 		ShapeCVMode fallShapeMode = OFF_SCVM
 	);
 	float next(float sample);
+
+	// as above, for channel c's lane of a RiseFallShapedSlewLimiterLanes.
+	static void modulate(
+		RiseFallShapedSlewLimiterLanes& slew,
+		float sampleRate,
+		Param& riseParam,
+		Input* riseInput,
+		float riseMaxMS,
+		Param& riseShapeParam,
+		Param& fallParam,
+		Input* fallInput,
+		float fallMaxMS,
+		Param& fallShapeParam,
+		int c,
+		bool invertRiseShape = false,
+		Input* shapeCV = NULL,
+		ShapeCVMode riseShapeMode = OFF_SCVM,
+		ShapeCVMode fallShapeMode = OFF_SCVM
+	);
 };
@@ -1,14 +1,25 @@
 
 #include "widgets.hpp"
 #include "skins.hpp"
+#include "rack_overrides.hpp"
 #include "dsp/signal.hpp"
 
 using namespace bogaudio;
 using namespace bogaudio::dsp;
 
+void DisplayWidget::StaticLayer::draw(const DrawArgs& args) {
+	_display->drawStatic(args, _screenshot, _lit);
+}
+
 DisplayWidget::DisplayWidget(Module* module) : _module(module) {
 }
 
+DisplayWidget::~DisplayWidget() {
+	if (_staticFb) {
+		delete _staticFb;
+	}
+}
+
 bool DisplayWidget::isLit() {
 	return _module && !_module->isBypassed();
 }
@@ -17,15 +28,53 @@ bool DisplayWidget::isScreenshot() {
 	return !_module;
 }
 
+void DisplayWidget::step() {
+	LightEmittingWidget<OpaqueWidget>::step();
+	if (_staticFb) {
+		_staticFb->step();
+	}
+}
+
 void DisplayWidget::draw(const DrawArgs& args) {
 	if (!isLit()) {
-		drawOnce(args, isScreenshot(), false);
+		drawLayers(args, isScreenshot(), false);
 	}
 }
 
 void DisplayWidget::drawLit(const DrawArgs& args) {
 	if (isLit()) {
-		drawOnce(args, false, true);
+		drawLayers(args, false, true);
+	}
+}
+
+void DisplayWidget::drawLayers(const DrawArgs& args, bool screenshot, bool lit) {
+	if (_cacheStatic) {
+		if (!_staticFb) {
+			_staticFb = new widget::FramebufferWidget();
+			_staticLayer = new StaticLayer(this);
+			_staticFb->addChild(_staticLayer);
+		}
+		float zoom = getZoom();
+		if (
+			!_staticFb->box.size.equals(box.size) ||
+			_staticLayer->_screenshot != screenshot ||
+			_staticLayer->_lit != lit ||
+			_staticZoom != zoom
+		) {
+			_staticFb->box.size = _staticLayer->box.size = box.size;
+			_staticLayer->_screenshot = screenshot;
+			_staticLayer->_lit = lit;
+			_staticZoom = zoom;
+			_staticFb->dirty = true;
+		}
+		_staticFb->draw(args);
+	}
+	drawOnce(args, screenshot, lit);
+}
+
+void DisplayWidget::invalidateStatic() {
+	if (_staticFb) {
+		_staticFb->dirty = true;
 	}
 }
 
@@ -44,12 +93,29 @@ std::string SkinnableWidget::skinSVG(const std::string& base, const std::string&
 	return svg;
 }
 
+// Resolves "default", and notes the skin as shown; false if it already was,
+// and the widget can skip reloading it.
+bool SkinnableWidget::showSkin(const std::string& skin) {
+	std::string s = skin;
+	if (s == "default") {
+		s = Skins::skins().defaultKey();
+	}
+	if (s == _shownSkin) {
+		return false;
+	}
+	_shownSkin = s;
+	return true;
+}
+
 
 Screw::Screw() {
 	skinChanged("default");
 }
 
 void Screw::skinChanged(const std::string& skin) {
+	if (!showSkin(skin)) {
+		return;
+	}
 	const char* svg = "res/ComponentLibrary/ScrewSilver.svg";
 	const char* backgroundFill = Skins::skins().skinCssValue(skin, "background-fill");
 	if (backgroundFill) {
@@ -65,7 +131,7 @@ void Screw::skinChanged(const std::string& skin) {
 
 BGKnob::BGKnob(const char* svgBase, int dim) {
 	_svgBase = svgBase;
-	setSvg(APP->window->loadSvg(asset::plugin(pluginInstance, skinSVG(_svgBase.c_str()).c_str())));
+	skinChanged("default");
 	box.size = Vec(dim, dim);
 	shadow->blurRadius = 2.0;
 	// k->shadow->opacity = 0.15;
@@ -78,6 +144,9 @@ void BGKnob::redraw() {
 }
 
 void BGKnob::skinChanged(const std::string& skin) {
+	if (!showSkin(skin)) {
+		return;
+	}
 	setSvg(APP->window->loadSvg(asset::plugin(pluginInstance, skinSVG(_svgBase.c_str(), skin).c_str())));
 	fb->dirty = true;
 }
@@ -274,6 +343,9 @@ void IndicatorKnob::drawLit(const DrawArgs& args) {
 }
 
 void IndicatorKnob::skinChanged(const std::string& skin) {
+	if (!showSkin(skin)) {
+		return;
+	}
 	const Skins& skins = Skins::skins();
 	const char* knobRim = skins.skinCssValue(skin, "knob-rim");
 	if (knobRim) {
@@ -288,13 +360,16 @@ void IndicatorKnob::skinChanged(const std::string& skin) {
 
 
 Port24::Port24() {
-	setSvg(APP->window->loadSvg(asset::plugin(pluginInstance, skinSVG("port").c_str())));
+	skinChanged("default");
 	box.size = Vec(24, 24);
 	shadow->blurRadius = 1.0;
 	shadow->box.pos = Vec(0.0, 1.5);
 }
 
 void Port24::skinChanged(const std::string& skin) {
+	if (!showSkin(skin)) {
+		return;
+	}
 	setSvg(APP->window->loadSvg(asset::plugin(pluginInstance, skinSVG("port", skin).c_str())));
 	fb->dirty = true;
 }
@@ -25,21 +25,48 @@ struct LightEmittingWidget : BASE {
 	virtual void drawLit(const typename BASE::DrawArgs& args) {}
 };
 
+// Displays draw in drawOnce, every frame.  A display may also set
+// _cacheStatic and move what rarely changes (background, axes, labels) to
+// drawStatic; that's rendered to a framebuffer, drawn under drawOnce, and
+// rerendered only when the display is resized or rezoomed, goes lit or unlit,
+// or calls invalidateStatic() (on a change of range, say).
 struct DisplayWidget : LightEmittingWidget<OpaqueWidget> {
+	struct StaticLayer : Widget {
+		DisplayWidget* _display;
+		bool _screenshot = false;
+		bool _lit = false;
+
+		StaticLayer(DisplayWidget* display) : _display(display) {}
+
+		void draw(const DrawArgs& args) override;
+	};
+
 	Module* _module = NULL;
+	bool _cacheStatic = false;
+	widget::FramebufferWidget* _staticFb = NULL; // not a child: it's drawn in whichever layer the display is.
+	StaticLayer* _staticLayer = NULL;
+	float _staticZoom = 0.0f;
 
 	DisplayWidget(Module* module);
+	virtual ~DisplayWidget();
 
 	bool isLit() override;
 	virtual bool isScreenshot();
+	void step() override;
 	void draw(const DrawArgs& args) override;
 	void drawLit(const DrawArgs& args) override;
+	void drawLayers(const DrawArgs& args, bool screenshot, bool lit);
+	void invalidateStatic();
+	virtual void drawStatic(const DrawArgs& args, bool screenshot, bool lit) {}
 	virtual void drawOnce(const DrawArgs& args, bool screenshot, bool lit) = 0;
 };
 
 struct SkinnableWidget : SkinChangeListener {
+	std::string _shownSkin;
+
 	void skinChanged(const std::string& skin) override {}
 	std::string skinSVG(const std::string& base, const std::string& skin = "default");
+	bool showSkin(const std::string& skin);
 };
 
 struct Screw : SvgScrew, SkinnableWidget {
@@ -0,0 +1,506 @@
+// Offline renderer for chains of src/dsp primitives, for batch sound design
+// and for timing DSP outside Rack.  Usage:
+//
+//   render [-j threads] description.json
+//
+// The description is a JSON object:
+//
+//   {
+//     "sample_rate": 48000,  // defaults for every job
+//     "seconds": 2.0,
+//     "seed": 1,
+//     "jobs": [
+//       {
+//         "output": "saw.wav",  // .wav or .csv
+//         "bits": 16,           // WAV only: 16, 24, or 32 (float)
+//         "scale": 0.2,         // output = scale * voltage; 0.2 maps 5V to full scale
+//         "voices": 1,          // independent copies of the chain, one output channel each
+//         "sample_rate": 96000, // optional per-job overrides
+//         "chain": [
+//           { "type": "saw", "frequency": 110 },
+//           { "type": "lowpass", "cutoff": 800, "q": 0.7 },
+//           { "type": "saturator" }
+//         ]
+//       }
+//     ]
+//   }
+//
+// Each node of a chain takes the previous node's output (0 for the first);
+// sources add their output to it, so consecutive sources are mixed.  Noise
+// seeding is fixed per job: all chains are built up front on the main thread,
+// in order, after seeding, and only then rendered on the worker threads, so
+// output is the same however many threads are used.  Per-job timing is
+// reported on stderr.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <jansson.h>
+
+#include "dsp/filters/equalizer.hpp"
+#include "dsp/filters/filter.hpp"
+#include "dsp/filters/multimode.hpp"
+#include "dsp/filters/utility.hpp"
+#include "dsp/noise.hpp"
+#include "dsp/oscillator.hpp"
+#include "dsp/signal.hpp"
+
+using namespace bogaudio::dsp;
+
+static void fail(const char* format, const char* arg = "") {
+	fprintf(stderr, "render: ");
+	fprintf(stderr, format, arg);
+	fprintf(stderr, "\n");
+	exit(1);
+}
+
+static float number(json_t* o, const char* key, float defaultValue) {
+	json_t* v = json_object_get(o, key);
+	if (!v) {
+		return defaultValue;
+	}
+	if (!json_is_number(v)) {
+		fail("\"%s\" must be a number", key);
+	}
+	return json_number_value(v);
+}
+
+static std::string string(json_t* o, const char* key, const char* defaultValue) {
+	json_t* v = json_object_get(o, key);
+	if (!v) {
+		return defaultValue;
+	}
+	if (!json_is_string(v)) {
+		fail("\"%s\" must be a string", key);
+	}
+	return json_string_value(v);
+}
+
+
+struct Node {
+	virtual ~Node() {}
+	virtual float next(float in) = 0;
+};
+
+template<class G>
+struct SourceNode : Node {
+	std::unique_ptr<G> _generator;
+	float _level;
+
+	SourceNode(G* generator, float level) : _generator(generator), _level(level) {}
+
+	float next(float in) override {
+		return in + _level * _generator->next();
+	}
+};
+
+template<class P>
+struct ProcessorNode : Node {
+	std::unique_ptr<P> _processor;
+
+	ProcessorNode(P* processor) : _processor(processor) {}
+
+	float next(float in) override {
+		return _processor->next(in);
+	}
+};
+
+template<class G>
+static Node* source(G* generator, json_t* o) {
+	return new SourceNode<G>(generator, number(o, "level", 5.0f));
+}
+
+template<class P>
+static Node* processor(P* processor) {
+	return new ProcessorNode<P>(processor);
+}
+
+static Node* multimode(json_t* o, float sampleRate, MultimodeFilter::Mode defaultMode) {
+	std::string type = string(o, "filter", "butterworth");
+	std::string mode = string(o, "mode", "");
+	MultimodeFilter::Mode m = defaultMode;
+	if (mode == "lowpass") {
+		m = MultimodeFilter::LOWPASS_MODE;
+	}
+	else if (mode == "highpass") {
+		m = MultimodeFilter::HIGHPASS_MODE;
+	}
+	else if (mode == "bandpass") {
+		m = MultimodeFilter::BANDPASS_MODE;
+	}
+	else if (mode == "bandreject") {
+		m = MultimodeFilter::BANDREJECT_MODE;
+	}
+	else if (!mode.empty()) {
+		fail("unknown multimode mode \"%s\"", mode.c_str());
+	}
+	int poles = number(o, "poles", 4);
+	if (poles < MultimodeFilter::minPoles || poles > MultimodeFilter::maxPoles || poles % MultimodeFilter::modPoles != 0) {
+		fail("bad multimode pole count");
+	}
+
+	MultimodeFilter16* f = new MultimodeFilter16();
+	f->setParams(
+		sampleRate,
+		type == "chebyshev" ? MultimodeFilter::CHEBYSHEV_TYPE : MultimodeFilter::BUTTERWORTH_TYPE,
+		poles,
+		m,
+		std::min(std::max(number(o, "frequency", 1000.0f), MultimodeFilter::minFrequency), MultimodeFilter::maxFrequency),
+		std::min(std::max(number(o, "bandwidth", 0.5f), MultimodeFilter::minQbw), MultimodeFilter::maxQbw)
+	);
+	return processor(f);
+}
+
+static Node* buildNode(json_t* o, float sampleRate) {
+	if (!json_is_object(o)) {
+		fail("chain nodes must be objects");
+	}
+	std::string type = string(o, "type", "");
+	float frequency = number(o, "frequency", 440.0f);
+
+	// sources.
+	if (type == "sine") {
+		return source(new SineTableOscillator(sampleRate, frequency), o);
+	}
+	if (type == "saw") {
+		return source(new BandLimitedSawOscillator(sampleRate, frequency), o);
+	}
+	if (type == "square") {
+		BandLimitedSquareOscillator* g = new BandLimitedSquareOscillator(sampleRate, frequency);
+		g->setPulseWidth(number(o, "pulse_width", 0.5f));
+		return source(g, o);
+	}
+	if (type == "triangle") {
+		return source(new TriangleOscillator(sampleRate, frequency), o);
+	}
+	if (type == "wavetable") {
+		std::string wave = string(o, "wave", "saw");
+		const Wavetable* w = &StaticSawWavetable::wavetable();
+		if (wave == "square") {
+			w = &StaticSquareWavetable::wavetable();
+		}
+		else if (wave == "triangle") {
+			w = &StaticTriangleWavetable::wavetable();
+		}
+		else if (wave != "saw") {
+			fail("unknown wavetable \"%s\"", wave.c_str());
+		}
+		return source(new WavetableOscillator(*w, sampleRate, frequency), o);
+	}
+	if (type == "chirp") {
+		ChirpOscillator* g = new ChirpOscillator(
+			sampleRate,
+			number(o, "frequency1", 100.0f),
+			number(o, "frequency2", 10000.0f),
+			number(o, "time", 1.0f),
+			string(o, "sweep", "exponential") == "linear"
+		);
+		return source(g, o);
+	}
+	if (type == "noise") {
+		std::string color = string(o, "color", "white");
+		if (color == "white") {
+			return source(new WhiteNoiseGenerator(), o);
+		}
+		if (color == "pink") {
+			return source(new PinkNoiseGenerator(), o);
+		}
+		if (color == "red") {
+			return source(new RedNoiseGenerator(), o);
+		}
+		if (color == "blue") {
+			return source(new BlueNoiseGenerator(), o);
+		}
+		if (color == "gauss") {
+			return source(new GaussianNoiseGenerator(), o);
+		}
+		fail("unknown noise color \"%s\"", color.c_str());
+	}
+	if (type == "random_walk") {
+		RandomWalk* g = new RandomWalk(-1.0f, 1.0f, sampleRate, std::min(std::max(number(o, "change", 0.5f), 0.0f), 1.0f));
+		return source(g, o);
+	}
+
+	// processors.
+	if (type == "gain") {
+		Amplifier* a = new Amplifier();
+		a->setLevel(number(o, "db", 0.0f));
+		return processor(a);
+	}
+	if (type == "saturator") {
+		return processor(new Saturator());
+	}
+	if (type == "dc_blocker") {
+		return processor(new DCBlocker());
+	}
+	if (type == "lowpass" || type == "bandpass" || type == "highpass") {
+		StateVariableFilter::Mode mode = StateVariableFilter::LOWPASS_MODE;
+		if (type == "bandpass") {
+			mode = StateVariableFilter::BANDPASS_MODE;
+		}
+		else if (type == "highpass") {
+			mode = StateVariableFilter::HIGHPASS_MODE;
+		}
+		float cutoff = std::min(std::max(number(o, "cutoff", 1000.0f), 1.0f), 0.49f * sampleRate);
+		return processor(new StateVariableFilter(sampleRate, cutoff, std::max(number(o, "q", 0.707f), 0.001f), mode));
+	}
+	if (type == "multimode") {
+		return multimode(o, sampleRate, MultimodeFilter::LOWPASS_MODE);
+	}
+	if (type == "equalizer") {
+		Equalizer* e = new Equalizer();
+		e->setParams(
+			sampleRate,
+			std::min(std::max(number(o, "low", 0.0f), Equalizer::cutDb), Equalizer::gainDb),
+			std::min(std::max(number(o, "mid", 0.0f), Equalizer::cutDb), Equalizer::gainDb),
+			std::min(std::max(number(o, "high", 0.0f), Equalizer::cutDb), Equalizer::gainDb)
+		);
+		return processor(e);
+	}
+	if (type == "envelope_follower") {
+		EnvelopeFollower* e = new EnvelopeFollower();
+		e->setParams(sampleRate, std::min(std::max(number(o, "sensitivity", 0.5f), 0.0f), 1.0f));
+		return processor(e);
+	}
+	if (type == "slew") {
+		return processor(new SlewLimiter(sampleRate, std::max(number(o, "ms", 10.0f), 0.0f)));
+	}
+	if (type == "delay") {
+		return processor(new DelayLine(sampleRate, std::max(number(o, "ms", 100.0f), 0.0f), 1.0f));
+	}
+
+	fail("unknown node type \"%s\"", type.c_str());
+	return NULL;
+}
+
+
+struct Job {
+	typedef std::vector<std::unique_ptr<Node>> Chain;
+
+	std::string output;
+	bool csv = false;
+	int bits = 16;
+	float scale = 0.2f;
+	float sampleRate = 48000.0f;
+	int frames = 0;
+	std::vector<Chain> voices;
+	std::vector<float> samples; // interleaved by voice.
+	double elapsed = 0.0;
+
+	Job(json_t* o, float defaultSampleRate, float defaultSeconds, unsigned int defaultSeed);
+	void render();
+	void write();
+	void writeWAV(FILE* f);
+	void writeCSV(FILE* f);
+};
+
+Job::Job(json_t* o, float defaultSampleRate, float defaultSeconds, unsigned int defaultSeed) {
+	if (!json_is_object(o)) {
+		fail("jobs must be objects");
+	}
+	output = string(o, "output", "");
+	if (output.empty()) {
+		fail("a job has no \"output\"");
+	}
+	csv = output.size() > 4 && output.compare(output.size() - 4, 4, ".csv") == 0;
+	bits = number(o, "bits", 16);
+	if (bits != 16 && bits != 24 && bits != 32) {
+		fail("\"bits\" must be 16, 24 or 32, for %s", output.c_str());
+	}
+	scale = number(o, "scale", 0.2f);
+	sampleRate = number(o, "sample_rate", defaultSampleRate);
+	if (sampleRate < 1000.0f) {
+		fail("bad sample rate for %s", output.c_str());
+	}
+	frames = std::max(0.0f, number(o, "seconds", defaultSeconds) * sampleRate);
+	int n = std::max(1.0f, number(o, "voices", 1));
+
+	json_t* chain = json_object_get(o, "chain");
+	if (!json_is_array(chain) || json_array_size(chain) == 0) {
+		fail("no \"chain\" for %s", output.c_str());
+	}
+	Seeds::seed((unsigned int)number(o, "seed", defaultSeed));
+	voices.resize(n);
+	for (Chain& c : voices) {
+		for (size_t i = 0; i < json_array_size(chain); ++i) {
+			c.emplace_back(buildNode(json_array_get(chain, i), sampleRate));
+		}
+	}
+	samples.resize((size_t)frames * voices.size());
+}
+
+void Job::render() {
+	auto start = std::chrono::steady_clock::now();
+	int n = voices.size();
+	for (int i = 0; i < frames; ++i) {
+		for (int v = 0; v < n; ++v) {
+			float s = 0.0f;
+			for (auto& node : voices[v]) {
+				s = node->next(s);
+			}
+			samples[(size_t)i * n + v] = s;
+		}
+	}
+	elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Job::write() {
+	FILE* f = fopen(output.c_str(), "wb");
+	if (!f) {
+		fail("can't open %s", output.c_str());
+	}
+	if (csv) {
+		writeCSV(f);
+	}
+	else {
+		writeWAV(f);
+	}
+	if (fclose(f) != 0) {
+		fail("error writing %s", output.c_str());
+	}
+}
+
+static void writeLE(FILE* f, uint32_t v, int bytes) {
+	for (int i = 0; i < bytes; ++i) {
+		fputc((v >> (8 * i)) & 0xff, f);
+	}
+}
+
+void Job::writeWAV(FILE* f) {
+	const int channels = voices.size();
+	const int bytes = bits / 8;
+	const uint32_t dataSize = (uint32_t)samples.size() * bytes;
+	const bool ieee = bits == 32;
+	const uint32_t fmtSize = ieee ? 18 : 16;
+	const uint32_t factSize = ieee ? 12 : 0;
+
+	fwrite("RIFF", 1, 4, f);
+	writeLE(f, 4 + (8 + fmtSize) + factSize + (8 + dataSize), 4);
+	fwrite("WAVE", 1, 4, f);
+	fwrite("fmt ", 1, 4, f);
+	writeLE(f, fmtSize, 4);
+	writeLE(f, ieee ? 3 : 1, 2); // WAVE_FORMAT_IEEE_FLOAT or WAVE_FORMAT_PCM.
+	writeLE(f, channels, 2);
+	writeLE(f, (uint32_t)sampleRate, 4);
+	writeLE(f, (uint32_t)sampleRate * channels * bytes, 4);
+	writeLE(f, channels * bytes, 2);
+	writeLE(f, bits, 2);
+	if (ieee) {
+		writeLE(f, 0, 2);
+		fwrite("fact", 1, 4, f);
+		writeLE(f, 4, 4);
+		writeLE(f, frames, 4);
+	}
+	fwrite("data", 1, 4, f);
+	writeLE(f, dataSize, 4);
+
+	const float max = (float)((1 << (bits - 1)) - 1);
+	for (float s : samples) {
+		s *= scale;
+		if (ieee) {
+			uint32_t u;
+			memcpy(&u, &s, 4);
+			writeLE(f, u, 4);
+		}
+		else {
+			s = std::min(std::max(s, -1.0f), 1.0f);
+			writeLE(f, (uint32_t)(int32_t)lrintf(s * max), bytes);
+		}
+	}
+}
+
+void Job::writeCSV(FILE* f) {
+	const int n = voices.size();
+	for (int i = 0; i < frames; ++i) {
+		fprintf(f, "%f", i / sampleRate);
+		for (int v = 0; v < n; ++v) {
+			fprintf(f, ", %f", scale * samples[(size_t)i * n + v]);
+		}
+		fprintf(f, "\n");
+	}
+}
+
+
+int main(int argc, char** argv) {
+	int threads = std::max(1u, std::thread::hardware_concurrency());
+	const char* path = NULL;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+			threads = std::max(1, atoi(argv[++i]));
+		}
+		else if (!path) {
+			path = argv[i];
+		}
+		else {
+			fail("usage: render [-j threads] description.json");
+		}
+	}
+	if (!path) {
+		fail("usage: render [-j threads] description.json");
+	}
+
+	json_error_t error;
+	json_t* root = json_load_file(path, 0, &error);
+	if (!root) {
+		fprintf(stderr, "render: %s:%d: %s\n", path, error.line, error.text);
+		return 1;
+	}
+	float sampleRate = number(root, "sample_rate", 48000.0f);
+	float seconds = number(root, "seconds", 1.0f);
+	unsigned int seed = number(root, "seed", 1);
+	json_t* jobsJ = json_object_get(root, "jobs");
+	if (!json_is_array(jobsJ)) {
+		fail("no \"jobs\" array in %s", path);
+	}
+
+	std::vector<std::unique_ptr<Job>> jobs;
+	for (size_t i = 0; i < json_array_size(jobsJ); ++i) {
+		jobs.emplace_back(new Job(json_array_get(jobsJ, i), sampleRate, seconds, seed));
+	}
+	json_decref(root);
+
+	auto start = std::chrono::steady_clock::now();
+	std::atomic<int> nextJob(0);
+	std::vector<std::thread> workers;
+	for (int t = 0, n = std::min(threads, (int)jobs.size()); t < n; ++t) {
+		workers.emplace_back([&]() {
+			int i;
+			while ((i = nextJob++) < (int)jobs.size()) {
+				jobs[i]->render();
+			}
+		});
+	}
+	for (std::thread& w : workers) {
+		w.join();
+	}
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	for (auto& job : jobs) {
+		job->write();
+		double audio = job->frames / job->sampleRate;
+		size_t n = (size_t)job->frames * job->voices.size();
+		fprintf(
+			stderr,
+			"%s: %d voice(s), %.2fs at %.0fHz in %.3fs (%.1fns/sample, %.0fx realtime)\n",
+			job->output.c_str(),
+			(int)job->voices.size(),
+			audio,
+			job->sampleRate,
+			job->elapsed,
+			n > 0 ? 1e9 * job->elapsed / n : 0.0,
+			job->elapsed > 0.0 ? audio / job->elapsed : 0.0
+		);
+	}
+	fprintf(stderr, "%d job(s) on %d thread(s) in %.3fs\n", (int)jobs.size(), std::min(threads, (int)jobs.size()), elapsed);
+	return 0;
+}
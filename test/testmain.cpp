@@ -1,3 +1,16 @@
+// Golden-output regression tests for src/dsp.  Each test renders a fixed
+// stimulus through a primitive (or a lane engine) and compares the result
+// with a stored reference in test/golden, by maximum absolute error and by
+// spectral error (the worst, over Hann-windowed frames, of the magnitude
+// spectrum difference relative to the reference spectrum, in dB).  Usage:
+//
+//   testmain [-d golden_dir] [-u] [test_name...]
+//
+// With -u, references are (re)written from the current build instead of
+// compared; tests marked perBuild have separate references for builds with
+// and without RACK_SIMD, so -u must be run in both.  Lane engines render laneTestChannels channels, interleaved per
+// sample, so references are the same with and without RACK_SIMD.  Noise tests
+// seed Seeds first; their references assume libstdc++'s distributions.
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -5,75 +18,742 @@
 #include <string.h>
 #include <math.h>
 #include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "dsp/analyzer.hpp"
+#include "dsp/dynamics.hpp"
+#include "dsp/envelope.hpp"
+#include "dsp/filters/equalizer.hpp"
+#include "dsp/filters/filter.hpp"
+#include "dsp/filters/multimode.hpp"
+#include "dsp/filters/resample.hpp"
+#include "dsp/filters/utility.hpp"
+#include "dsp/fm.hpp"
+#include "dsp/lpg.hpp"
+#include "dsp/noise.hpp"
+#include "dsp/oscillator.hpp"
+#include "dsp/parallel.hpp"
+#include "dsp/signal.hpp"
+#include "dsp/waveshaping.hpp"
 
-// // #include "util/math.hpp" // Rack
-// #include "simd/vector.hpp" // Rack
-// using rack::simd::float_4;
-//
-// // #include "dsp/fixed.hpp"
-// // using namespace bogaudio::dsp;
-//
-// int main() {
-// 	// {
-// 	// 	fixed_16_16 x = 5;
-// 	// 	fixed_16_16 y = 1;
-// 	// 	x = 3;
-// 	// 	printf("X=%d\n", (int)(x + y));
-// 	// 	y = 2;
-// 	// 	printf("X=%d\n", (int)(x - y));
-// 	// 	x = y + 5;
-// 	// 	printf("X=%d\n", (int)x);
-// 	// 	x = y - 3;
-// 	// 	printf("X=%d\n", (int)x);
-// 	//
-// 	// 	x += 2.5;
-// 	// 	printf("X=%d\n", (int)x);
-// 	// 	printf("X=%f\n", (float)x);
-// 	//
-// 	// 	x = y - 0.3;
-// 	// 	printf("X=%d\n", (int)x);
-// 	// 	printf("X=%f\n", (float)x);
-// 	// }
-// 	//
-// 	// {
-// 	// 	fixed_32_32 x = 5;
-// 	// 	fixed_32_32 y = 1;
-// 	// 	x = 3;
-// 	// 	printf("X=%d\n", (int)(x + y));
-// 	// 	y = 2;
-// 	// 	printf("X=%d\n", (int)(x - y));
-// 	// 	x = y + 5;
-// 	// 	printf("X=%d\n", (int)x);
-// 	// 	x = y - 3;
-// 	// 	printf("X=%d\n", (int)x);
-// 	//
-// 	// 	x += 2.5;
-// 	// 	printf("X=%d\n", (int)x);
-// 	// 	printf("X=%f\n", (float)x);
-// 	//
-// 	// 	x = y - 0.3;
-// 	// 	printf("X=%d\n", (int)x);
-// 	// 	printf("X=%f\n", (float)x);
-// 	// }
-// 	//
-// 	// return 0;
-//
-// 	float_4 a(1.0, 2.0, 3.0, 4.0);
-// 	float_4 b = _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(2, 1, 0, 0));
-// 	b[0] = 0.0;
-// 	for (int i = 0; i < 4; ++i) {
-// 		printf("a=%f b=%f\n", a[i], b[i]);
-// 	}
-// }
-
-#include "dsp/pitch.hpp"
 using namespace bogaudio::dsp;
 
-int main() {
-	printf("%f\n", frequencyToSemitone(1.0f));
-	printf("%f\n", semitoneToFrequency(0.0f));
-	printf("%f\n", semitoneToFrequency(60.0f));
-	printf("%f\n", semitoneToFrequency(120.0f));
-	printf("%f\n", frequencyToSemitone(20000.0f));
-	return 0;
+static const float sampleRate = 48000.0f;
+static const int samples = 2048;
+static const int laneTestChannels = 4;
+static const int spectrumSize = 1024;
+
+typedef std::vector<float> Buffer;
+
+struct Test {
+	std::string name;
+	float maxAbsError;
+	float maxSpectralErrorDb;
+	std::function<void(Buffer&)> render;
+	// the output legitimately differs with RACK_SIMD (e.g. the pipelined
+	// Biquad4 cascade's latency), so each build has its own reference.
+	bool perBuild;
+
+	Test(
+		const std::string& name,
+		float maxAbsError,
+		float maxSpectralErrorDb,
+		std::function<void(Buffer&)> render,
+		bool perBuild = false
+	)
+	: name(name)
+	, maxAbsError(maxAbsError)
+	, maxSpectralErrorDb(maxSpectralErrorDb)
+	, render(render)
+	, perBuild(perBuild)
+	{}
+};
+
+// An exponential sine sweep over 20Hz-20kHz at 5V, with an impulse every 512
+// samples; deterministic, and not dependent on the noise generators.
+static float stimulus(int i) {
+	const double f1 = 20.0, f2 = 20000.0;
+	const double T = samples / (double)sampleRate;
+	double t = i / (double)sampleRate;
+	double k = log(f2 / f1);
+	double s = 5.0 * sin(2.0 * M_PI * f1 * T / k * (exp(t / T * k) - 1.0));
+	return s + (i % 512 == 0 ? 5.0 : 0.0);
+}
+
+// collects the output of lane engines run a group at a time, to interleave
+// the channels per sample.
+struct Channels {
+	Buffer _channels[laneTestChannels];
+
+	void push(int g, const lanes_t& s) {
+		for (int l = 0; l < laneWidth && g * laneWidth + l < laneTestChannels; ++l) {
+			_channels[g * laneWidth + l].push_back(lanes::get(s, l));
+		}
+	}
+
+	void interleave(Buffer& out) {
+		for (size_t i = 0; i < _channels[0].size(); ++i) {
+			for (int c = 0; c < laneTestChannels; ++c) {
+				out.push_back(_channels[c][i]);
+			}
+		}
+	}
+};
+
+template<class G>
+static void generate(G& g, Buffer& out) {
+	for (int i = 0; i < samples; ++i) {
+		out.push_back(g.next());
+	}
+}
+
+template<class F>
+static void filter(F& f, Buffer& out) {
+	for (int i = 0; i < samples; ++i) {
+		out.push_back(f.next(stimulus(i)));
+	}
+}
+
+// per channel, a shape and time, following the stimulus sampled and held
+// every 64 samples, as it slews.  The reference was rendered by
+// ShapedSlewLimiter when it took two pows per step, per channel.
+static void shapedSlewLanes(Buffer& out) {
+	const float shapes[] = { 0.5f, 1.0f, 2.0f, 0.2f };
+	const float times[] = { 1.0f, 2.0f, 1.5f, 5.0f };
+	Channels channels;
+	for (int g = 0; g < laneGroups(laneTestChannels); ++g) {
+		ShapedSlewLimiterLanes f;
+		for (int l = 0; l < laneWidth; ++l) {
+			int c = std::min(g * laneWidth + l, laneTestChannels - 1);
+			f.setParams(l, sampleRate, times[c], shapes[c]);
+		}
+		for (int i = 0; i < samples; ++i) {
+			channels.push(g, f.next(stimulus(i - i % 64)));
+		}
+	}
+	channels.interleave(out);
+}
+
+// per channel, gates of a different length every 512 samples, through a
+// rise/fall slew into a low-pass gate voice, with the lowpass and highpass in
+// series; the channels differ in shape and filter and VCA response.
+static void lowPassGateVoices(Buffer& out) {
+	const float shapes[] = { 0.5f, 1.0f, 2.0f, 0.2f };
+	Channels channels;
+	LowPassGateVoices voices(sampleRate);
+	voices.setFilters(4, 2, true);
+	RiseFallShapedSlewLimiterLanes slews[LowPassGateVoices::maxGroups];
+	for (int c = 0; c < laneTestChannels; ++c) {
+		slews[c / laneWidth].setParams(c % laneWidth, sampleRate, 1.0f + c, shapes[c], 3.0f + 2.0f * c, 1.0f / shapes[c]);
+		voices.setLowpass(c, 0.01f * c, 0.5f - 0.1f * c);
+		voices.setHighpass(c, 0.02f, -0.01f * c);
+		voices.setLevel(c, 0.0f, 1.0f - 0.2f * c);
+	}
+	for (int g = 0; g < laneGroups(laneTestChannels); ++g) {
+		for (int i = 0; i < samples; ++i) {
+			float gates[laneWidth];
+			for (int l = 0; l < laneWidth; ++l) {
+				gates[l] = i % 512 < 64 * (1 + g * laneWidth + l) ? 10.0f : 0.0f;
+			}
+			lanes_t env = 0.1f * slews[g].next(lanes::load(gates));
+			channels.push(g, voices.next(g, stimulus(i), env));
+		}
+	}
+	channels.interleave(out);
+}
+
+template<class N>
+static void noise(Buffer& out) {
+	Seeds::seed(1);
+	N n;
+	generate(n, out);
+}
+
+static void multimode(Buffer& out, MultimodeFilter::Type type, int poles, MultimodeFilter::Mode mode, float frequency, float qbw) {
+	MultimodeFilter16 f;
+	f.setParams(sampleRate, type, poles, mode, frequency, qbw);
+	filter(f, out);
+}
+
+static void dynamics(Buffer& out, DynamicsProcessor::Mode mode, DynamicsProcessor::Detector detector) {
+	DynamicsProcessor d(300.0f, sampleRate);
+	d.setMode(mode);
+	d.setDetector(detector);
+	for (int c = 0; c < laneTestChannels; ++c) {
+		d.setThreshold(c, -24.0f + 6.0f * c);
+		d.setRatio(c, 2.0f + 2.0f * c);
+		d.setAttackRelease(c, 10.0f, 100.0f);
+	}
+	for (int i = 0; i < samples; ++i) {
+		lanes_t in = stimulus(i);
+		for (int g = 0; g < laneGroups(laneTestChannels); ++g) {
+			lanes_t o = d.next(g, in) * in;
+			for (int l = 0; l < laneWidth; ++l) {
+				out.push_back(lanes::get(o, l));
+			}
+		}
+	}
+}
+
+// first- and second-order antialiased output, interleaved per sample.
+template<class CURVE>
+static void waveshaper(Buffer& out) {
+	FirstOrderADAA<CURVE, lanes_t> first;
+	SecondOrderADAA<CURVE> second;
+	for (int i = 0; i < samples; ++i) {
+		float x = 0.5f * stimulus(i);
+		out.push_back(lanes::get(first.next(lanes_t(x)), 0));
+		out.push_back(second.next(x));
+	}
+}
+
+static std::vector<Test> tests() {
+	std::vector<Test> t;
+
+	// oscillators.
+	t.push_back({ "saw", 1e-5f, -80.0f, [](Buffer& out) {
+		SawOscillator o(sampleRate, 440.0f);
+		generate(o, out);
+	}});
+	t.push_back({ "square", 1e-5f, -80.0f, [](Buffer& out) {
+		SquareOscillator o(sampleRate, 440.0f);
+		o.setPulseWidth(0.3f);
+		generate(o, out);
+	}});
+	t.push_back({ "triangle", 1e-5f, -80.0f, [](Buffer& out) {
+		TriangleOscillator o(sampleRate, 440.0f);
+		generate(o, out);
+	}});
+	t.push_back({ "sine", 1e-5f, -80.0f, [](Buffer& out) {
+		SineOscillator o(sampleRate, 440.0f);
+		generate(o, out);
+	}});
+	t.push_back({ "sine_table", 1e-5f, -80.0f, [](Buffer& out) {
+		SineTableOscillator o(sampleRate, 440.0f);
+		generate(o, out);
+	}});
+	t.push_back({ "band_limited_saw", 1e-4f, -80.0f, [](Buffer& out) {
+		BandLimitedSawOscillator o(sampleRate, 1234.0f);
+		generate(o, out);
+	}});
+	t.push_back({ "band_limited_square", 1e-4f, -80.0f, [](Buffer& out) {
+		BandLimitedSquareOscillator o(sampleRate, 1234.0f);
+		o.setPulseWidth(0.3f);
+		generate(o, out);
+	}});
+	t.push_back({ "stepped_random", 1e-5f, -80.0f, [](Buffer& out) {
+		Seeds::seed(1);
+		SteppedRandomOscillator o(sampleRate, 100.0f, 12345);
+		generate(o, out);
+	}});
+	t.push_back({ "wavetable_saw", 1e-4f, -80.0f, [](Buffer& out) {
+		WavetableOscillator o(StaticSawWavetable::wavetable(), sampleRate, 1234.0f);
+		generate(o, out);
+	}});
+	t.push_back({ "wavetable_voices", 1e-4f, -80.0f, [](Buffer& out) {
+		Channels channels;
+		for (int g = 0; g < laneGroups(laneTestChannels); ++g) {
+			WavetableVoices v(StaticSquareWavetable::wavetable(), sampleRate);
+			for (int l = 0; l < laneWidth; ++l) {
+				v.setFrequency(l, 100.0f * (1 + g * laneWidth + l));
+			}
+			for (int i = 0; i < samples; ++i) {
+				channels.push(g, v.next());
+			}
+		}
+		channels.interleave(out);
+	}});
+	// phases approaching the end of a cycle, ending at 0xFFFFFFFF, where
+	// cycleFraction() rounds to exactly 1.0; on the first and last levels,
+	// through both value() overloads and both interpolations.
+	t.push_back({ "wavetable_cycle_end", 1e-5f, -80.0f, [](Buffer& out) {
+		const Wavetable& w = StaticSawWavetable::wavetable();
+		const int levels[] = { 0, w.levels() - 1 };
+		const Wavetable::Interpolation interpolations[] = { Wavetable::LINEAR_INTERPOLATION, Wavetable::CUBIC_INTERPOLATION };
+		for (int level : levels) {
+			int laneLevels[laneWidth];
+			std::fill(laneLevels, laneLevels + laneWidth, level);
+			for (Wavetable::Interpolation interpolation : interpolations) {
+				for (int i = samples / 8 - 1; i >= 0; --i) {
+					Phasor::cycle_phase_t phase = 0xFFFFFFFF - (Phasor::cycle_phase_t)i * 64;
+					out.push_back(w.value(level, Phasor::cycleFraction(phase), interpolation));
+					out.push_back(lanes::get(w.value(laneLevels, Phasor::cycleFraction(phase), interpolation), 0));
+				}
+			}
+		}
+	}});
+	t.push_back({ "phase_taps", 1e-5f, -80.0f, [](Buffer& out) {
+		Seeds::seed(1);
+		PhaseTaps taps;
+		for (int t = 0; t < PhaseTaps::maxTaps; ++t) {
+			taps.setOffset(t, Phasor::radiansToPhase(0.25f * t * M_PI));
+		}
+		taps.setPulseWidth(0.3f);
+		Phasor p(sampleRate, 345.0f);
+		for (int i = 0; i < samples / PhaseTaps::maxTaps; ++i) {
+			p.advancePhase();
+			float taps8[PhaseTaps::maxTaps];
+			taps.next((PhaseTaps::Wave)((i / 32) % 6), p._phase, taps8);
+			out.insert(out.end(), taps8, taps8 + PhaseTaps::maxTaps);
+		}
+	}});
+	t.push_back({ "chirp", 1e-4f, -80.0f, [](Buffer& out) {
+		ChirpOscillator o(sampleRate, 100.0f, 10000.0f, samples / sampleRate, false);
+		generate(o, out);
+	}});
+	t.push_back({ "fm_voices", 1e-4f, -80.0f, [](Buffer& out) {
+		FMOperatorVoices v(sampleRate);
+		for (int c = 0; c < laneTestChannels; ++c) {
+			v.setFrequency(c, 110.0f * (c + 1));
+		}
+		for (int i = 0; i < samples; ++i) {
+			for (int g = 0; g < laneGroups(laneTestChannels); ++g) {
+				lanes_t offset = 0.0f;
+				lanes_t mix = 0.0f;
+				for (int l = 0; l < laneWidth; ++l) {
+					int c = g * laneWidth + l;
+					lanes::set(offset, l, 0.2f * c * stimulus(i));
+					lanes::set(mix, l, c % 2 == 0 ? 1.0f : 0.0f);
+				}
+				lanes_t s = v.next(g, offset, mix);
+				for (int l = 0; l < laneWidth; ++l) {
+					out.push_back(lanes::get(s, l));
+				}
+			}
+		}
+	}});
+
+	// noise.
+	t.push_back({ "noise_white", 1e-6f, -100.0f, noise<WhiteNoiseGenerator> });
+	t.push_back({ "noise_pink", 1e-6f, -100.0f, noise<PinkNoiseGenerator> });
+	t.push_back({ "noise_red", 1e-6f, -100.0f, noise<RedNoiseGenerator> });
+	t.push_back({ "noise_blue", 1e-6f, -100.0f, noise<BlueNoiseGenerator> });
+	t.push_back({ "noise_gauss", 1e-6f, -100.0f, noise<GaussianNoiseGenerator> });
+	t.push_back({ "random_walk", 1e-4f, -80.0f, [](Buffer& out) {
+		Seeds::seed(1);
+		RandomWalk w(-5.0f, 5.0f, sampleRate, 0.7f);
+		generate(w, out);
+	}});
+	t.push_back({ "random_walk_lanes", 1e-4f, -80.0f, [](Buffer& out) {
+		Seeds::seed(1);
+		Channels channels;
+		for (int g = 0; g < laneGroups(laneTestChannels); ++g) {
+			RandomWalkLanes w(-5.0f, 5.0f, sampleRate);
+			for (int l = 0; l < laneWidth; ++l) {
+				int c = g * laneWidth + l;
+				w.setParams(l, sampleRate, 0.2f + 0.2f * c, 1 + c % 2);
+			}
+			for (int i = 0; i < samples; ++i) {
+				if (i == samples / 2) {
+					for (int l = 0; l < laneWidth; ++l) {
+						w.jump(l);
+					}
+				}
+				channels.push(g, w.next());
+			}
+		}
+		channels.interleave(out);
+	}});
+
+	// filters.
+	t.push_back({ "multimode_butterworth_lp4", 1e-4f, -80.0f, [](Buffer& out) {
+		multimode(out, MultimodeFilter::BUTTERWORTH_TYPE, 4, MultimodeFilter::LOWPASS_MODE, 1000.0f, 0.0f);
+	}, true });
+	t.push_back({ "multimode_butterworth_hp12", 1e-4f, -80.0f, [](Buffer& out) {
+		multimode(out, MultimodeFilter::BUTTERWORTH_TYPE, 12, MultimodeFilter::HIGHPASS_MODE, 5000.0f, 0.0f);
+	}, true });
+	t.push_back({ "multimode_chebyshev_bp8", 1e-4f, -80.0f, [](Buffer& out) {
+		multimode(out, MultimodeFilter::CHEBYSHEV_TYPE, 8, MultimodeFilter::BANDPASS_MODE, 2000.0f, 0.3f);
+	}, true });
+	t.push_back({ "multimode_chebyshev_br4", 1e-4f, -80.0f, [](Buffer& out) {
+		multimode(out, MultimodeFilter::CHEBYSHEV_TYPE, 4, MultimodeFilter::BANDREJECT_MODE, 500.0f, 0.5f);
+	}, true });
+	t.push_back({ "multimode_bank_lanes", 1e-4f, -80.0f, [](Buffer& out) {
+		const int bands = 3;
+		Channels channels;
+		for (int g = 0; g < laneGroups(laneTestChannels); ++g) {
+			MultimodeBankLanes bank(bands);
+			for (int l = 0; l < laneWidth; ++l) {
+				int c = g * laneWidth + l;
+				for (int b = 0; b < bands; ++b) {
+					bank.setParams(b, l, sampleRate, MultimodeFilter::BUTTERWORTH_TYPE, 4, MultimodeFilter::BANDPASS_MODE, 200.0f * (b + 1) * (c + 1), 0.2f);
+				}
+			}
+			for (int i = 0; i < samples; ++i) {
+				lanes_t outs[bands];
+				bank.next(stimulus(i), outs);
+				channels.push(g, outs[0] + outs[1] + outs[2]);
+			}
+		}
+		channels.interleave(out);
+	}});
+	// a 12-pole lowpass bank takes a 4-pole bandpass design, a lane at a
+	// time, for the first half; then designs its lowpass again.  The first
+	// half should match multimode_bank_lanes' first band.
+	t.push_back({ "multimode_bank_lanes_design", 1e-4f, -80.0f, [](Buffer& out) {
+		Channels channels;
+		for (int g = 0; g < laneGroups(laneTestChannels); ++g) {
+			MultimodeBankLanes designed(1);
+			MultimodeBankLanes bank(1);
+			for (int l = 0; l < laneWidth; ++l) {
+				int c = g * laneWidth + l;
+				designed.setParams(0, l, sampleRate, MultimodeFilter::BUTTERWORTH_TYPE, 4, MultimodeFilter::BANDPASS_MODE, 200.0f * (c + 1), 0.2f);
+				bank.setParams(0, l, sampleRate, MultimodeFilter::BUTTERWORTH_TYPE, 12, MultimodeFilter::LOWPASS_MODE, 1000.0f, MultimodeFilter::minQbw);
+			}
+			MultimodeBankLanes::Design design;
+			designed.getDesign(0, design);
+			for (int l = 0; l < laneWidth; ++l) {
+				bank.setDesign(0, l, design);
+			}
+			for (int i = 0; i < samples; ++i) {
+				if (i == samples / 2) {
+					for (int l = 0; l < laneWidth; ++l) {
+						bank.setParams(0, l, sampleRate, MultimodeFilter::BUTTERWORTH_TYPE, 12, MultimodeFilter::LOWPASS_MODE, 1000.0f, MultimodeFilter::minQbw);
+					}
+				}
+				channels.push(g, bank.next(0, stimulus(i)));
+			}
+		}
+		channels.interleave(out);
+	}});
+	t.push_back({ "svf_lowpass", 1e-4f, -80.0f, [](Buffer& out) {
+		StateVariableFilter f(sampleRate, 800.0f, 2.0f, StateVariableFilter::LOWPASS_MODE);
+		filter(f, out);
+	}});
+	t.push_back({ "svf_bandpass", 1e-4f, -80.0f, [](Buffer& out) {
+		StateVariableFilter f(sampleRate, 3000.0f, 5.0f, StateVariableFilter::BANDPASS_MODE);
+		filter(f, out);
+	}});
+	t.push_back({ "svf_highpass", 1e-4f, -80.0f, [](Buffer& out) {
+		StateVariableFilter f(sampleRate, 6000.0f, 0.7f, StateVariableFilter::HIGHPASS_MODE);
+		filter(f, out);
+	}});
+	t.push_back({ "channel_workers", 1e-4f, -80.0f, [](Buffer& out) {
+		struct Job {
+			StateVariableFilter filters[laneTestChannels];
+			float in = 0.0f;
+			float out[laneTestChannels] {};
+
+			static void process(void* context, int c) {
+				Job* job = (Job*)context;
+				job->out[c] = job->filters[c].next(job->in);
+			}
+		};
+		Job job;
+		for (int c = 0; c < laneTestChannels; ++c) {
+			job.filters[c].setParams(sampleRate, 400.0f * (c + 1), 1.0f + c, StateVariableFilter::LOWPASS_MODE);
+		}
+		ChannelWorkers workers(2);
+		for (int i = 0; i < samples; ++i) {
+			job.in = stimulus(i);
+			if (!workers.run(Job::process, &job, laneTestChannels, 1.0f / sampleRate)) {
+				for (int c = 0; c < laneTestChannels; ++c) {
+					Job::process(&job, c);
+				}
+			}
+			out.insert(out.end(), job.out, job.out + laneTestChannels);
+		}
+	}});
+	t.push_back({ "equalizer", 1e-4f, -80.0f, [](Buffer& out) {
+		Equalizer e;
+		e.setParams(sampleRate, 6.0f, -12.0f, 3.0f);
+		filter(e, out);
+	}, true });
+	t.push_back({ "dc_blocker", 1e-5f, -80.0f, [](Buffer& out) {
+		DCBlocker f;
+		for (int i = 0; i < samples; ++i) {
+			out.push_back(f.next(2.0f + stimulus(i)));
+		}
+	}});
+
+	// resampling.
+	t.push_back({ "cic_decimator", 1e-4f, -80.0f, [](Buffer& out) {
+		CICDecimator d(4, 8);
+		for (int i = 0; i < samples; ++i) {
+			float buf[8];
+			for (int j = 0; j < 8; ++j) {
+				buf[j] = 0.2f * stimulus((i * 8 + j) % samples);
+			}
+			out.push_back(d.next(buf));
+		}
+	}});
+	t.push_back({ "cic_decimator_lanes", 1e-4f, -80.0f, [](Buffer& out) {
+		Channels channels;
+		for (int g = 0; g < laneGroups(laneTestChannels); ++g) {
+			CICDecimatorLanes d(4, 8);
+			for (int i = 0; i < samples; ++i) {
+				lanes_t buf[8];
+				for (int j = 0; j < 8; ++j) {
+					buf[j] = 0.2f * stimulus((i * 8 + j) % samples);
+					for (int l = 0; l < laneWidth; ++l) {
+						lanes::set(buf[j], l, lanes::get(buf[j], l) * (1.0f - 0.2f * (g * laneWidth + l)));
+					}
+				}
+				channels.push(g, d.next(buf));
+			}
+		}
+		channels.interleave(out);
+	}});
+	t.push_back({ "cic_interpolator", 1e-4f, -80.0f, [](Buffer& out) {
+		CICInterpolator in(4, 8);
+		for (int i = 0; i < samples / 8; ++i) {
+			float buf[8];
+			in.next(0.2f * stimulus(i), buf);
+			out.insert(out.end(), buf, buf + 8);
+		}
+	}});
+	t.push_back({ "lpf_decimator", 1e-4f, -80.0f, [](Buffer& out) {
+		LPFDecimator d(sampleRate, 8);
+		for (int i = 0; i < samples; ++i) {
+			float buf[8];
+			for (int j = 0; j < 8; ++j) {
+				buf[j] = stimulus((i * 8 + j) % samples);
+			}
+			out.push_back(d.next(buf));
+		}
+	}, true });
+
+	// envelopes and followers.
+	t.push_back({ "adsr", 1e-5f, -80.0f, [](Buffer& out) {
+		ADSR e(false, sampleRate);
+		e.setAttack(0.005f);
+		e.setDecay(0.01f);
+		e.setSustain(0.5f);
+		e.setRelease(0.01f);
+		for (int i = 0; i < samples; ++i) {
+			e.setGate(i < samples / 2);
+			out.push_back(e.next());
+		}
+	}});
+	t.push_back({ "envelope_follower", 1e-4f, -80.0f, [](Buffer& out) {
+		EnvelopeFollower f;
+		f.setParams(sampleRate, 0.3f);
+		filter(f, out);
+	}});
+	t.push_back({ "envelope_follower_lanes", 1e-4f, -80.0f, [](Buffer& out) {
+		Channels channels;
+		for (int g = 0; g < laneGroups(laneTestChannels); ++g) {
+			EnvelopeFollowerLanes f;
+			for (int l = 0; l < laneWidth; ++l) {
+				f.setParams(l, sampleRate, 0.25f * (g * laneWidth + l));
+			}
+			for (int i = 0; i < samples; ++i) {
+				channels.push(g, f.next(stimulus(i)));
+			}
+		}
+		channels.interleave(out);
+	}});
+	t.push_back({ "rms", 1e-4f, -80.0f, [](Buffer& out) {
+		FastRootMeanSquare f(sampleRate, 0.5f);
+		filter(f, out);
+	}});
+	t.push_back({ "slew", 1e-5f, -80.0f, [](Buffer& out) {
+		SlewLimiter f(sampleRate, 5.0f);
+		filter(f, out);
+	}});
+	t.push_back({ "shaped_slew", 1e-4f, -80.0f, [](Buffer& out) {
+		ShapedSlewLimiter f(sampleRate, 5.0f, 0.5f);
+		filter(f, out);
+	}});
+	t.push_back({ "shaped_slew_lanes", 1e-3f, -60.0f, [](Buffer& out) {
+		shapedSlewLanes(out);
+	}});
+	t.push_back({ "low_pass_gate_voices", 1e-3f, -60.0f, [](Buffer& out) {
+		lowPassGateVoices(out);
+	}});
+	t.push_back({ "delay_line", 1e-6f, -100.0f, [](Buffer& out) {
+		DelayLine f(sampleRate, 10.0f, 0.37f);
+		filter(f, out);
+	}});
+
+	// dynamics.
+	t.push_back({ "compressor", 1e-4f, -80.0f, [](Buffer& out) {
+		dynamics(out, DynamicsProcessor::COMPRESSOR_MODE, DynamicsProcessor::RMS_DETECTOR);
+	}});
+	t.push_back({ "noise_gate", 1e-4f, -80.0f, [](Buffer& out) {
+		dynamics(out, DynamicsProcessor::NOISE_GATE_MODE, DynamicsProcessor::PEAK_DETECTOR);
+	}});
+	t.push_back({ "saturator", 1e-5f, -80.0f, [](Buffer& out) {
+		Saturator s;
+		for (int i = 0; i < samples; ++i) {
+			out.push_back(s.next(3.0f * stimulus(i)));
+		}
+	}});
+	t.push_back({ "adaa_hard_clip", 1e-4f, -80.0f, [](Buffer& out) {
+		waveshaper<HardClipCurve>(out);
+	}});
+	t.push_back({ "adaa_tanh", 1e-4f, -80.0f, [](Buffer& out) {
+		waveshaper<TanhCurve>(out);
+	}});
+	t.push_back({ "adaa_fold", 1e-4f, -80.0f, [](Buffer& out) {
+		waveshaper<FoldCurve>(out);
+	}});
+	t.push_back({ "adaa_saturator", 1e-4f, -80.0f, [](Buffer& out) {
+		waveshaper<SaturatorCurve>(out);
+	}});
+	t.push_back({ "limiter", 1e-5f, -80.0f, [](Buffer& out) {
+		Limiter l;
+		l.setParams(1.5f, 3.0f, 8.0f);
+		for (int i = 0; i < samples; ++i) {
+			out.push_back(l.next(3.0f * stimulus(i)));
+		}
+	}});
+	t.push_back({ "sweep_deconvolver", 1e-4f, -80.0f, [](Buffer& out) {
+		const float f1 = 100.0f, f2 = 20000.0f;
+		SweepDeconvolver d;
+		d.setParams(sampleRate, f1, f2, samples, 5.0f);
+		PureChirpOscillator chirp;
+		chirp.setSampleRate(sampleRate);
+		chirp.setParams(f1, f2, samples / (double)sampleRate, false);
+		LowPassFilter lpf(sampleRate, 2000.0f, 0.707f);
+		Saturator s;
+		Buffer response;
+		for (int i = 0; i < d.responseSamples(); ++i) {
+			float x = i < samples ? 5.0f * chirp.next() : 0.0f;
+			response.push_back(s.next(2.0f * lpf.next(x)));
+		}
+		d.analyze(response.data());
+		out.insert(out.end(), d._magnitudes, d._magnitudes + samples / 2);
+		out.insert(out.end(), d.harmonic(3), d.harmonic(3) + samples / 2);
+	}});
+	t.push_back({ "amplifier", 1e-5f, -80.0f, [](Buffer& out) {
+		Amplifier a;
+		for (int i = 0; i < samples; ++i) {
+			a.setLevel(Amplifier::minDecibels + (Amplifier::maxDecibels - Amplifier::minDecibels) * i / (float)samples);
+			out.push_back(a.next(stimulus(i)));
+		}
+	}});
+
+	return t;
+}
+
+
+static bool load(const std::string& path, Buffer& b) {
+	FILE* f = fopen(path.c_str(), "rb");
+	if (!f) {
+		return false;
+	}
+	float s;
+	while (fread(&s, sizeof(s), 1, f) == 1) {
+		b.push_back(s);
+	}
+	fclose(f);
+	return true;
+}
+
+static bool save(const std::string& path, const Buffer& b) {
+	FILE* f = fopen(path.c_str(), "wb");
+	if (!f) {
+		return false;
+	}
+	bool ok = fwrite(b.data(), sizeof(float), b.size(), f) == b.size();
+	return fclose(f) == 0 && ok;
+}
+
+static float maxAbsError(const Buffer& a, const Buffer& b) {
+	float e = 0.0f;
+	for (size_t i = 0; i < a.size(); ++i) {
+		e = std::max(e, fabsf(a[i] - b[i]));
+	}
+	return e;
+}
+
+static float spectralErrorDb(const Buffer& a, const Buffer& b) {
+	static FFT1024 fft;
+	static HanningWindow window(spectrumSize);
+	float worst = -200.0f;
+	float in[spectrumSize], fa[spectrumSize], fb[spectrumSize];
+	for (size_t o = 0; o + spectrumSize <= a.size(); o += spectrumSize / 2) {
+		window.apply((float*)a.data() + o, in);
+		fft.do_fft(fa, in);
+		window.apply((float*)b.data() + o, in);
+		fft.do_fft(fb, in);
+		double diff = 0.0, ref = 0.0;
+		for (int k = 1; k < spectrumSize / 2; ++k) {
+			float ma = sqrtf(fa[k] * fa[k] + fa[k + spectrumSize / 2] * fa[k + spectrumSize / 2]);
+			float mb = sqrtf(fb[k] * fb[k] + fb[k + spectrumSize / 2] * fb[k + spectrumSize / 2]);
+			diff += (ma - mb) * (ma - mb);
+			ref += mb * mb;
+		}
+		if (diff > 0.0) {
+			worst = std::max(worst, (float)(10.0 * log10(diff / std::max(ref, 1e-20))));
+		}
+	}
+	return worst;
+}
+
+int main(int argc, char** argv) {
+	std::string dir = "test/golden";
+	bool update = false;
+	std::vector<std::string> names;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+			dir = argv[++i];
+		}
+		else if (strcmp(argv[i], "-u") == 0) {
+			update = true;
+		}
+		else {
+			names.push_back(argv[i]);
+		}
+	}
+
+	int run = 0, failed = 0, missing = 0;
+	for (Test& t : tests()) {
+		if (!names.empty() && std::find(names.begin(), names.end(), t.name) == names.end()) {
+			continue;
+		}
+		++run;
+		Buffer out;
+		t.render(out);
+		std::string path = dir + "/" + t.name;
+#ifdef RACK_SIMD
+		if (t.perBuild) {
+			path += ".simd";
+		}
+#endif
+		path += ".f32";
+
+		if (update) {
+			if (!save(path, out)) {
+				printf("ERROR %s: can't write %s\n", t.name.c_str(), path.c_str());
+				++failed;
+				continue;
+			}
+			printf("wrote %s (%d samples)\n", path.c_str(), (int)out.size());
+			continue;
+		}
+
+		Buffer ref;
+		if (!load(path, ref)) {
+			printf("MISSING %s: no reference %s (run with -u)\n", t.name.c_str(), path.c_str());
+			++missing;
+			continue;
+		}
+		if (ref.size() != out.size()) {
+			printf("FAIL %s: %d samples, reference has %d\n", t.name.c_str(), (int)out.size(), (int)ref.size());
+			++failed;
+			continue;
+		}
+		float absError = maxAbsError(out, ref);
+		float specError = spectralErrorDb(out, ref);
+		bool ok = absError <= t.maxAbsError && specError <= t.maxSpectralErrorDb;
+		printf(
+			"%s %s: max abs error %g (limit %g), spectral error %.1fdB (limit %.1fdB)\n",
+			ok ? "ok" : "FAIL",
+			t.name.c_str(),
+			absError,
+			t.maxAbsError,
+			specError,
+			t.maxSpectralErrorDb
+		);
+		failed += !ok;
+	}
+
+	if (!update) {
+		printf("%d tests, %d failed, %d missing references\n", run, failed, missing);
+	}
+	return failed > 0 || missing > 0;
 }